@@ -24,6 +24,7 @@
 #include <spng.h>
 #include <string.h>
 #include "../../QRMatrix/qrmatrixencoder.h"
+#include "../../QRMatrix/Render/raster.h"
 #include "../../String/utf8string.h"
 
 #if __linux__
@@ -33,21 +34,26 @@
 #endif
 
 /// https://github.com/randy408/libspng/blob/v0.7.3/examples/example.c
-void createPNG(UnsignedByte* image, unsigned int dimension, const char* path) {
+void createPNG(QrmRaster* raster, const char* path) {
     spng_ctx *context = spng_ctx_new(SPNG_CTX_ENCODER);
     spng_set_option(context, SPNG_ENCODE_TO_BUFFER, 1);
 
     struct spng_ihdr ihdr = { 0 };
-    ihdr.width = dimension;
-    ihdr.height = dimension;
+    ihdr.width = raster->width;
+    ihdr.height = raster->width;
     ihdr.color_type = SPNG_COLOR_TYPE_GRAYSCALE;
-    ihdr.bit_depth = 8; // 1 byte per pixel: refer to `image`
+    ihdr.bit_depth = 8; // 1 byte per pixel: refer to `PixelGray8`
     spng_set_ihdr(context, &ihdr);
 
-    unsigned int length = dimension * dimension;
+    // Encode row by row
     int fmt = SPNG_FMT_PNG;
-    int result = spng_encode_image(context, image, length, fmt, SPNG_ENCODE_FINALIZE);
-    if (result != 0) {
+    int result = spng_encode_image(context, NULL, 0, fmt, SPNG_ENCODE_PROGRESSIVE | SPNG_ENCODE_FINALIZE);
+    const UnsignedByte* row = QrmRasterNextRow(raster);
+    while (result == 0 && row != NULL) {
+        result = spng_encode_row(context, row, raster->rowLength);
+        row = QrmRasterNextRow(raster);
+    }
+    if (result != SPNG_EOI) {
         printf("Encode PNG ERROR 1: %s\n%s\n", path, spng_strerror(result));
         spng_ctx_free(context);
         return;
@@ -73,48 +79,18 @@ void createPNG(UnsignedByte* image, unsigned int dimension, const char* path) {
     spng_ctx_free(context);
 }
 
-void fillCell(
-    UnsignedByte* image,
-    unsigned int dimension,
-    unsigned int row,
-    unsigned int column,
-    UnsignedByte scale,
-    UnsignedByte quiteZone
-) {
-    unsigned int rowOffset = (row + quiteZone) * scale * dimension;
-    unsigned int colOffset = (column + quiteZone) * scale;
-    for (unsigned int index = 0; index < scale; index += 1) {
-        unsigned int pic = rowOffset + index * dimension + colOffset;
-        for (unsigned jndex = 0; jndex < scale; jndex += 1) {
-            image[pic] = 0;
-            pic += 1;
-        }
-    }
-}
-
 void makeQR(QrmBoard board, const char* path, bool isMicro) {
     UnsignedByte quietZone = isMicro ? 2 : 4;
     static UnsignedByte scale = 10;
-    unsigned int dimension = (board.dimension + 2 * quietZone) * scale;
-    unsigned int length = dimension * dimension;
-    ALLOC(UnsignedByte, image, length); // each byte is a image pixel
-    // Fill white
-    for (unsigned int index = 0; index < length; index += 1) {
-        image[index] = 0xFF;
-    }
-    // Draw QR board (black cells)
-    for (unsigned int row = 0; row < board.dimension; row += 1) {
-        for (unsigned int column = 0; column < board.dimension; column += 1) {
-            UnsignedByte cell = board.buffer[row][column];
-            UnsignedByte low = cell & CellLowMask;
-            if (low == CellSet) {
-                fillCell(image, dimension, row, column, scale, quietZone);
-            }
-        }
+    // Image is generated row by row (white background, black cells)
+    QrmRaster raster = QrmRasterCreate(board, scale, quietZone, PixelGray8, false);
+    if (raster.width == 0) {
+        printf("FAILED: %s\n", path);
+        return;
     }
     // Write PNG file
-    createPNG(image, dimension, path);
-    DEALLOC(image);
+    createPNG(&raster, path);
+    QrmRasterDestroy(&raster);
 }
 
 void encodeQR(const char* path, const UnsignedByte* raw, QrmEncodingMode mode, unsigned int eci, bool isMicro) {
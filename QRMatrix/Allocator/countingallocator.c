@@ -0,0 +1,152 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "countingallocator.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+/// Size of allocation is stored before returned memory (keep maximum alignment)
+#define COUNTING_HEADER_SIZE 16
+
+struct QrmCountingAllocatorState {
+    QrmAllocator parent;
+    _Atomic unsigned long long allocationCount;
+    _Atomic unsigned long long releaseCount;
+    _Atomic size_t currentBytes;
+    _Atomic size_t peakBytes;
+    _Atomic unsigned long long totalBytes;
+};
+
+void QrmCountingAllocator_addBytes(QrmCountingAllocatorState* state, size_t added, size_t removed) {
+    if (added < removed) {
+        atomic_fetch_sub(&state->currentBytes, removed - added);
+    }
+    size_t current = added > removed ? atomic_fetch_add(&state->currentBytes, added - removed) + added - removed : 0;
+    size_t peak = atomic_load(&state->peakBytes);
+    while (current > peak && !atomic_compare_exchange_weak(&state->peakBytes, &peak, current)) {
+    }
+    atomic_fetch_add(&state->allocationCount, 1);
+    atomic_fetch_add(&state->totalBytes, added);
+}
+
+void* QrmCountingAllocator_allocate(void* context, size_t count, size_t size) {
+    QrmCountingAllocatorState* state = context;
+    if (size > 0 && count > (SIZE_MAX - COUNTING_HEADER_SIZE) / size) {
+        return NULL;
+    }
+    size_t length = count * size;
+    UnsignedByte* base = state->parent.allocate(state->parent.context, 1, length + COUNTING_HEADER_SIZE);
+    if (base == NULL) {
+        return NULL;
+    }
+    *(size_t*)base = length;
+    QrmCountingAllocator_addBytes(state, length, 0);
+    return base + COUNTING_HEADER_SIZE;
+}
+
+void* QrmCountingAllocator_reallocate(void* context, void* pointer, size_t size) {
+    QrmCountingAllocatorState* state = context;
+    if (pointer == NULL) {
+        return QrmCountingAllocator_allocate(context, 1, size);
+    }
+    if (size > SIZE_MAX - COUNTING_HEADER_SIZE) {
+        return NULL;
+    }
+    UnsignedByte* base = (UnsignedByte*)pointer - COUNTING_HEADER_SIZE;
+    size_t oldSize = *(size_t*)base;
+    base = state->parent.reallocate(state->parent.context, base, size + COUNTING_HEADER_SIZE);
+    if (base == NULL) {
+        return NULL;
+    }
+    *(size_t*)base = size;
+    QrmCountingAllocator_addBytes(state, size, oldSize);
+    return base + COUNTING_HEADER_SIZE;
+}
+
+void QrmCountingAllocator_release(void* context, void* pointer) {
+    QrmCountingAllocatorState* state = context;
+    if (pointer == NULL) {
+        return;
+    }
+    UnsignedByte* base = (UnsignedByte*)pointer - COUNTING_HEADER_SIZE;
+    atomic_fetch_sub(&state->currentBytes, *(size_t*)base);
+    atomic_fetch_add(&state->releaseCount, 1);
+    state->parent.release(state->parent.context, base);
+}
+
+QrmCountingAllocator QrmCountingAllocatorCreate(QrmAllocator parent) {
+    QrmCountingAllocator result;
+    result.allocator.context = NULL;
+    result.allocator.allocate = QrmCountingAllocator_allocate;
+    result.allocator.reallocate = QrmCountingAllocator_reallocate;
+    result.allocator.release = QrmCountingAllocator_release;
+    result.state = NULL;
+    if (parent.allocate == NULL || parent.reallocate == NULL || parent.release == NULL) {
+        LOG("ERROR: Invalid parent allocator");
+        return result;
+    }
+    result.state = parent.allocate(parent.context, 1, sizeof(QrmCountingAllocatorState));
+    if (result.state == NULL) {
+        return result;
+    }
+    // Parent may return uninitialised memory
+    result.state->parent = parent;
+    atomic_init(&result.state->allocationCount, 0);
+    atomic_init(&result.state->releaseCount, 0);
+    atomic_init(&result.state->currentBytes, 0);
+    atomic_init(&result.state->peakBytes, 0);
+    atomic_init(&result.state->totalBytes, 0);
+    result.allocator.context = result.state;
+    return result;
+}
+
+void QrmCountingAllocatorDestroy(QrmCountingAllocator* allocator) {
+    if (allocator->state != NULL) {
+        QrmAllocator parent = allocator->state->parent;
+        parent.release(parent.context, allocator->state);
+        allocator->state = NULL;
+        allocator->allocator.context = NULL;
+    }
+}
+
+QrmAllocationCounters QrmCountingAllocatorGetCounters(QrmCountingAllocator allocator) {
+    QrmAllocationCounters result = { 0, 0, 0, 0, 0 };
+    QrmCountingAllocatorState* state = allocator.state;
+    if (state != NULL) {
+        result.allocationCount = atomic_load(&state->allocationCount);
+        result.releaseCount = atomic_load(&state->releaseCount);
+        result.currentBytes = atomic_load(&state->currentBytes);
+        result.peakBytes = atomic_load(&state->peakBytes);
+        result.totalBytes = atomic_load(&state->totalBytes);
+    }
+    return result;
+}
+
+void QrmCountingAllocatorReset(QrmCountingAllocator allocator) {
+    QrmCountingAllocatorState* state = allocator.state;
+    if (state != NULL) {
+        atomic_store(&state->allocationCount, 0);
+        atomic_store(&state->releaseCount, 0);
+        atomic_store(&state->totalBytes, 0);
+        atomic_store(&state->peakBytes, atomic_load(&state->currentBytes));
+    }
+}
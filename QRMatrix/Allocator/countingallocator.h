@@ -0,0 +1,62 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef COUNTINGALLOCATOR_H
+#define COUNTINGALLOCATOR_H
+
+#include "../constants.h"
+
+/// Counters of `QrmCountingAllocator`
+typedef struct {
+    /// Number of successful `allocate` & `reallocate` calls
+    unsigned long long allocationCount;
+    /// Number of `release` calls (with non NULL pointer)
+    unsigned long long releaseCount;
+    /// Bytes in use
+    size_t currentBytes;
+    /// Maximum of `currentBytes`
+    size_t peakBytes;
+    /// Total requested bytes
+    unsigned long long totalBytes;
+} QrmAllocationCounters;
+
+typedef struct QrmCountingAllocatorState QrmCountingAllocatorState;
+
+/// Allocator which counts allocations & tracks peak memory usage (thread safe),
+/// eg. to check number of allocations of encoding or memory usage of a request.
+typedef struct {
+    /// Pass this to `QrmSetAllocator` or `QrmSetThreadAllocator`
+    QrmAllocator allocator;
+    QrmCountingAllocatorState* state;
+} QrmCountingAllocator;
+
+/// Constructor. Memory is allocated by `parent` (eg. `QrmAllocatorCreateDefault()`).
+/// @return Counting allocator (`state` = NULL if failed).
+QrmCountingAllocator QrmCountingAllocatorCreate(QrmAllocator parent);
+/// Destructor. Do not destroy while it is in use (all memory allocated by it should be released).
+void QrmCountingAllocatorDestroy(QrmCountingAllocator* allocator);
+/// Get counters
+QrmAllocationCounters QrmCountingAllocatorGetCounters(QrmCountingAllocator allocator);
+/// Set counts & total to zero, peak to current bytes
+void QrmCountingAllocatorReset(QrmCountingAllocator allocator);
+
+#endif // COUNTINGALLOCATOR_H
@@ -0,0 +1,533 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "boardarchive.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define ARCHIVE_MAGIC "QRMARC01"
+#define ARCHIVE_MAGIC_LENGTH 8
+#define ARCHIVE_HEADER_LENGTH 32
+#define ARCHIVE_RECORD_HEADER_LENGTH 8
+#define ARCHIVE_LOOKUP_ITEM_LENGTH 16
+#define ARCHIVE_MAX_KEY_LENGTH 0xFFFF
+
+struct QrmArchiveWriterState {
+    FILE* file;
+    /// End of last record
+    unsigned long long position;
+    unsigned int count;
+    unsigned int capacity;
+    unsigned long long* offsets;
+    unsigned long long* hashes;
+};
+
+/// Lookup item before sorting
+typedef struct {
+    unsigned long long hash;
+    unsigned int ordinal;
+} QrmArchive_LookupItem;
+
+// HELPERS ==================================================================================================
+
+void QrmArchive_write4(UnsignedByte* buffer, Unsigned4Bytes value) {
+    for (UnsignedByte index = 0; index < 4; index += 1) {
+        buffer[index] = (UnsignedByte)(value >> (index * 8));
+    }
+}
+
+void QrmArchive_write8(UnsignedByte* buffer, unsigned long long value) {
+    for (UnsignedByte index = 0; index < 8; index += 1) {
+        buffer[index] = (UnsignedByte)(value >> (index * 8));
+    }
+}
+
+Unsigned4Bytes QrmArchive_read4(const UnsignedByte* buffer) {
+    Unsigned4Bytes result = 0;
+    for (UnsignedByte index = 0; index < 4; index += 1) {
+        result |= (Unsigned4Bytes)buffer[index] << (index * 8);
+    }
+    return result;
+}
+
+unsigned long long QrmArchive_read8(const UnsignedByte* buffer) {
+    unsigned long long result = 0;
+    for (UnsignedByte index = 0; index < 8; index += 1) {
+        result |= (unsigned long long)buffer[index] << (index * 8);
+    }
+    return result;
+}
+
+/// FNV-1a (same result on every platform)
+unsigned long long QrmArchive_hash(const UnsignedByte* key, unsigned int keyLength) {
+    unsigned long long result = 0xCBF29CE484222325ULL;
+    for (unsigned int index = 0; index < keyLength; index += 1) {
+        result = (result ^ key[index]) * 0x100000001B3ULL;
+    }
+    return result;
+}
+
+unsigned long long QrmArchive_align(unsigned long long value) {
+    return (value + 7) & ~7ULL;
+}
+
+unsigned int QrmArchive_rowStride(UnsignedByte dimension) {
+    return (dimension + 7) / 8;
+}
+
+/// Length of record of given key & dimension
+unsigned long long QrmArchive_recordLength(unsigned int keyLength, UnsignedByte dimension) {
+    unsigned long long result = QrmArchive_align(ARCHIVE_RECORD_HEADER_LENGTH + keyLength);
+    result += QrmArchive_align((unsigned long long)QrmArchive_rowStride(dimension) * dimension);
+    return result;
+}
+
+bool QrmArchive_isSet(QrmBoard board, UnsignedByte row, UnsignedByte column) {
+    return (board.buffer[row][column] & CellLowMask) == CellSet;
+}
+
+/// Read version, level & mask from format information of board.
+bool QrmArchive_readFormat(QrmBoard board, QrmBoardView* info) {
+    UnsignedByte dimension = board.dimension;
+    Unsigned2Bytes value = 0;
+    if (dimension >= QR_MIN_DIMENSION && (dimension - QR_MIN_DIMENSION) % QR_VERSION_OFFSET == 0) {
+        for (UnsignedByte index = 0; index < 15; index += 1) {
+            UnsignedByte row = 8;
+            UnsignedByte column = 8;
+            if (index < 6) {
+                column = index;
+            } else if (index == 6) {
+                column = 7;
+            } else if (index > 8) {
+                row = 14 - index;
+            } else if (index == 8) {
+                row = 7;
+            }
+            value = (value << 1) | (QrmArchive_isSet(board, row, column) ? 1 : 0);
+        }
+        value ^= 0x5412;
+        info->isMicro = false;
+        info->version = (dimension - QR_MIN_DIMENSION) / QR_VERSION_OFFSET + 1;
+        info->level = (QrmErrorCorrectionLevel)(value >> 13);
+        info->maskId = (value >> 10) & 0x07;
+        return true;
+    }
+    if (dimension >= MICROQR_MIN_DIMENSION && dimension < QR_MIN_DIMENSION && (dimension - MICROQR_MIN_DIMENSION) % MICROQR_VERSION_OFFSET == 0) {
+        static const QrmErrorCorrectionLevel levels[] = {
+            ELevelLow, ELevelLow, ELevelMedium, ELevelLow, ELevelMedium, ELevelLow, ELevelMedium, ELevelQuarter
+        };
+        for (UnsignedByte index = 0; index < 15; index += 1) {
+            bool isSet = index < 8 ? QrmArchive_isSet(board, 8, index + 1) : QrmArchive_isSet(board, 15 - index, 8);
+            value = (value << 1) | (isSet ? 1 : 0);
+        }
+        value ^= 0x4445;
+        info->isMicro = true;
+        info->version = (dimension - MICROQR_MIN_DIMENSION) / MICROQR_VERSION_OFFSET + 1;
+        info->level = levels[value >> 12];
+        info->maskId = (value >> 10) & 0x03;
+        return true;
+    }
+    return false;
+}
+
+/// Parse record at given offset of mapped file
+QrmBoardView QrmArchive_parseRecord(const UnsignedByte* base, size_t length, unsigned long long offset) {
+    QrmBoardView result = QrmBoardViewCreateEmpty();
+    if (offset < ARCHIVE_HEADER_LENGTH || offset + ARCHIVE_RECORD_HEADER_LENGTH > length) {
+        return result;
+    }
+    const UnsignedByte* record = base + offset;
+    unsigned int keyLength = record[6] | (record[7] << 8);
+    if (offset + QrmArchive_recordLength(keyLength, record[0]) > length) {
+        return result;
+    }
+    result.dimension = record[0];
+    result.version = record[1];
+    result.level = (QrmErrorCorrectionLevel)record[2];
+    result.maskId = record[3];
+    result.isMicro = record[4] != 0;
+    result.rowStride = QrmArchive_rowStride(result.dimension);
+    result.key = record + ARCHIVE_RECORD_HEADER_LENGTH;
+    result.keyLength = keyLength;
+    result.modules = record + QrmArchive_align(ARCHIVE_RECORD_HEADER_LENGTH + keyLength);
+    return result;
+}
+
+// VIEW =====================================================================================================
+
+QrmBoardView QrmBoardViewCreateEmpty(void) {
+    QrmBoardView result;
+    memset(&result, 0, sizeof(result));
+    return result;
+}
+
+bool QrmBoardViewIsSet(QrmBoardView view, UnsignedByte row, UnsignedByte column) {
+    return (view.modules[row * view.rowStride + (column >> 3)] & (0x80 >> (column & 0x07))) != 0;
+}
+
+QrmBoard QrmBoardViewToBoard(QrmBoardView view) {
+    QrmBoard result = QrmBoardCreateEmpty();
+    if (view.dimension == 0 || view.modules == NULL) {
+        return result;
+    }
+    ALLOC_(UnsignedByte*, result.buffer, view.dimension);
+    result.dimension = view.dimension;
+    for (UnsignedByte row = 0; row < view.dimension; row += 1) {
+        ALLOC_(UnsignedByte, result.buffer[row], view.dimension);
+        for (UnsignedByte column = 0; column < view.dimension; column += 1) {
+            result.buffer[row][column] = QrmBoardViewIsSet(view, row, column) ? CellSet : CellUnset;
+        }
+    }
+    return result;
+}
+
+// WRITER ===================================================================================================
+
+bool QrmArchive_writeHeader(FILE* file, unsigned int count, unsigned long long indexOffset) {
+    UnsignedByte header[ARCHIVE_HEADER_LENGTH];
+    memset(header, 0, ARCHIVE_HEADER_LENGTH);
+    memcpy(header, ARCHIVE_MAGIC, ARCHIVE_MAGIC_LENGTH);
+    QrmArchive_write4(header + 8, count);
+    QrmArchive_write8(header + 16, indexOffset);
+    return fseeko(file, 0, SEEK_SET) == 0 && fwrite(header, 1, ARCHIVE_HEADER_LENGTH, file) == ARCHIVE_HEADER_LENGTH;
+}
+
+bool QrmArchive_addRecord(QrmArchiveWriterState* state, unsigned long long offset, unsigned long long hash) {
+    if (state->count == state->capacity) {
+        unsigned int capacity = state->capacity == 0 ? 1024 : state->capacity * 2;
+        unsigned long long* offsets = QrmRealloc(state->offsets, capacity * sizeof(unsigned long long));
+        if (offsets == NULL) {
+            return false;
+        }
+        state->offsets = offsets;
+        unsigned long long* hashes = QrmRealloc(state->hashes, capacity * sizeof(unsigned long long));
+        if (hashes == NULL) {
+            return false;
+        }
+        state->hashes = hashes;
+        state->capacity = capacity;
+    }
+    state->offsets[state->count] = offset;
+    state->hashes[state->count] = hash;
+    state->count += 1;
+    return true;
+}
+
+/// Load records of existing file from its index
+bool QrmArchive_loadIndex(QrmArchiveWriterState* state, unsigned int count, unsigned long long indexOffset) {
+    ALLOC(UnsignedByte, buffer, (size_t)count * (8 + ARCHIVE_LOOKUP_ITEM_LENGTH) + 1);
+    if (buffer == NULL) {
+        return false;
+    }
+    size_t length = (size_t)count * (8 + ARCHIVE_LOOKUP_ITEM_LENGTH);
+    if (fseeko(state->file, indexOffset, SEEK_SET) != 0 || fread(buffer, 1, length, state->file) != length) {
+        DEALLOC(buffer);
+        return false;
+    }
+    for (unsigned int index = 0; index < count; index += 1) {
+        if (!QrmArchive_addRecord(state, QrmArchive_read8(buffer + index * 8), 0)) {
+            DEALLOC(buffer);
+            return false;
+        }
+    }
+    const UnsignedByte* lookup = buffer + (size_t)count * 8;
+    for (unsigned int index = 0; index < count; index += 1) {
+        unsigned int ordinal = QrmArchive_read4(lookup + index * ARCHIVE_LOOKUP_ITEM_LENGTH + 8);
+        if (ordinal >= count) {
+            DEALLOC(buffer);
+            return false;
+        }
+        state->hashes[ordinal] = QrmArchive_read8(lookup + index * ARCHIVE_LOOKUP_ITEM_LENGTH);
+    }
+    DEALLOC(buffer);
+    state->position = indexOffset;
+    return true;
+}
+
+/// Recover records of file which was not closed properly (no index): scan records from the beginning.
+bool QrmArchive_scanRecords(QrmArchiveWriterState* state, unsigned long long fileLength) {
+    unsigned long long offset = ARCHIVE_HEADER_LENGTH;
+    UnsignedByte header[ARCHIVE_RECORD_HEADER_LENGTH];
+    ALLOC(UnsignedByte, key, ARCHIVE_MAX_KEY_LENGTH + 1);
+    if (key == NULL) {
+        return false;
+    }
+    while (offset + ARCHIVE_RECORD_HEADER_LENGTH <= fileLength) {
+        if (fseeko(state->file, offset, SEEK_SET) != 0 || fread(header, 1, ARCHIVE_RECORD_HEADER_LENGTH, state->file) != ARCHIVE_RECORD_HEADER_LENGTH) {
+            break;
+        }
+        unsigned int keyLength = header[6] | (header[7] << 8);
+        unsigned long long recordLength = QrmArchive_recordLength(keyLength, header[0]);
+        if (header[0] == 0 || offset + recordLength > fileLength || fread(key, 1, keyLength, state->file) != keyLength) {
+            break;
+        }
+        if (!QrmArchive_addRecord(state, offset, QrmArchive_hash(key, keyLength))) {
+            DEALLOC(key);
+            return false;
+        }
+        offset += recordLength;
+    }
+    DEALLOC(key);
+    state->position = offset;
+    return true;
+}
+
+void QrmArchive_destroyState(QrmArchiveWriterState* state) {
+    if (state->file != NULL) {
+        fclose(state->file);
+    }
+    DEALLOC(state->offsets);
+    DEALLOC(state->hashes);
+    DEALLOC(state);
+}
+
+QrmArchiveWriter QrmArchiveWriterOpen(const char* path) {
+    QrmArchiveWriter result;
+    ALLOC_(QrmArchiveWriterState, result.state, 1);
+    QrmArchiveWriterState* state = result.state;
+    if (state == NULL) {
+        return result;
+    }
+    state->file = fopen(path, "r+b");
+    bool isValid = false;
+    if (state->file != NULL) {
+        UnsignedByte header[ARCHIVE_HEADER_LENGTH];
+        struct stat info;
+        if (fstat(fileno(state->file), &info) == 0 &&
+            fread(header, 1, ARCHIVE_HEADER_LENGTH, state->file) == ARCHIVE_HEADER_LENGTH &&
+            memcmp(header, ARCHIVE_MAGIC, ARCHIVE_MAGIC_LENGTH) == 0) {
+            unsigned int count = QrmArchive_read4(header + 8);
+            unsigned long long indexOffset = QrmArchive_read8(header + 16);
+            if (indexOffset > 0) {
+                isValid = QrmArchive_loadIndex(state, count, indexOffset);
+            } else {
+                isValid = QrmArchive_scanRecords(state, (unsigned long long)info.st_size);
+            }
+        } else if (fstat(fileno(state->file), &info) == 0 && info.st_size == 0) {
+            isValid = true;
+            state->position = ARCHIVE_HEADER_LENGTH;
+        } else {
+            LOG("ERROR: Invalid archive file");
+        }
+    } else {
+        state->file = fopen(path, "w+b");
+        isValid = state->file != NULL;
+        state->position = ARCHIVE_HEADER_LENGTH;
+    }
+    // Drop old index (it is rewritten when closing); records are recoverable by scanning if writer is not closed.
+    if (!isValid ||
+        !QrmArchive_writeHeader(state->file, state->count, 0) ||
+        fflush(state->file) != 0 ||
+        ftruncate(fileno(state->file), (off_t)state->position) != 0 ||
+        fseeko(state->file, (off_t)state->position, SEEK_SET) != 0) {
+        LOG("ERROR: Failed to open archive");
+        QrmArchive_destroyState(state);
+        result.state = NULL;
+    }
+    return result;
+}
+
+bool QrmArchiveWriterAppend(QrmArchiveWriter writer, const UnsignedByte* key, unsigned int keyLength, QrmBoard board) {
+    QrmArchiveWriterState* state = writer.state;
+    if (state == NULL || board.dimension == 0 || keyLength > ARCHIVE_MAX_KEY_LENGTH) {
+        return false;
+    }
+    QrmBoardView info = QrmBoardViewCreateEmpty();
+    if (!QrmArchive_readFormat(board, &info)) {
+        LOG("ERROR: Invalid board dimension");
+        return false;
+    }
+    unsigned int rowStride = QrmArchive_rowStride(board.dimension);
+    unsigned long long keyEnd = QrmArchive_align(ARCHIVE_RECORD_HEADER_LENGTH + keyLength);
+    unsigned long long recordLength = QrmArchive_recordLength(keyLength, board.dimension);
+    ALLOC(UnsignedByte, record, recordLength);
+    if (record == NULL) {
+        return false;
+    }
+    record[0] = board.dimension;
+    record[1] = info.version;
+    record[2] = (UnsignedByte)info.level;
+    record[3] = info.maskId;
+    record[4] = info.isMicro ? 1 : 0;
+    record[6] = (UnsignedByte)keyLength;
+    record[7] = (UnsignedByte)(keyLength >> 8);
+    if (keyLength > 0) {
+        memcpy(record + ARCHIVE_RECORD_HEADER_LENGTH, key, keyLength);
+    }
+    UnsignedByte* modules = record + keyEnd;
+    for (UnsignedByte row = 0; row < board.dimension; row += 1) {
+        UnsignedByte* line = modules + row * rowStride;
+        for (UnsignedByte column = 0; column < board.dimension; column += 1) {
+            if (QrmArchive_isSet(board, row, column)) {
+                line[column >> 3] |= 0x80 >> (column & 0x07);
+            }
+        }
+    }
+    bool isSuccess = fwrite(record, 1, recordLength, state->file) == recordLength &&
+        QrmArchive_addRecord(state, state->position, QrmArchive_hash(key, keyLength));
+    DEALLOC(record);
+    if (isSuccess) {
+        state->position += recordLength;
+    } else {
+        // Rewind to end of last good record
+        fseeko(state->file, (off_t)state->position, SEEK_SET);
+    }
+    return isSuccess;
+}
+
+int QrmArchive_compareLookupItems(const void* left, const void* right) {
+    const QrmArchive_LookupItem* leftItem = left;
+    const QrmArchive_LookupItem* rightItem = right;
+    if (leftItem->hash != rightItem->hash) {
+        return leftItem->hash < rightItem->hash ? -1 : 1;
+    }
+    if (leftItem->ordinal != rightItem->ordinal) {
+        return leftItem->ordinal < rightItem->ordinal ? -1 : 1;
+    }
+    return 0;
+}
+
+bool QrmArchiveWriterClose(QrmArchiveWriter* writer) {
+    QrmArchiveWriterState* state = writer->state;
+    if (state == NULL) {
+        return false;
+    }
+    writer->state = NULL;
+    size_t length = (size_t)state->count * (8 + ARCHIVE_LOOKUP_ITEM_LENGTH);
+    ALLOC(UnsignedByte, buffer, length + 1);
+    ALLOC(QrmArchive_LookupItem, items, state->count + 1);
+    bool isSuccess = buffer != NULL && items != NULL;
+    if (isSuccess) {
+        for (unsigned int index = 0; index < state->count; index += 1) {
+            QrmArchive_write8(buffer + index * 8, state->offsets[index]);
+            items[index].hash = state->hashes[index];
+            items[index].ordinal = index;
+        }
+        qsort(items, state->count, sizeof(QrmArchive_LookupItem), QrmArchive_compareLookupItems);
+        UnsignedByte* lookup = buffer + (size_t)state->count * 8;
+        for (unsigned int index = 0; index < state->count; index += 1) {
+            QrmArchive_write8(lookup + index * ARCHIVE_LOOKUP_ITEM_LENGTH, items[index].hash);
+            QrmArchive_write4(lookup + index * ARCHIVE_LOOKUP_ITEM_LENGTH + 8, items[index].ordinal);
+        }
+        isSuccess = fseeko(state->file, (off_t)state->position, SEEK_SET) == 0 &&
+            fwrite(buffer, 1, length, state->file) == length &&
+            fflush(state->file) == 0 &&
+            QrmArchive_writeHeader(state->file, state->count, state->position) &&
+            fflush(state->file) == 0;
+    }
+    DEALLOC(buffer);
+    DEALLOC(items);
+    QrmArchive_destroyState(state);
+    return isSuccess;
+}
+
+// READER ===================================================================================================
+
+QrmArchiveReader QrmArchiveReader_createEmpty(void) {
+    QrmArchiveReader result;
+    memset(&result, 0, sizeof(result));
+    return result;
+}
+
+QrmArchiveReader QrmArchiveReaderOpen(const char* path) {
+    QrmArchiveReader result = QrmArchiveReader_createEmpty();
+    int fileDescriptor = open(path, O_RDONLY);
+    if (fileDescriptor < 0) {
+        return result;
+    }
+    struct stat info;
+    if (fstat(fileDescriptor, &info) != 0 || info.st_size < ARCHIVE_HEADER_LENGTH) {
+        close(fileDescriptor);
+        return result;
+    }
+    size_t length = (size_t)info.st_size;
+    void* base = mmap(NULL, length, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (base == MAP_FAILED) {
+        return result;
+    }
+    const UnsignedByte* header = base;
+    unsigned int count = QrmArchive_read4(header + 8);
+    unsigned long long indexOffset = QrmArchive_read8(header + 16);
+    if (memcmp(header, ARCHIVE_MAGIC, ARCHIVE_MAGIC_LENGTH) != 0 ||
+        indexOffset < ARCHIVE_HEADER_LENGTH ||
+        indexOffset > length ||
+        (unsigned long long)count * (8 + ARCHIVE_LOOKUP_ITEM_LENGTH) > length - indexOffset) {
+        LOG("ERROR: Invalid archive file (or writer was not closed)");
+        munmap(base, length);
+        return result;
+    }
+    result.base = header;
+    result.length = length;
+    result.count = count;
+    result.offsets = header + indexOffset;
+    result.lookup = result.offsets + (size_t)count * 8;
+    return result;
+}
+
+void QrmArchiveReaderClose(QrmArchiveReader* reader) {
+    if (reader->base != NULL) {
+        munmap((void*)reader->base, reader->length);
+    }
+    *reader = QrmArchiveReader_createEmpty();
+}
+
+QrmBoardView QrmArchiveReaderGet(QrmArchiveReader reader, unsigned int index) {
+    if (reader.base == NULL || index >= reader.count) {
+        return QrmBoardViewCreateEmpty();
+    }
+    return QrmArchive_parseRecord(reader.base, reader.length, QrmArchive_read8(reader.offsets + (size_t)index * 8));
+}
+
+QrmBoardView QrmArchiveReaderFind(QrmArchiveReader reader, const UnsignedByte* key, unsigned int keyLength) {
+    if (reader.base == NULL) {
+        return QrmBoardViewCreateEmpty();
+    }
+    unsigned long long hash = QrmArchive_hash(key, keyLength);
+    // Lower bound of hash
+    unsigned int low = 0;
+    unsigned int high = reader.count;
+    while (low < high) {
+        unsigned int middle = low + (high - low) / 2;
+        if (QrmArchive_read8(reader.lookup + (size_t)middle * ARCHIVE_LOOKUP_ITEM_LENGTH) < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    for (unsigned int index = low; index < reader.count; index += 1) {
+        const UnsignedByte* item = reader.lookup + (size_t)index * ARCHIVE_LOOKUP_ITEM_LENGTH;
+        if (QrmArchive_read8(item) != hash) {
+            break;
+        }
+        QrmBoardView view = QrmArchiveReaderGet(reader, QrmArchive_read4(item + 8));
+        if (view.dimension > 0 && view.keyLength == keyLength && (keyLength == 0 || memcmp(view.key, key, keyLength) == 0)) {
+            return view;
+        }
+    }
+    return QrmBoardViewCreateEmpty();
+}
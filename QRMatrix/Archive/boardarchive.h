@@ -0,0 +1,110 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOARDARCHIVE_H
+#define BOARDARCHIVE_H
+
+#include <stddef.h>
+#include "../qrmatrixboard.h"
+
+/*
+ Archive file layout (numbers are little endian):
+ - Header (32 bytes): magic "QRMARC01", number of boards (4 bytes), reserved (4 bytes),
+   offset of index (8 bytes, 0 if writer was not closed), reserved (8 bytes).
+ - Records (8 bytes aligned), one per board: dimension, version, level, mask, isMicro (1 byte each),
+   reserved (1 byte), key length (2 bytes), key bytes, padding, module plane, padding.
+   Module plane: `dimension` rows of `(dimension + 7) / 8` bytes, most significant bit first, 1 = dark module.
+ - Index: offsets of records (8 bytes each) in appending order,
+   then (hash of key (8 bytes), record number (4 bytes), reserved (4 bytes)) sorted by hash.
+ */
+
+/// Read only view of a board stored in archive (or any 1 bit per module plane).
+typedef struct {
+    /// 0 = empty view
+    UnsignedByte dimension;
+    UnsignedByte version;
+    QrmErrorCorrectionLevel level;
+    UnsignedByte maskId;
+    bool isMicro;
+    /// Number of bytes per row of `modules`
+    unsigned int rowStride;
+    /// Modules, row by row, most significant bit first (1 = dark).
+    const UnsignedByte* modules;
+    const UnsignedByte* key;
+    unsigned int keyLength;
+} QrmBoardView;
+
+/// Place holder
+QrmBoardView QrmBoardViewCreateEmpty(void);
+/// Is module at given position dark.
+bool QrmBoardViewIsSet(QrmBoardView view, UnsignedByte row, UnsignedByte column);
+/// Make QR board from view (cells are `CellSet` or `CellUnset` only, without cell types).
+/// @return Board (should be deleted when done).
+QrmBoard QrmBoardViewToBoard(QrmBoardView view);
+
+typedef struct QrmArchiveWriterState QrmArchiveWriterState;
+
+/// Appends boards to archive file.
+typedef struct {
+    QrmArchiveWriterState* state;
+} QrmArchiveWriter;
+
+/// Open archive file to append boards (file is created if it does not exist).
+/// @return Writer (`state` = NULL if failed).
+QrmArchiveWriter QrmArchiveWriterOpen(const char* path);
+/// Append a board. Version, level & mask are read from board format information.
+/// @return false if failed.
+bool QrmArchiveWriterAppend(
+    QrmArchiveWriter writer,
+    /// Key to find board later (eg. encoded text or label id). Up to 65535 bytes.
+    const UnsignedByte* key,
+    unsigned int keyLength,
+    /// Board made by QR encoder
+    QrmBoard board
+);
+/// Write index and close file. Boards appended after last close are lost if this is not called.
+/// @return false if failed.
+bool QrmArchiveWriterClose(QrmArchiveWriter* writer);
+
+/// Memory mapped archive file.
+typedef struct {
+    const UnsignedByte* base;
+    size_t length;
+    /// Number of boards
+    unsigned int count;
+    const UnsignedByte* offsets;
+    const UnsignedByte* lookup;
+} QrmArchiveReader;
+
+/// Map archive file into memory (file is not read).
+/// @return Reader (`base` = NULL if failed).
+QrmArchiveReader QrmArchiveReaderOpen(const char* path);
+/// Unmap archive file. Views from this reader become invalid.
+void QrmArchiveReaderClose(QrmArchiveReader* reader);
+/// Get board by appending order.
+/// @return View pointing into mapped file (`dimension` = 0 if failed).
+QrmBoardView QrmArchiveReaderGet(QrmArchiveReader reader, unsigned int index);
+/// Find board by key (first appended one if key is duplicated).
+/// @return View pointing into mapped file (`dimension` = 0 if not found).
+QrmBoardView QrmArchiveReaderFind(QrmArchiveReader reader, const UnsignedByte* key, unsigned int keyLength);
+
+#endif // BOARDARCHIVE_H
@@ -0,0 +1,408 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "boardcache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define BOARDCACHE_MIN_BUCKETS 64
+
+struct QrmBoardCacheEntry {
+    /// Cache holds 1 reference while the entry is in the table
+    atomic_uint references;
+    unsigned long long hash;
+    /// Serialized encoding input
+    UnsignedByte* key;
+    unsigned int keyLength;
+    QrmBoard board;
+    size_t byteCount;
+    /// Allocator of the cache (entry may outlive the cache)
+    QrmAllocator allocator;
+    /// Hash bucket chain
+    QrmBoardCacheEntry* nextInBucket;
+    /// LRU list (head = most recently used)
+    QrmBoardCacheEntry* previous;
+    QrmBoardCacheEntry* next;
+};
+
+struct QrmBoardCacheState {
+    pthread_mutex_t lock;
+    QrmBoardCacheEntry** buckets;
+    unsigned int bucketCount;
+    QrmBoardCacheEntry* head;
+    QrmBoardCacheEntry* tail;
+    QrmBoardCacheStatistics statistics;
+    /// Allocator of thread which created the cache; used for all cache memory whichever thread encodes or releases
+    QrmAllocator allocator;
+};
+
+// KEY ======================================================================================================
+
+unsigned int QrmBoardCache_writeValue(UnsignedByte* buffer, unsigned int offset, Unsigned4Bytes value) {
+    if (buffer != NULL) {
+        buffer[offset] = (UnsignedByte)(value >> 24);
+        buffer[offset + 1] = (UnsignedByte)(value >> 16);
+        buffer[offset + 2] = (UnsignedByte)(value >> 8);
+        buffer[offset + 3] = (UnsignedByte)value;
+    }
+    return offset + 4;
+}
+
+/// Serialize encoding input. Pass NULL `buffer` to get required length.
+unsigned int QrmBoardCache_makeKey(
+    UnsignedByte* buffer,
+    QrmSegment* segments,
+    unsigned int count,
+    QrmErrorCorrectionLevel level,
+    QrmExtraEncodingInfo extraMode,
+    UnsignedByte minVersion,
+    UnsignedByte maskId
+) {
+    unsigned int offset = 0;
+    // Any mask ID >= 8 means "auto": same key for all of them
+    if (maskId >= 8) {
+        maskId = 0xFF;
+    }
+    offset = QrmBoardCache_writeValue(buffer, offset, (level << 24) | (extraMode.mode << 16) | (minVersion << 8) | maskId);
+    offset = QrmBoardCache_writeValue(buffer, offset, extraMode.appIndicator != NULL ? extraMode.appIndicatorLength : 0);
+    if (extraMode.appIndicator != NULL && extraMode.appIndicatorLength > 0) {
+        if (buffer != NULL) {
+            memcpy(buffer + offset, extraMode.appIndicator, extraMode.appIndicatorLength);
+        }
+        offset += extraMode.appIndicatorLength;
+    }
+    offset = QrmBoardCache_writeValue(buffer, offset, count);
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmSegment segment = segments[index];
+        offset = QrmBoardCache_writeValue(buffer, offset, segment.mode);
+        offset = QrmBoardCache_writeValue(buffer, offset, segment.eci);
+        offset = QrmBoardCache_writeValue(buffer, offset, segment.length);
+        if (segment.length > 0 && segment.data != NULL) {
+            if (buffer != NULL) {
+                memcpy(buffer + offset, segment.data, segment.length);
+            }
+            offset += segment.length;
+        }
+    }
+    return offset;
+}
+
+/// Hash 8 bytes per step
+unsigned long long QrmBoardCache_hash(const UnsignedByte* data, unsigned int length) {
+    static const unsigned long long multiplier = 0x9E3779B97F4A7C15ULL;
+    unsigned long long result = 0xCBF29CE484222325ULL ^ length;
+    unsigned int index = 0;
+    for (; index + 8 <= length; index += 8) {
+        unsigned long long word;
+        memcpy(&word, data + index, 8);
+        result = (result ^ word) * multiplier;
+        result ^= result >> 29;
+    }
+    for (; index < length; index += 1) {
+        result = (result ^ data[index]) * 0x100000001B3ULL;
+    }
+    result ^= result >> 32;
+    return result;
+}
+
+// ENTRY ====================================================================================================
+
+void QrmBoardCache_retain(QrmBoardCacheEntry* entry) {
+    atomic_fetch_add_explicit(&entry->references, 1, memory_order_relaxed);
+}
+
+void QrmBoardCache_release(QrmBoardCacheEntry* entry) {
+    if (atomic_fetch_sub_explicit(&entry->references, 1, memory_order_acq_rel) == 1) {
+        QrmAllocator previous = QrmSetThreadAllocator(entry->allocator);
+        QrmBoardDestroy(&entry->board);
+        DEALLOC(entry->key);
+        DEALLOC(entry);
+        QrmSetThreadAllocator(previous);
+    }
+}
+
+void QrmBoardCache_unlink(QrmBoardCacheState* state, QrmBoardCacheEntry* entry) {
+    if (entry->previous != NULL) {
+        entry->previous->next = entry->next;
+    } else {
+        state->head = entry->next;
+    }
+    if (entry->next != NULL) {
+        entry->next->previous = entry->previous;
+    } else {
+        state->tail = entry->previous;
+    }
+    entry->previous = NULL;
+    entry->next = NULL;
+}
+
+void QrmBoardCache_pushFront(QrmBoardCacheState* state, QrmBoardCacheEntry* entry) {
+    entry->previous = NULL;
+    entry->next = state->head;
+    if (state->head != NULL) {
+        state->head->previous = entry;
+    }
+    state->head = entry;
+    if (state->tail == NULL) {
+        state->tail = entry;
+    }
+}
+
+QrmBoardCacheEntry* QrmBoardCache_find(QrmBoardCacheState* state, unsigned long long hash, const UnsignedByte* key, unsigned int keyLength) {
+    QrmBoardCacheEntry* entry = state->buckets[hash & (state->bucketCount - 1)];
+    while (entry != NULL) {
+        if (entry->hash == hash && entry->keyLength == keyLength && memcmp(entry->key, key, keyLength) == 0) {
+            return entry;
+        }
+        entry = entry->nextInBucket;
+    }
+    return NULL;
+}
+
+void QrmBoardCache_removeFromBucket(QrmBoardCacheState* state, QrmBoardCacheEntry* entry) {
+    QrmBoardCacheEntry** link = &state->buckets[entry->hash & (state->bucketCount - 1)];
+    while (*link != NULL) {
+        if (*link == entry) {
+            *link = entry->nextInBucket;
+            break;
+        }
+        link = &(*link)->nextInBucket;
+    }
+    entry->nextInBucket = NULL;
+}
+
+void QrmBoardCache_grow(QrmBoardCacheState* state) {
+    unsigned int newCount = state->bucketCount * 2;
+    ALLOC(QrmBoardCacheEntry*, buckets, newCount);
+    if (buckets == NULL) {
+        return;
+    }
+    for (unsigned int index = 0; index < state->bucketCount; index += 1) {
+        QrmBoardCacheEntry* entry = state->buckets[index];
+        while (entry != NULL) {
+            QrmBoardCacheEntry* next = entry->nextInBucket;
+            unsigned int bucket = entry->hash & (newCount - 1);
+            entry->nextInBucket = buckets[bucket];
+            buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+    DEALLOC(state->buckets);
+    state->buckets = buckets;
+    state->bucketCount = newCount;
+}
+
+void QrmBoardCache_evict(QrmBoardCacheState* state, QrmBoardCacheEntry* entry) {
+    QrmBoardCache_removeFromBucket(state, entry);
+    QrmBoardCache_unlink(state, entry);
+    state->statistics.entryCount -= 1;
+    state->statistics.byteCount -= entry->byteCount;
+    QrmBoardCache_release(entry);
+}
+
+// PUBLIC ===================================================================================================
+
+QrmBoardCache QrmBoardCacheCreate(size_t byteBudget) {
+    QrmBoardCache result;
+    ALLOC_(QrmBoardCacheState, result.state, 1);
+    if (result.state == NULL) {
+        return result;
+    }
+    QrmBoardCacheState* state = result.state;
+    pthread_mutex_init(&state->lock, NULL);
+    state->allocator = QrmGetAllocator();
+    state->bucketCount = BOARDCACHE_MIN_BUCKETS;
+    ALLOC_(QrmBoardCacheEntry*, state->buckets, state->bucketCount);
+    if (state->buckets == NULL) {
+        pthread_mutex_destroy(&state->lock);
+        DEALLOC(result.state);
+        return result;
+    }
+    state->statistics.byteBudget = byteBudget;
+    return result;
+}
+
+void QrmBoardCacheClear(QrmBoardCache cache) {
+    QrmBoardCacheState* state = cache.state;
+    if (state == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&state->lock);
+    while (state->tail != NULL) {
+        QrmBoardCache_evict(state, state->tail);
+    }
+    pthread_mutex_unlock(&state->lock);
+}
+
+void QrmBoardCacheDestroy(QrmBoardCache* cache) {
+    if (cache->state == NULL) {
+        return;
+    }
+    QrmBoardCacheClear(*cache);
+    pthread_mutex_destroy(&cache->state->lock);
+    QrmAllocator previous = QrmSetThreadAllocator(cache->state->allocator);
+    DEALLOC(cache->state->buckets);
+    DEALLOC(cache->state);
+    QrmSetThreadAllocator(previous);
+}
+
+QrmSharedBoard QrmBoardCache_encode(
+    QrmBoardCache cache,
+    QrmSegment* segments,
+    unsigned int count,
+    QrmErrorCorrectionLevel level,
+    QrmExtraEncodingInfo extraMode,
+    UnsignedByte minVersion,
+    UnsignedByte maskId
+) {
+    QrmSharedBoard result;
+    result.board = QrmBoardCreateEmpty();
+    result.entry = NULL;
+    QrmBoardCacheState* state = cache.state;
+    if (state == NULL) {
+        return result;
+    }
+    unsigned int keyLength = QrmBoardCache_makeKey(NULL, segments, count, level, extraMode, minVersion, maskId);
+    ALLOC(UnsignedByte, key, keyLength);
+    if (key == NULL) {
+        return result;
+    }
+    QrmBoardCache_makeKey(key, segments, count, level, extraMode, minVersion, maskId);
+    unsigned long long hash = QrmBoardCache_hash(key, keyLength);
+
+    pthread_mutex_lock(&state->lock);
+    QrmBoardCacheEntry* entry = QrmBoardCache_find(state, hash, key, keyLength);
+    if (entry != NULL) {
+        state->statistics.hits += 1;
+        QrmBoardCache_unlink(state, entry);
+        QrmBoardCache_pushFront(state, entry);
+        QrmBoardCache_retain(entry);
+        pthread_mutex_unlock(&state->lock);
+        DEALLOC(key);
+        result.board = entry->board;
+        result.entry = entry;
+        return result;
+    }
+    state->statistics.misses += 1;
+    pthread_mutex_unlock(&state->lock);
+
+    // Encode without holding the lock
+    QrmBoard board = QrmEncoderEncode(segments, count, level, extraMode, minVersion, maskId);
+    if (board.dimension == 0) {
+        DEALLOC(key);
+        return result;
+    }
+    ALLOC_(QrmBoardCacheEntry, entry, 1);
+    if (entry == NULL) {
+        QrmBoardDestroy(&board);
+        DEALLOC(key);
+        return result;
+    }
+    atomic_init(&entry->references, 2); // Cache & caller
+    entry->allocator = state->allocator;
+    entry->hash = hash;
+    entry->key = key;
+    entry->keyLength = keyLength;
+    entry->board = board;
+    entry->byteCount = sizeof(QrmBoardCacheEntry) + keyLength +
+        (size_t)board.dimension * (board.dimension + sizeof(UnsignedByte*));
+
+    pthread_mutex_lock(&state->lock);
+    QrmBoardCacheEntry* other = QrmBoardCache_find(state, hash, key, keyLength);
+    if (other != NULL) {
+        // Another thread encoded the same input meanwhile
+        QrmBoardCache_retain(other);
+        pthread_mutex_unlock(&state->lock);
+        QrmBoardDestroy(&entry->board);
+        DEALLOC(entry->key);
+        DEALLOC(entry);
+        result.board = other->board;
+        result.entry = other;
+        return result;
+    }
+    if (entry->byteCount <= state->statistics.byteBudget) {
+        if (state->statistics.entryCount >= state->bucketCount) {
+            QrmBoardCache_grow(state);
+        }
+        unsigned int bucket = hash & (state->bucketCount - 1);
+        entry->nextInBucket = state->buckets[bucket];
+        state->buckets[bucket] = entry;
+        QrmBoardCache_pushFront(state, entry);
+        state->statistics.entryCount += 1;
+        state->statistics.byteCount += entry->byteCount;
+        while (state->statistics.byteCount > state->statistics.byteBudget && state->tail != NULL) {
+            QrmBoardCache_evict(state, state->tail);
+            state->statistics.evictions += 1;
+        }
+    } else {
+        // Too big to be cached: caller owns the only reference
+        atomic_store(&entry->references, 1);
+    }
+    pthread_mutex_unlock(&state->lock);
+    result.board = entry->board;
+    result.entry = entry;
+    return result;
+}
+
+QrmSharedBoard QrmBoardCacheEncode(
+    QrmBoardCache cache,
+    QrmSegment* segments,
+    unsigned int count,
+    QrmErrorCorrectionLevel level,
+    QrmExtraEncodingInfo extraMode,
+    UnsignedByte minVersion,
+    UnsignedByte maskId
+) {
+    if (cache.state == NULL) {
+        QrmSharedBoard result;
+        result.board = QrmBoardCreateEmpty();
+        result.entry = NULL;
+        return result;
+    }
+    QrmAllocator previous = QrmSetThreadAllocator(cache.state->allocator);
+    QrmSharedBoard result = QrmBoardCache_encode(cache, segments, count, level, extraMode, minVersion, maskId);
+    QrmSetThreadAllocator(previous);
+    return result;
+}
+
+void QrmSharedBoardRelease(QrmSharedBoard* board) {
+    if (board->entry != NULL) {
+        QrmBoardCache_release(board->entry);
+        board->entry = NULL;
+    }
+    board->board = QrmBoardCreateEmpty();
+}
+
+QrmBoardCacheStatistics QrmBoardCacheGetStatistics(QrmBoardCache cache) {
+    QrmBoardCacheStatistics result;
+    memset(&result, 0, sizeof(result));
+    QrmBoardCacheState* state = cache.state;
+    if (state == NULL) {
+        return result;
+    }
+    pthread_mutex_lock(&state->lock);
+    result = state->statistics;
+    pthread_mutex_unlock(&state->lock);
+    return result;
+}
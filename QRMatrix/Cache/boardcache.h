@@ -0,0 +1,87 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOARDCACHE_H
+#define BOARDCACHE_H
+
+#include <stddef.h>
+#include "../qrmatrixencoder.h"
+
+typedef struct QrmBoardCacheState QrmBoardCacheState;
+typedef struct QrmBoardCacheEntry QrmBoardCacheEntry;
+
+/// Thread-safe LRU cache of encoded boards, keyed by encoding input.
+typedef struct {
+    QrmBoardCacheState* state;
+} QrmBoardCache;
+
+/// Board shared with cache (reference counted).
+/// `board` must not be modified or destroyed, use `QrmSharedBoardRelease` instead.
+typedef struct {
+    QrmBoard board;
+    QrmBoardCacheEntry* entry;
+} QrmSharedBoard;
+
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    /// Number of cached boards
+    unsigned int entryCount;
+    /// Estimated memory of cached boards & keys
+    size_t byteCount;
+    size_t byteBudget;
+} QrmBoardCacheStatistics;
+
+/// Constructor. All memory of the cache (including shared boards) uses the allocator of the calling thread,
+/// whichever thread encodes or releases later.
+QrmBoardCache QrmBoardCacheCreate(
+    /// Maximum memory (bytes) of cached boards; least recently used boards are evicted over this.
+    size_t byteBudget
+);
+/// Destructor. Shared boards which are not released yet are still valid.
+void QrmBoardCacheDestroy(QrmBoardCache* cache);
+/// Same as `QrmEncoderEncode` but get the board from cache if it was encoded before.
+/// @return Shared board (`board.dimension` = 0 if failed). Must be released when done.
+QrmSharedBoard QrmBoardCacheEncode(
+    QrmBoardCache cache,
+    /// Array of segments to be encoded
+    QrmSegment* segments,
+    /// Number of segments
+    unsigned int count,
+    /// Error correction info
+    QrmErrorCorrectionLevel level,
+    /// Extra mode
+    QrmExtraEncodingInfo extraMode,
+    /// Optional. Limit minimum version
+    UnsignedByte minVersion,
+    /// Optional. Force to use given mask (0-7).
+    UnsignedByte maskId
+);
+/// Release shared board.
+void QrmSharedBoardRelease(QrmSharedBoard* board);
+/// Get counters
+QrmBoardCacheStatistics QrmBoardCacheGetStatistics(QrmBoardCache cache);
+/// Remove all boards (shared boards which are not released yet are still valid).
+void QrmBoardCacheClear(QrmBoardCache cache);
+
+#endif // BOARDCACHE_H
@@ -65,17 +65,7 @@ unsigned int QrmAlphaNumericEncode(const UnsignedByte* text, unsigned int length
         }
         index += charCount;
         unsigned int encodedData = QrmAlphaNum_encodedValueOfPair(pair, charCount);
-        unsigned int encodedSize = sizeof(unsigned int);
-        unsigned int encodedOffset = encodedSize * 8 - encodedLen;
-        QrmCopyBits(
-            (unsigned char*)&encodedData,
-            encodedSize,
-            encodedOffset,
-            qrmIsLittleEndian,
-            buffer,
-            bitIndex,
-            encodedLen
-        );
+        QrmCopyValueBits(encodedData, encodedLen, buffer, bitIndex);
         bitIndex += encodedLen;
     }
     return bitIndex - startIndex;
@@ -31,16 +31,8 @@ unsigned int QrmKanjiEncode(
 ) {
     unsigned int bitIndex = startIndex;
     for (unsigned int index = 0; index < length; index += 2) {
-        UnsignedByte* ptr = (UnsignedByte*)text + index;
-        Unsigned2Bytes charWord = 0;
-        UnsignedByte* charWordPtr = (UnsignedByte*)&charWord;
-        if (qrmIsLittleEndian) {
-            *charWordPtr = *(ptr + 1);
-            *(charWordPtr + 1) = *ptr;
-        } else {
-            *charWordPtr = *ptr;
-            *(charWordPtr + 1) = *(ptr + 1);
-        }
+        // ShiftJIS character is stored in big endian order
+        Unsigned2Bytes charWord = (Unsigned2Bytes)((text[index] << 8) | text[index + 1]);
         Unsigned2Bytes offset = 0;
         if (charWord >= 0x8140 && charWord <= 0x9FFC) {
             offset = 0x8140;
@@ -51,17 +43,8 @@ unsigned int QrmKanjiEncode(
             break;
         }
         charWord = charWord - offset;
-        Unsigned2Bytes lsByte = 0;
-        Unsigned2Bytes msByte = 0;
-        if (qrmIsLittleEndian) {
-            lsByte = (Unsigned2Bytes)*charWordPtr;
-            msByte = (Unsigned2Bytes)*(charWordPtr + 1);
-        } else {
-            lsByte = (Unsigned2Bytes)*(charWordPtr + 1);
-            msByte = (Unsigned2Bytes)*charWordPtr;
-        }
-        charWord = (msByte * 0xC0) + lsByte;
-        QrmCopyBits(charWordPtr, 2, 3 /* 16 - 13 */, qrmIsLittleEndian, buffer, bitIndex, 13);
+        charWord = ((charWord >> 8) * 0xC0) + (charWord & 0xFF);
+        QrmCopyValueBits(charWord, 13, buffer, bitIndex);
         bitIndex += 13;
     }
     return bitIndex - startIndex;
@@ -23,7 +23,6 @@
 #include "numericencoder.h"
 #include "../common.h"
 #include <string.h>
-#include <stdlib.h>
 
 unsigned int QrmNumericEncode(const UnsignedByte* text, unsigned int length, UnsignedByte* buffer, unsigned int startIndex) {
     int index = 0;
@@ -38,13 +37,11 @@ unsigned int QrmNumericEncode(const UnsignedByte* text, unsigned int length, Uns
         } else {
             groupLen = 1;
         }
-        ALLOC(UnsignedByte, group, groupLen + 1);
+        unsigned int value = 0;
         for (unsigned int idx = 0; idx < groupLen; idx += 1) {
-            group[idx] = text[index + idx];
+            value = value * 10 + (text[index + idx] - '0');
         }
         index += groupLen;
-        unsigned int value = atoi((const char*)group);
-        DEALLOC(group);
         unsigned int bitLen;
         switch (groupLen) {
         case 3:
@@ -60,17 +57,7 @@ unsigned int QrmNumericEncode(const UnsignedByte* text, unsigned int length, Uns
             bitLen = 0;
             break;
         }
-        unsigned int encodedSize = sizeof(unsigned int);
-        unsigned int encodedOffset = encodedSize * 8 - bitLen;
-        QrmCopyBits(
-            (UnsignedByte*)&value,
-            encodedSize,
-            encodedOffset,
-            qrmIsLittleEndian,
-            buffer,
-            bitIndex,
-            bitLen
-        );
+        QrmCopyValueBits(value, bitLen, buffer, bitIndex);
         bitIndex += bitLen;
     }
     return bitIndex - startIndex;
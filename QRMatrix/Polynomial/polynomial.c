@@ -23,36 +23,37 @@
 #include "polynomial.h"
 #include <stdlib.h>
 
-UnsignedByte Polynomial_Exp[256];
-UnsignedByte Polynomial_Log[256];
+/// GF(256) tables of primitive polynomial 0x11D (see `Tables/gf256exp.inc`)
+static const UnsignedByte qrmPolynomialExp[512] = {
+#include "../Tables/gf256exp.inc"
+};
+static const UnsignedByte qrmPolynomialLog[256] = {
+#include "../Tables/gf256log.inc"
+};
 
 void QrmPolynomialInitialize() {
-    static const unsigned int prim = 0x11D;
-    unsigned int xVal = 1;
-    for (unsigned int index = 0; index < 255; index += 1) {
-        Polynomial_Exp[index] = (UnsignedByte)xVal;
-        Polynomial_Log[xVal] = (UnsignedByte)index;
-        xVal <<= 1;
-        if (xVal >= 256) {
-            xVal ^= prim;
-        }
-    }
 }
 
 UnsignedByte Polynomial_Multiple(UnsignedByte left, UnsignedByte right) {
     if (left == 0 || right == 0) {
         return 0;
     }
-    UnsignedByte result = Polynomial_Exp[(Polynomial_Log[left] + Polynomial_Log[right]) % 255];
+    UnsignedByte result = qrmPolynomialExp[qrmPolynomialLog[left] + qrmPolynomialLog[right]];
     return result;
 }
 
 UnsignedByte Polynomial_Power(UnsignedByte value, UnsignedByte power) {
-    return Polynomial_Exp[(Polynomial_Log[value] * power) % 255];
+    return qrmPolynomialExp[(qrmPolynomialLog[value] * power) % 255];
 }
 
 QrmPolynomial Polynomial_PolyMultiple(QrmPolynomial self, QrmPolynomial other) {
+    if (self.terms == NULL || other.terms == NULL) {
+        return QrmPolynomialCreate(0);
+    }
     QrmPolynomial result = QrmPolynomialCreate(self.length + other.length - 1);
+    if (result.terms == NULL) {
+        return result;
+    }
     for (unsigned int jndex = 0; jndex < other.length; jndex += 1) {
         for (unsigned int index = 0; index < self.length; index += 1) {
             result.terms[index + jndex] ^= Polynomial_Multiple(self.terms[index], other.terms[jndex]);
@@ -63,11 +64,16 @@ QrmPolynomial Polynomial_PolyMultiple(QrmPolynomial self, QrmPolynomial other) {
 
 QrmPolynomial Polynomial_getGeneratorPoly(unsigned int count) {
     QrmPolynomial result = QrmPolynomialCreate(1);
+    if (result.terms == NULL) {
+        return result;
+    }
     result.terms[0] = 1;
-    for (unsigned int index = 0; index < count; index += 1) {
+    for (unsigned int index = 0; index < count && result.terms != NULL; index += 1) {
         QrmPolynomial arg = QrmPolynomialCreate(2);
-        arg.terms[0] = 1;
-        arg.terms[1] = Polynomial_Power(2, index);
+        if (arg.terms != NULL) {
+            arg.terms[0] = 1;
+            arg.terms[1] = Polynomial_Power(2, index);
+        }
         QrmPolynomial temp = Polynomial_PolyMultiple(result, arg);
         QrmPolynomialDestroy(&arg);
         QrmPolynomialDestroy(&result);
@@ -83,7 +89,14 @@ QrmPolynomial QrmGetErrorCorrections(unsigned int count, QrmPolynomial data) {
         return QrmPolynomialCreate(0);
     }
     QrmPolynomial gen = Polynomial_getGeneratorPoly(count);
+    if (gen.terms == NULL) {
+        return gen;
+    }
     QrmPolynomial buffer = QrmPolynomialCreate(data.length + gen.length - 1);
+    if (buffer.terms == NULL) {
+        QrmPolynomialDestroy(&gen);
+        return buffer;
+    }
     for (unsigned int index = 0; index < data.length; index += 1) {
         buffer.terms[index] = data.terms[index];
     }
@@ -96,7 +109,7 @@ QrmPolynomial QrmGetErrorCorrections(unsigned int count, QrmPolynomial data) {
         }
     }
     QrmPolynomial result = QrmPolynomialCreate(buffer.length - data.length);
-    for (unsigned int index = data.length; index < buffer.length; index += 1) {
+    for (unsigned int index = data.length; index < buffer.length && result.terms != NULL; index += 1) {
         result.terms[index - data.length] = buffer.terms[index];
     }
     QrmPolynomialDestroy(&gen);
@@ -117,6 +130,9 @@ QrmPolynomial QrmPolynomialCreate(unsigned int count) {
     result.length = count;
     if (count > 0) {
         ALLOC_(UnsignedByte, result.terms, count);
+        if (result.terms == NULL) {
+            result.length = 0;
+        }
     } else {
         result.terms = NULL;
     }
@@ -32,13 +32,13 @@ typedef struct {
     UnsignedByte* terms;
 } QrmPolynomial;
 
-/// Cache data
+/// Kept for compatibility (tables are constant data): does nothing.
 void QrmPolynomialInitialize(void);
 /// Destructor
 void QrmPolynomialDestroy(QrmPolynomial* data);
-/// Constructor
+/// Constructor (`length` = 0 if out of memory)
 QrmPolynomial QrmPolynomialCreate(unsigned int count);
-/// Calculate EC data
+/// Calculate EC data (`length` = 0 if failed)
 QrmPolynomial QrmGetErrorCorrections(unsigned int count, QrmPolynomial data);
 
 #endif // POLYNOMIAL_H
@@ -0,0 +1,66 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "blit.h"
+#include <stddef.h>
+
+bool QrmBoardBlit(
+    QrmBoard board,
+    UnsignedByte* destination,
+    unsigned int stride,
+    QrmPixelFormat format,
+    unsigned int scale,
+    unsigned int x,
+    unsigned int y,
+    Unsigned4Bytes foreground,
+    Unsigned4Bytes background
+) {
+    if (board.dimension == 0 || destination == NULL || scale == 0) {
+        LOG("ERROR: Invalid blit parameters");
+        return false;
+    }
+    unsigned int width = board.dimension * scale;
+    if (QrmPixelRowLength(format, x + width) > stride) {
+        LOG("ERROR: Bitmap is too small");
+        return false;
+    }
+    for (UnsignedByte row = 0; row < board.dimension; row += 1) {
+        UnsignedByte* cells = board.buffer[row];
+        UnsignedByte* line = destination + (size_t)(y + row * scale) * stride;
+        // Runs of same color of first scaled row
+        UnsignedByte column = 0;
+        while (column < board.dimension) {
+            bool isDark = (cells[column] & CellLowMask) == CellSet;
+            UnsignedByte start = column;
+            column += 1;
+            while (column < board.dimension && ((cells[column] & CellLowMask) == CellSet) == isDark) {
+                column += 1;
+            }
+            QrmPixelFill(line, format, x + start * scale, (column - start) * scale, isDark ? foreground : background);
+        }
+        // Other scaled rows are the same
+        for (unsigned int index = 1; index < scale; index += 1) {
+            QrmPixelCopy(line + (size_t)index * stride, line, format, x, width);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BLIT_H
+#define BLIT_H
+
+#include "pixel.h"
+#include "../qrmatrixboard.h"
+
+/// Draw QR board (modules only, no quiet zone) into existing bitmap.
+/// Bitmap must contain `(dimension * scale)` x `(dimension * scale)` pixels from (`x`, `y`).
+/// @return false if parameters are invalid.
+bool QrmBoardBlit(
+    QrmBoard board,
+    /// First byte of bitmap
+    UnsignedByte* destination,
+    /// Number of bytes per bitmap row
+    unsigned int stride,
+    QrmPixelFormat format,
+    /// Pixels per module
+    unsigned int scale,
+    /// Position (pixel) of top left module in bitmap
+    unsigned int x,
+    unsigned int y,
+    /// Color of dark modules (see `QrmPixelFormat`)
+    Unsigned4Bytes foreground,
+    /// Color of light modules
+    Unsigned4Bytes background
+);
+
+#endif // BLIT_H
@@ -0,0 +1,258 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "deflate.h"
+#include <stdlib.h>
+#include <pthread.h>
+
+#define DEFLATE_MIN_MATCH       3
+#define DEFLATE_MAX_MATCH       258
+#define DEFLATE_WINDOW_SIZE     32768
+#define DEFLATE_HASH_BITS       15
+#define DEFLATE_HASH_SIZE       (1 << DEFLATE_HASH_BITS)
+/// Maximum number of previous positions to check for each match
+#define DEFLATE_MAX_CHAIN       64
+#define DEFLATE_BUFFER_SIZE     4096
+#define DEFLATE_ADLER_MOD       65521
+/// Max number of bytes before Adler32 sums may overflow
+#define DEFLATE_ADLER_NMAX      5552
+
+static const Unsigned2Bytes qrmDeflateLengthBases[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const UnsignedByte qrmDeflateLengthExtraBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/// Fixed Huffman codes of literal/length symbols (bits reversed, ready to write)
+static Unsigned2Bytes qrmDeflateLiteralCodes[288];
+static UnsignedByte qrmDeflateLiteralCodeLengths[288];
+/// Fixed Huffman codes of distance symbols (bits reversed)
+static UnsignedByte qrmDeflateDistanceCodes[30];
+/// Length symbol index of (match length - 3)
+static UnsignedByte qrmDeflateLengthIndexes[256];
+static pthread_once_t qrmDeflateTablesOnce = PTHREAD_ONCE_INIT;
+
+Unsigned2Bytes QrmDeflate_reverseBits(Unsigned2Bytes value, UnsignedByte length) {
+    Unsigned2Bytes result = 0;
+    for (UnsignedByte index = 0; index < length; index += 1) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+void QrmDeflate_initTables(void) {
+    // RFC 1951 3.2.6
+    for (Unsigned2Bytes symbol = 0; symbol < 288; symbol += 1) {
+        Unsigned2Bytes code;
+        UnsignedByte length;
+        if (symbol < 144) {
+            code = 0x30 + symbol;
+            length = 8;
+        } else if (symbol < 256) {
+            code = 0x190 + (symbol - 144);
+            length = 9;
+        } else if (symbol < 280) {
+            code = symbol - 256;
+            length = 7;
+        } else {
+            code = 0xC0 + (symbol - 280);
+            length = 8;
+        }
+        qrmDeflateLiteralCodes[symbol] = QrmDeflate_reverseBits(code, length);
+        qrmDeflateLiteralCodeLengths[symbol] = length;
+    }
+    for (UnsignedByte symbol = 0; symbol < 30; symbol += 1) {
+        qrmDeflateDistanceCodes[symbol] = (UnsignedByte)QrmDeflate_reverseBits(symbol, 5);
+    }
+    UnsignedByte lengthIndex = 0;
+    for (Unsigned2Bytes length = DEFLATE_MIN_MATCH; length <= DEFLATE_MAX_MATCH; length += 1) {
+        while (lengthIndex < 28 && qrmDeflateLengthBases[lengthIndex + 1] <= length) {
+            lengthIndex += 1;
+        }
+        qrmDeflateLengthIndexes[length - DEFLATE_MIN_MATCH] = lengthIndex;
+    }
+}
+
+/// Write bits (least significant bit first)
+void QrmDeflate_putBits(QrmDeflateBits* writer, Unsigned4Bytes value, unsigned int count) {
+    writer->bits |= (unsigned long long)value << writer->bitCount;
+    writer->bitCount += count;
+    while (writer->bitCount >= 8) {
+        writer->buffer[writer->length] = (UnsignedByte)writer->bits;
+        writer->length += 1;
+        writer->bits >>= 8;
+        writer->bitCount -= 8;
+        if (writer->length == writer->capacity) {
+            writer->flush(writer->context, writer->buffer, writer->length);
+            writer->length = 0;
+        }
+    }
+}
+
+unsigned int QrmDeflate_hash(const UnsignedByte* data) {
+    Unsigned4Bytes value = ((Unsigned4Bytes)data[0] << 16) | ((Unsigned4Bytes)data[1] << 8) | data[2];
+    return (value * 2654435761U) >> (32 - DEFLATE_HASH_BITS);
+}
+
+void QrmDeflate_writeOutput(void* context, const UnsignedByte* data, unsigned int length) {
+    QrmOutputWrite((QrmOutput*)context, data, length);
+}
+
+// PUBLIC ===================================================================================================
+
+QrmDeflateBits QrmDeflateBitsCreate(UnsignedByte* buffer, unsigned int capacity, QrmDeflateFlushCallback flush, void* context) {
+    pthread_once(&qrmDeflateTablesOnce, QrmDeflate_initTables);
+    QrmDeflateBits result;
+    result.buffer = buffer;
+    result.capacity = capacity;
+    result.length = 0;
+    result.bits = 0;
+    result.bitCount = 0;
+    result.flush = flush;
+    result.context = context;
+    // zlib header: deflate, 32K window, fastest
+    QrmDeflate_putBits(&result, 0x78, 8);
+    QrmDeflate_putBits(&result, 0x01, 8);
+    // Single final block of fixed Huffman codes
+    QrmDeflate_putBits(&result, 0x03, 3);
+    return result;
+}
+
+void QrmDeflatePutSymbol(QrmDeflateBits* writer, Unsigned2Bytes symbol) {
+    QrmDeflate_putBits(writer, qrmDeflateLiteralCodes[symbol], qrmDeflateLiteralCodeLengths[symbol]);
+}
+
+void QrmDeflatePutMatch(QrmDeflateBits* writer, unsigned int length, unsigned int distance) {
+    UnsignedByte lengthIndex = qrmDeflateLengthIndexes[length - DEFLATE_MIN_MATCH];
+    QrmDeflatePutSymbol(writer, 257 + lengthIndex);
+    if (qrmDeflateLengthExtraBits[lengthIndex] > 0) {
+        QrmDeflate_putBits(writer, length - qrmDeflateLengthBases[lengthIndex], qrmDeflateLengthExtraBits[lengthIndex]);
+    }
+    unsigned int value = distance - 1;
+    if (value < 4) {
+        QrmDeflate_putBits(writer, qrmDeflateDistanceCodes[value], 5);
+        return;
+    }
+    UnsignedByte bitLength = 0;
+    while ((value >> (bitLength + 1)) > 0) {
+        bitLength += 1;
+    }
+    UnsignedByte symbol = 2 * bitLength + ((value >> (bitLength - 1)) & 1);
+    QrmDeflate_putBits(writer, qrmDeflateDistanceCodes[symbol], 5);
+    QrmDeflate_putBits(writer, value & ((1U << (bitLength - 1)) - 1), bitLength - 1);
+}
+
+void QrmDeflateBitsFinish(QrmDeflateBits* writer, Unsigned4Bytes adler) {
+    QrmDeflatePutSymbol(writer, 256);
+    QrmDeflate_putBits(writer, 0, (8 - writer->bitCount) & 7);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        QrmDeflate_putBits(writer, (adler >> shift) & 0xFF, 8);
+    }
+    if (writer->length > 0) {
+        writer->flush(writer->context, writer->buffer, writer->length);
+        writer->length = 0;
+    }
+}
+
+Unsigned4Bytes QrmAdler32(Unsigned4Bytes adler, const UnsignedByte* data, size_t length) {
+    Unsigned4Bytes a = adler & 0xFFFF;
+    Unsigned4Bytes b = adler >> 16;
+    while (length > 0) {
+        size_t count = length < DEFLATE_ADLER_NMAX ? length : DEFLATE_ADLER_NMAX;
+        length -= count;
+        while (count > 0) {
+            a += *data;
+            b += a;
+            data += 1;
+            count -= 1;
+        }
+        a %= DEFLATE_ADLER_MOD;
+        b %= DEFLATE_ADLER_MOD;
+    }
+    return (b << 16) | a;
+}
+
+bool QrmDeflateCompress(QrmOutput* output, const UnsignedByte* data, size_t length) {
+    // Positions + 1 (0 = none)
+    ALLOC(size_t, head, DEFLATE_HASH_SIZE);
+    ALLOC(size_t, previous, DEFLATE_WINDOW_SIZE);
+    ALLOC(UnsignedByte, buffer, DEFLATE_BUFFER_SIZE);
+    if (head == NULL || previous == NULL || buffer == NULL) {
+        DEALLOC(head);
+        DEALLOC(previous);
+        DEALLOC(buffer);
+        return false;
+    }
+    QrmDeflateBits writer = QrmDeflateBitsCreate(buffer, DEFLATE_BUFFER_SIZE, QrmDeflate_writeOutput, output);
+    size_t position = 0;
+    while (position < length) {
+        unsigned int bestLength = 0;
+        size_t bestDistance = 0;
+        if (length - position >= DEFLATE_MIN_MATCH) {
+            unsigned int hash = QrmDeflate_hash(data + position);
+            size_t maxLength = length - position < DEFLATE_MAX_MATCH ? length - position : DEFLATE_MAX_MATCH;
+            size_t candidate = head[hash];
+            unsigned int chain = DEFLATE_MAX_CHAIN;
+            while (candidate > 0 && position - (candidate - 1) <= DEFLATE_WINDOW_SIZE && chain > 0) {
+                const UnsignedByte* match = data + candidate - 1;
+                if (match[bestLength] == data[position + bestLength]) {
+                    unsigned int matchLength = 0;
+                    while (matchLength < maxLength && match[matchLength] == data[position + matchLength]) {
+                        matchLength += 1;
+                    }
+                    if (matchLength > bestLength) {
+                        bestLength = matchLength;
+                        bestDistance = position - (candidate - 1);
+                        if (matchLength == maxLength) {
+                            break;
+                        }
+                    }
+                }
+                candidate = previous[(candidate - 1) & (DEFLATE_WINDOW_SIZE - 1)];
+                chain -= 1;
+            }
+        }
+        unsigned int step = 1;
+        if (bestLength >= DEFLATE_MIN_MATCH) {
+            QrmDeflatePutMatch(&writer, bestLength, (unsigned int)bestDistance);
+            step = bestLength;
+        } else {
+            QrmDeflatePutSymbol(&writer, data[position]);
+        }
+        // Insert all positions of literal / match into hash chains
+        for (unsigned int index = 0; index < step; index += 1) {
+            if (length - position >= DEFLATE_MIN_MATCH) {
+                unsigned int hash = QrmDeflate_hash(data + position);
+                previous[position & (DEFLATE_WINDOW_SIZE - 1)] = head[hash];
+                head[hash] = position + 1;
+            }
+            position += 1;
+        }
+    }
+    QrmDeflateBitsFinish(&writer, QrmAdler32(1, data, length));
+    DEALLOC(head);
+    DEALLOC(previous);
+    DEALLOC(buffer);
+    return !output->isFailed;
+}
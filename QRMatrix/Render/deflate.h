@@ -0,0 +1,62 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+#include "renderoutput.h"
+
+/// Receive full buffer of `QrmDeflateBits` (eg. write it as a PNG IDAT chunk).
+typedef void (*QrmDeflateFlushCallback)(void* context, const UnsignedByte* data, unsigned int length);
+
+/// zlib stream writer (RFC 1950) of a single deflate block of fixed Huffman codes (RFC 1951 3.2.6).
+/// Shared by `QrmDeflateCompress` & PNG writer (which finds matches itself).
+typedef struct {
+    /// Compressed bytes not passed to `flush` yet
+    UnsignedByte* buffer;
+    unsigned int capacity;
+    unsigned int length;
+    /// Bits waiting for `buffer` (least significant bit first)
+    unsigned long long bits;
+    unsigned int bitCount;
+    QrmDeflateFlushCallback flush;
+    void* context;
+} QrmDeflateBits;
+
+/// Make writer over `buffer` (owned by caller) and write zlib header & block header.
+QrmDeflateBits QrmDeflateBitsCreate(UnsignedByte* buffer, unsigned int capacity, QrmDeflateFlushCallback flush, void* context);
+/// Write literal byte (0...255) or end of block (256)
+void QrmDeflatePutSymbol(QrmDeflateBits* writer, Unsigned2Bytes symbol);
+/// Write match (`length`: 3...258, `distance`: 1...32768)
+void QrmDeflatePutMatch(QrmDeflateBits* writer, unsigned int length, unsigned int distance);
+/// Write end of block & Adler32 (of uncompressed data) then pass remaining bytes to `flush`.
+void QrmDeflateBitsFinish(QrmDeflateBits* writer, Unsigned4Bytes adler);
+
+/// Update Adler32 (start with 1)
+Unsigned4Bytes QrmAdler32(Unsigned4Bytes adler, const UnsignedByte* data, size_t length);
+
+/// Compress data into zlib stream (LZ77 matching & fixed Huffman codes).
+/// Used for text content (eg. PDF content streams).
+/// @return false if failed.
+bool QrmDeflateCompress(QrmOutput* output, const UnsignedByte* data, size_t length);
+
+#endif // DEFLATE_H
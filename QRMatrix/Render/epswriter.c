@@ -0,0 +1,76 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "epswriter.h"
+#include <stdlib.h>
+
+bool QrmEpsWrite(QrmOutput* output, QrmBoard board, double moduleSize, unsigned int quietZone) {
+    if (board.dimension == 0 || moduleSize <= 0) {
+        return false;
+    }
+    unsigned int count = QrmBoardToRects(board, QRM_CELL_FILTER_ALL, NULL, 0);
+    ALLOC(QrmRect, rects, count > 0 ? count : 1);
+    if (rects == NULL) {
+        return false;
+    }
+    QrmBoardToRects(board, QRM_CELL_FILTER_ALL, rects, count);
+    unsigned int modules = board.dimension + 2 * quietZone;
+    double size = modules * moduleSize;
+    QrmOutputWriteString(output, "%!PS-Adobe-3.0 EPSF-3.0\n%%BoundingBox: 0 0 ");
+    // Integer bounding box must contain whole image
+    unsigned long boxSize = (unsigned long)size;
+    if (boxSize < size) {
+        boxSize += 1;
+    }
+    QrmOutputWriteUnsigned(output, boxSize);
+    QrmOutputWriteString(output, " ");
+    QrmOutputWriteUnsigned(output, boxSize);
+    QrmOutputWriteString(output, "\n%%HiResBoundingBox: 0 0 ");
+    QrmOutputWriteDecimal(output, size);
+    QrmOutputWriteString(output, " ");
+    QrmOutputWriteDecimal(output, size);
+    QrmOutputWriteString(output, "\n%%LanguageLevel: 2\n%%EndComments\n");
+    // Module coordinates: origin at top left module, y axis down
+    QrmOutputWriteString(output, "gsave\n/r{rectfill}bind def\n0 setgray\n");
+    QrmOutputWriteDecimal(output, quietZone * moduleSize);
+    QrmOutputWriteString(output, " ");
+    QrmOutputWriteDecimal(output, size - quietZone * moduleSize);
+    QrmOutputWriteString(output, " translate ");
+    QrmOutputWriteDecimal(output, moduleSize);
+    QrmOutputWriteString(output, " ");
+    QrmOutputWriteDecimal(output, -moduleSize);
+    QrmOutputWriteString(output, " scale\n");
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmRect rect = rects[index];
+        QrmOutputWriteUnsigned(output, rect.x);
+        QrmOutputWriteString(output, " ");
+        QrmOutputWriteUnsigned(output, rect.y);
+        QrmOutputWriteString(output, " ");
+        QrmOutputWriteUnsigned(output, rect.width);
+        QrmOutputWriteString(output, " ");
+        QrmOutputWriteUnsigned(output, rect.height);
+        QrmOutputWriteString(output, " r\n");
+    }
+    QrmOutputWriteString(output, "grestore\nshowpage\n%%EOF\n");
+    DEALLOC(rects);
+    return QrmOutputFlush(output);
+}
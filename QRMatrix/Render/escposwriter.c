@@ -0,0 +1,59 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "escposwriter.h"
+#include "raster.h"
+
+#define ESCPOS_MAX_BLOCK_HEIGHT 0xFFFF
+
+bool QrmEscPosWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone, unsigned int maxBlockHeight) {
+    QrmRaster raster = QrmRasterCreate(board, scale, quietZone, Pixel1Bit, false);
+    if (raster.width == 0 || raster.rowLength > 0xFFFF) {
+        QrmRasterDestroy(&raster);
+        return false;
+    }
+    if (maxBlockHeight == 0 || maxBlockHeight > ESCPOS_MAX_BLOCK_HEIGHT) {
+        maxBlockHeight = ESCPOS_MAX_BLOCK_HEIGHT;
+    }
+    unsigned int blockRows = 0;
+    const UnsignedByte* row = QrmRasterNextRow(&raster);
+    while (row != NULL) {
+        if (blockRows == 0) {
+            // Rows of new block
+            blockRows = raster.width - (raster.row - 1);
+            if (blockRows > maxBlockHeight) {
+                blockRows = maxBlockHeight;
+            }
+            UnsignedByte header[] = {
+                0x1D, 'v', '0', 0,
+                (UnsignedByte)(raster.rowLength & 0xFF), (UnsignedByte)(raster.rowLength >> 8),
+                (UnsignedByte)(blockRows & 0xFF), (UnsignedByte)(blockRows >> 8)
+            };
+            QrmOutputWrite(output, header, sizeof(header));
+        }
+        QrmOutputWrite(output, row, raster.rowLength);
+        blockRows -= 1;
+        row = QrmRasterNextRow(&raster);
+    }
+    QrmRasterDestroy(&raster);
+    return QrmOutputFlush(output);
+}
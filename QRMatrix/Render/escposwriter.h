@@ -0,0 +1,43 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ESCPOSWRITER_H
+#define ESCPOSWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Write QR board as ESC/POS raster bit image commands (`GS v 0`, normal density).
+/// @return false if failed.
+bool QrmEscPosWrite(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Dots per module
+    unsigned int scale,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone,
+    /// Maximum number of rows of each `GS v 0` command (0 = 65535).
+    /// Some printers limit image height of 1 command (eg. 255 or 2303 dots).
+    unsigned int maxBlockHeight
+);
+
+#endif // ESCPOSWRITER_H
@@ -0,0 +1,47 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "pbmwriter.h"
+#include "raster.h"
+
+bool QrmPbmWriteHeader(QrmOutput* output, unsigned int width, unsigned int height) {
+    QrmOutputWriteString(output, "P4\n");
+    QrmOutputWriteUnsigned(output, width);
+    QrmOutputWriteString(output, " ");
+    QrmOutputWriteUnsigned(output, height);
+    return QrmOutputWriteString(output, "\n");
+}
+
+bool QrmPbmWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone) {
+    QrmRaster raster = QrmRasterCreate(board, scale, quietZone, Pixel1Bit, false);
+    if (raster.width == 0) {
+        return false;
+    }
+    QrmPbmWriteHeader(output, raster.width, raster.width);
+    const UnsignedByte* row = QrmRasterNextRow(&raster);
+    while (row != NULL) {
+        QrmOutputWrite(output, row, raster.rowLength);
+        row = QrmRasterNextRow(&raster);
+    }
+    QrmRasterDestroy(&raster);
+    return QrmOutputFlush(output);
+}
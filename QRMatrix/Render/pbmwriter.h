@@ -0,0 +1,44 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PBMWRITER_H
+#define PBMWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Write header of binary PBM (P4) image.
+/// Then write `height` rows of `(width + 7) / 8` bytes (`Pixel1Bit` format: bit 1 = black) using `QrmOutputWrite`.
+bool QrmPbmWriteHeader(QrmOutput* output, unsigned int width, unsigned int height);
+
+/// Write PBM image of QR board.
+/// @return false if failed.
+bool QrmPbmWrite(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Pixels per module
+    unsigned int scale,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone
+);
+
+#endif // PBMWRITER_H
@@ -0,0 +1,189 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "pdfwriter.h"
+#include "deflate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/// Objects: catalog, pages, page, content stream
+#define PDF_OBJECT_COUNT 4
+
+QrmPdfWriter QrmPdfWriterCreate(QrmOutput* output, double width, double height) {
+    QrmPdfWriter result;
+    memset(&result, 0, sizeof(result));
+    if (width <= 0 || height <= 0) {
+        LOG("ERROR: Invalid PDF page size");
+        return result;
+    }
+    // Offsets of cross reference table count from the start of output
+    if (output == NULL || output->length > 0) {
+        LOG("ERROR: PDF output must be empty");
+        return result;
+    }
+    result.output = output;
+    result.width = width;
+    result.height = height;
+    result.content = QrmOutputCreateBuffer(0);
+    // Dark color
+    QrmOutputWriteString(&result.content, "0 g\n");
+    return result;
+}
+
+void QrmPdfWriterDestroy(QrmPdfWriter* writer) {
+    QrmOutputDestroy(&writer->content);
+    DEALLOC(writer->rects);
+    writer->rectCapacity = 0;
+    writer->output = NULL;
+}
+
+bool QrmPdfWriterAddBoard(QrmPdfWriter* writer, QrmBoard board, double x, double y, double moduleSize) {
+    if (writer->output == NULL || board.dimension == 0) {
+        return false;
+    }
+    unsigned int count = QrmBoardToRects(board, QRM_CELL_FILTER_ALL, writer->rects, writer->rectCapacity);
+    if (count > writer->rectCapacity) {
+        DEALLOC(writer->rects);
+        ALLOC_(QrmRect, writer->rects, count);
+        if (writer->rects == NULL) {
+            writer->rectCapacity = 0;
+            writer->isFailed = true;
+            return false;
+        }
+        writer->rectCapacity = count;
+        QrmBoardToRects(board, QRM_CELL_FILTER_ALL, writer->rects, writer->rectCapacity);
+    }
+    // Module coordinates: origin at top left module, y axis down
+    QrmOutput* content = &writer->content;
+    QrmOutputWriteString(content, "q ");
+    QrmOutputWriteDecimal(content, moduleSize);
+    QrmOutputWriteString(content, " 0 0 ");
+    QrmOutputWriteDecimal(content, -moduleSize);
+    QrmOutputWriteString(content, " ");
+    QrmOutputWriteDecimal(content, x);
+    QrmOutputWriteString(content, " ");
+    QrmOutputWriteDecimal(content, writer->height - y);
+    QrmOutputWriteString(content, " cm\n");
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmRect rect = writer->rects[index];
+        QrmOutputWriteUnsigned(content, rect.x);
+        QrmOutputWriteString(content, " ");
+        QrmOutputWriteUnsigned(content, rect.y);
+        QrmOutputWriteString(content, " ");
+        QrmOutputWriteUnsigned(content, rect.width);
+        QrmOutputWriteString(content, " ");
+        QrmOutputWriteUnsigned(content, rect.height);
+        QrmOutputWriteString(content, " re\n");
+    }
+    QrmOutputWriteString(content, "f Q\n");
+    if (content->isFailed) {
+        writer->isFailed = true;
+    }
+    return !writer->isFailed;
+}
+
+void QrmPdf_write(QrmPdfWriter* writer, const void* data, size_t length) {
+    QrmOutputWrite(writer->output, data, length);
+    writer->offset += length;
+}
+
+void QrmPdf_writeString(QrmPdfWriter* writer, const char* text) {
+    QrmPdf_write(writer, text, strlen(text));
+}
+
+void QrmPdf_writeOutput(QrmPdfWriter* writer, QrmOutput* output) {
+    QrmPdf_write(writer, output->buffer, output->length);
+    QrmOutputReset(output);
+}
+
+bool QrmPdfWriterFinish(QrmPdfWriter* writer) {
+    if (writer->output == NULL || writer->isFailed) {
+        return false;
+    }
+    size_t offsets[PDF_OBJECT_COUNT];
+    QrmOutput text = QrmOutputCreateBuffer(0);
+    QrmOutput stream = QrmOutputCreateBuffer(writer->content.length / 4 + 64);
+    if (!QrmDeflateCompress(&stream, writer->content.buffer, writer->content.length)) {
+        QrmOutputDestroy(&text);
+        QrmOutputDestroy(&stream);
+        writer->isFailed = true;
+        return false;
+    }
+    // Header (binary comment marks file as binary)
+    QrmPdf_writeString(writer, "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+    offsets[0] = writer->offset;
+    QrmPdf_writeString(writer, "1 0 obj\n<</Type/Catalog/Pages 2 0 R>>\nendobj\n");
+    offsets[1] = writer->offset;
+    QrmPdf_writeString(writer, "2 0 obj\n<</Type/Pages/Kids[3 0 R]/Count 1>>\nendobj\n");
+    offsets[2] = writer->offset;
+    QrmOutputWriteString(&text, "3 0 obj\n<</Type/Page/Parent 2 0 R/MediaBox[0 0 ");
+    QrmOutputWriteDecimal(&text, writer->width);
+    QrmOutputWriteString(&text, " ");
+    QrmOutputWriteDecimal(&text, writer->height);
+    QrmOutputWriteString(&text, "]/Resources<<>>/Contents 4 0 R>>\nendobj\n");
+    QrmPdf_writeOutput(writer, &text);
+    offsets[3] = writer->offset;
+    QrmOutputWriteString(&text, "4 0 obj\n<</Length ");
+    QrmOutputWriteUnsigned(&text, stream.length);
+    QrmOutputWriteString(&text, "/Filter/FlateDecode>>\nstream\n");
+    QrmPdf_writeOutput(writer, &text);
+    QrmPdf_writeOutput(writer, &stream);
+    QrmPdf_writeString(writer, "\nendstream\nendobj\n");
+    // Cross reference table: entries of 20 bytes
+    size_t xrefOffset = writer->offset;
+    QrmOutputWriteString(&text, "xref\n0 ");
+    QrmOutputWriteUnsigned(&text, PDF_OBJECT_COUNT + 1);
+    QrmOutputWriteString(&text, "\n0000000000 65535 f \n");
+    for (unsigned int index = 0; index < PDF_OBJECT_COUNT; index += 1) {
+        char entry[21];
+        size_t value = offsets[index];
+        for (int digit = 9; digit >= 0; digit -= 1) {
+            entry[digit] = (char)('0' + value % 10);
+            value /= 10;
+        }
+        memcpy(entry + 10, " 00000 n \n", 10);
+        QrmOutputWrite(&text, entry, 20);
+    }
+    QrmOutputWriteString(&text, "trailer\n<</Size ");
+    QrmOutputWriteUnsigned(&text, PDF_OBJECT_COUNT + 1);
+    QrmOutputWriteString(&text, "/Root 1 0 R>>\nstartxref\n");
+    QrmOutputWriteUnsigned(&text, xrefOffset);
+    QrmOutputWriteString(&text, "\n%%EOF\n");
+    bool isTextFailed = text.isFailed;
+    QrmPdf_writeOutput(writer, &text);
+    QrmOutputDestroy(&text);
+    QrmOutputDestroy(&stream);
+    if (isTextFailed) {
+        writer->isFailed = true;
+        return false;
+    }
+    return QrmOutputFlush(writer->output);
+}
+
+bool QrmPdfWrite(QrmOutput* output, QrmBoard board, double moduleSize, unsigned int quietZone) {
+    double size = (board.dimension + 2 * quietZone) * moduleSize;
+    QrmPdfWriter writer = QrmPdfWriterCreate(output, size, size);
+    bool isSuccess = QrmPdfWriterAddBoard(&writer, board, quietZone * moduleSize, quietZone * moduleSize, moduleSize) &&
+        QrmPdfWriterFinish(&writer);
+    QrmPdfWriterDestroy(&writer);
+    return isSuccess;
+}
@@ -0,0 +1,78 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PDFWRITER_H
+#define PDFWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Write single page PDF document containing many QR boards (vector, unit: point = 1/72 inch).
+/// Dark modules of each board are merged into rectangles (`QrmBoardToRects`) and filled at once.
+/// All boards share 1 content stream (Flate compressed when finishing) & page resources.
+typedef struct {
+    QrmOutput* output;
+    /// Page size
+    double width;
+    double height;
+    /// Uncompressed content stream
+    QrmOutput content;
+    /// Rectangles buffer
+    QrmRect* rects;
+    unsigned int rectCapacity;
+    /// Number of bytes written to `output`
+    size_t offset;
+    bool isFailed;
+} QrmPdfWriter;
+
+/// Constructor. Page size in points (eg. A4: 595.276 x 841.89).
+/// PDF must be the whole content of `output` (cross reference offsets count from the first byte written by the writer):
+/// memory output must be empty, callback output must not have passed other bytes to its callback.
+/// @return Writer (`output` = NULL if failed, including non empty output).
+QrmPdfWriter QrmPdfWriterCreate(QrmOutput* output, double width, double height);
+/// Destructor
+void QrmPdfWriterDestroy(QrmPdfWriter* writer);
+/// Add QR board to page.
+bool QrmPdfWriterAddBoard(
+    QrmPdfWriter* writer,
+    QrmBoard board,
+    /// Position of top left module from top left of page (quiet zone is not drawn)
+    double x,
+    double y,
+    /// Module size
+    double moduleSize
+);
+/// Write PDF document (output is flushed).
+bool QrmPdfWriterFinish(QrmPdfWriter* writer);
+
+/// Write PDF document of single QR board. Page size fits symbol & quiet zone.
+/// @return false if failed (`output` must be empty, see `QrmPdfWriterCreate`).
+bool QrmPdfWrite(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Module size in points
+    double moduleSize,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone
+);
+
+#endif // PDFWRITER_H
@@ -0,0 +1,179 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "pixel.h"
+#include <string.h>
+
+// Define QRM_NO_SIMD to use scalar code only
+#if !defined(QRM_NO_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define PIXEL_SSE2 1
+#elif !defined(QRM_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define PIXEL_NEON 1
+#endif
+
+unsigned int QrmPixelRowLength(QrmPixelFormat format, unsigned int width) {
+    switch (format) {
+    case Pixel1Bit:
+        return (width + 7) / 8;
+    case PixelGray8:
+        return width;
+    case PixelRGB565:
+        return width * 2;
+    case PixelRGBA8888:
+        return width * 4;
+    }
+    return 0;
+}
+
+Unsigned4Bytes QrmPixelColor(QrmPixelFormat format, bool isDark) {
+    switch (format) {
+    case Pixel1Bit:
+        return isDark ? 1 : 0;
+    case PixelGray8:
+        return isDark ? 0x00 : 0xFF;
+    case PixelRGB565:
+        return isDark ? 0x0000 : 0xFFFF;
+    case PixelRGBA8888:
+        return isDark ? 0x000000FF : 0xFFFFFFFF;
+    }
+    return 0;
+}
+
+/// Set bits [start, start + count) of row
+void QrmPixel_fillBits(UnsignedByte* row, unsigned int start, unsigned int count, bool isSet) {
+    unsigned int end = start + count;
+    unsigned int firstByte = start >> 3;
+    unsigned int lastByte = (end - 1) >> 3;
+    UnsignedByte firstMask = 0xFF >> (start & 0x07);
+    UnsignedByte lastMask = 0xFF << (7 - ((end - 1) & 0x07));
+    if (firstByte == lastByte) {
+        firstMask &= lastMask;
+        row[firstByte] = isSet ? (row[firstByte] | firstMask) : (row[firstByte] & ~firstMask);
+        return;
+    }
+    row[firstByte] = isSet ? (row[firstByte] | firstMask) : (row[firstByte] & ~firstMask);
+    if (lastByte > firstByte + 1) {
+        memset(row + firstByte + 1, isSet ? 0xFF : 0x00, lastByte - firstByte - 1);
+    }
+    row[lastByte] = isSet ? (row[lastByte] | lastMask) : (row[lastByte] & ~lastMask);
+}
+
+void QrmPixel_fill16(UnsignedByte* destination, Unsigned2Bytes value, unsigned int count) {
+#if PIXEL_SSE2
+    __m128i vector = _mm_set1_epi16((short)value);
+    while (count >= 8) {
+        _mm_storeu_si128((__m128i*)destination, vector);
+        destination += 16;
+        count -= 8;
+    }
+#elif PIXEL_NEON
+    uint16x8_t vector = vdupq_n_u16(value);
+    while (count >= 8) {
+        vst1q_u8(destination, vreinterpretq_u8_u16(vector));
+        destination += 16;
+        count -= 8;
+    }
+#endif
+    while (count > 0) {
+        memcpy(destination, &value, 2);
+        destination += 2;
+        count -= 1;
+    }
+}
+
+void QrmPixel_fill32(UnsignedByte* destination, Unsigned4Bytes value, unsigned int count) {
+#if PIXEL_SSE2
+    __m128i vector = _mm_set1_epi32((int)value);
+    while (count >= 4) {
+        _mm_storeu_si128((__m128i*)destination, vector);
+        destination += 16;
+        count -= 4;
+    }
+#elif PIXEL_NEON
+    uint32x4_t vector = vdupq_n_u32(value);
+    while (count >= 4) {
+        vst1q_u8(destination, vreinterpretq_u8_u32(vector));
+        destination += 16;
+        count -= 4;
+    }
+#endif
+    while (count > 0) {
+        memcpy(destination, &value, 4);
+        destination += 4;
+        count -= 1;
+    }
+}
+
+void QrmPixelFill(UnsignedByte* row, QrmPixelFormat format, unsigned int start, unsigned int count, Unsigned4Bytes color) {
+    if (count == 0) {
+        return;
+    }
+    switch (format) {
+    case Pixel1Bit:
+        QrmPixel_fillBits(row, start, count, (color & 0x01) != 0);
+        break;
+    case PixelGray8:
+        memset(row + start, (UnsignedByte)color, count);
+        break;
+    case PixelRGB565:
+        QrmPixel_fill16(row + start * 2, (Unsigned2Bytes)color, count);
+        break;
+    case PixelRGBA8888: {
+        // Bytes R, G, B, A in memory
+        UnsignedByte bytes[4] = {
+            (UnsignedByte)(color >> 24), (UnsignedByte)(color >> 16), (UnsignedByte)(color >> 8), (UnsignedByte)color
+        };
+        Unsigned4Bytes value;
+        memcpy(&value, bytes, 4);
+        QrmPixel_fill32(row + start * 4, value, count);
+        break;
+    }
+    }
+}
+
+void QrmPixelCopy(UnsignedByte* destination, const UnsignedByte* source, QrmPixelFormat format, unsigned int start, unsigned int count) {
+    if (count == 0) {
+        return;
+    }
+    if (format != Pixel1Bit) {
+        unsigned int size = QrmPixelRowLength(format, 1);
+        memcpy(destination + start * size, source + start * size, count * size);
+        return;
+    }
+    unsigned int end = start + count;
+    unsigned int firstByte = start >> 3;
+    unsigned int lastByte = (end - 1) >> 3;
+    UnsignedByte firstMask = 0xFF >> (start & 0x07);
+    UnsignedByte lastMask = 0xFF << (7 - ((end - 1) & 0x07));
+    if (firstByte == lastByte) {
+        firstMask &= lastMask;
+    }
+    destination[firstByte] = (destination[firstByte] & ~firstMask) | (source[firstByte] & firstMask);
+    if (lastByte > firstByte) {
+        if (lastByte > firstByte + 1) {
+            memcpy(destination + firstByte + 1, source + firstByte + 1, lastByte - firstByte - 1);
+        }
+        destination[lastByte] = (destination[lastByte] & ~lastMask) | (source[lastByte] & lastMask);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PIXEL_H
+#define PIXEL_H
+
+#include "../constants.h"
+
+/// Pixel format of bitmap output
+typedef enum {
+    /// 1 bit per pixel, most significant bit first (rows are padded to byte)
+    Pixel1Bit,
+    /// 1 byte per pixel
+    PixelGray8,
+    /// 2 bytes per pixel (native byte order)
+    PixelRGB565,
+    /// 4 bytes per pixel (R, G, B, A)
+    PixelRGBA8888
+} QrmPixelFormat;
+
+/*
+ Color value (`Unsigned4Bytes`) of each format:
+ - Pixel1Bit: 0 or 1.
+ - PixelGray8: 0x00...0xFF.
+ - PixelRGB565: 0xRRRRRGGGGGGBBBBB.
+ - PixelRGBA8888: 0xRRGGBBAA.
+ */
+
+/// Number of bytes of a row of `width` pixels
+unsigned int QrmPixelRowLength(QrmPixelFormat format, unsigned int width);
+/// Default color of dark (black) or light (white) module.
+/// Pixel1Bit: dark = 1; PixelRGBA8888: opaque.
+Unsigned4Bytes QrmPixelColor(QrmPixelFormat format, bool isDark);
+/// Fill `count` pixels of row (from pixel index `start`) with `color`.
+void QrmPixelFill(UnsignedByte* row, QrmPixelFormat format, unsigned int start, unsigned int count, Unsigned4Bytes color);
+/// Copy `count` pixels (from pixel index `start`) of a row into other row. Other pixels are not modified.
+void QrmPixelCopy(UnsignedByte* destination, const UnsignedByte* source, QrmPixelFormat format, unsigned int start, unsigned int count);
+
+#endif // PIXEL_H
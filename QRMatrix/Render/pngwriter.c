@@ -0,0 +1,257 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "pngwriter.h"
+#include "raster.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define PNG_CHUNK_CAPACITY 32768
+#define PNG_MAX_MATCH 258
+#define PNG_MIN_MATCH 3
+#define PNG_MAX_DISTANCE 32768
+
+/// CRC32 tables for slicing by 8 bytes
+static Unsigned4Bytes qrmPngCrcTables[8][256];
+static pthread_once_t qrmPngTablesOnce = PTHREAD_ONCE_INIT;
+
+void QrmPng_initTables(void) {
+    for (Unsigned4Bytes index = 0; index < 256; index += 1) {
+        Unsigned4Bytes value = index;
+        for (UnsignedByte bit = 0; bit < 8; bit += 1) {
+            value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+        }
+        qrmPngCrcTables[0][index] = value;
+    }
+    for (Unsigned4Bytes index = 0; index < 256; index += 1) {
+        for (UnsignedByte table = 1; table < 8; table += 1) {
+            Unsigned4Bytes previous = qrmPngCrcTables[table - 1][index];
+            qrmPngCrcTables[table][index] = (previous >> 8) ^ qrmPngCrcTables[0][previous & 0xFF];
+        }
+    }
+}
+
+Unsigned4Bytes QrmCrc32(Unsigned4Bytes crc, const UnsignedByte* data, size_t length) {
+    pthread_once(&qrmPngTablesOnce, QrmPng_initTables);
+    Unsigned4Bytes value = ~crc;
+    while (length >= 8) {
+        Unsigned4Bytes one = value ^ ((Unsigned4Bytes)data[0] | ((Unsigned4Bytes)data[1] << 8) | ((Unsigned4Bytes)data[2] << 16) | ((Unsigned4Bytes)data[3] << 24));
+        Unsigned4Bytes two = (Unsigned4Bytes)data[4] | ((Unsigned4Bytes)data[5] << 8) | ((Unsigned4Bytes)data[6] << 16) | ((Unsigned4Bytes)data[7] << 24);
+        value = qrmPngCrcTables[7][one & 0xFF] ^ qrmPngCrcTables[6][(one >> 8) & 0xFF] ^
+            qrmPngCrcTables[5][(one >> 16) & 0xFF] ^ qrmPngCrcTables[4][one >> 24] ^
+            qrmPngCrcTables[3][two & 0xFF] ^ qrmPngCrcTables[2][(two >> 8) & 0xFF] ^
+            qrmPngCrcTables[1][(two >> 16) & 0xFF] ^ qrmPngCrcTables[0][two >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        value = (value >> 8) ^ qrmPngCrcTables[0][(value ^ *data) & 0xFF];
+        data += 1;
+        length -= 1;
+    }
+    return ~value;
+}
+
+void QrmPng_write4(UnsignedByte* buffer, Unsigned4Bytes value) {
+    buffer[0] = (UnsignedByte)(value >> 24);
+    buffer[1] = (UnsignedByte)(value >> 16);
+    buffer[2] = (UnsignedByte)(value >> 8);
+    buffer[3] = (UnsignedByte)value;
+}
+
+void QrmPng_writeChunk(QrmOutput* output, const char* type, const UnsignedByte* data, unsigned int length) {
+    UnsignedByte header[8];
+    QrmPng_write4(header, length);
+    memcpy(header + 4, type, 4);
+    Unsigned4Bytes crc = QrmCrc32(0, header + 4, 4);
+    crc = QrmCrc32(crc, data, length);
+    UnsignedByte footer[4];
+    QrmPng_write4(footer, crc);
+    QrmOutputWrite(output, header, 8);
+    QrmOutputWrite(output, data, length);
+    QrmOutputWrite(output, footer, 4);
+}
+
+// DEFLATE ==================================================================================================
+
+/// `QrmDeflateBits` flush: full buffer as IDAT chunk
+void QrmPng_writeData(void* context, const UnsignedByte* data, unsigned int length) {
+    QrmPng_writeChunk((QrmOutput*)context, "IDAT", data, length);
+}
+
+/// Match of any length (≥ 3)
+void QrmPng_matches(QrmPngWriter* writer, unsigned int length, unsigned int distance) {
+    while (length > 0) {
+        unsigned int count = length;
+        if (count > PNG_MAX_MATCH) {
+            count = length - PNG_MAX_MATCH < PNG_MIN_MATCH ? length - PNG_MIN_MATCH : PNG_MAX_MATCH;
+        }
+        QrmDeflatePutMatch(&writer->deflate, count, distance);
+        length -= count;
+    }
+}
+
+/// Encode pending repetitions of last byte
+void QrmPng_flushRun(QrmPngWriter* writer) {
+    if (writer->runLength >= PNG_MIN_MATCH) {
+        QrmDeflatePutMatch(&writer->deflate, writer->runLength, 1);
+    } else {
+        for (unsigned int index = 0; index < writer->runLength; index += 1) {
+            QrmDeflatePutSymbol(&writer->deflate, (Unsigned2Bytes)writer->lastByte);
+        }
+    }
+    writer->runLength = 0;
+}
+
+/// Encode pending repeated rows
+void QrmPng_flushRepeat(QrmPngWriter* writer) {
+    if (writer->repeatLength > 0) {
+        QrmPng_matches(writer, writer->repeatLength, writer->rowLength + 1);
+        writer->repeatLength = 0;
+    }
+}
+
+void QrmPng_compress(QrmPngWriter* writer, const UnsignedByte* data, unsigned int length) {
+    for (unsigned int index = 0; index < length; index += 1) {
+        UnsignedByte value = data[index];
+        if (value == writer->lastByte) {
+            writer->runLength += 1;
+            if (writer->runLength == PNG_MAX_MATCH) {
+                QrmPng_flushRun(writer);
+            }
+        } else {
+            QrmPng_flushRun(writer);
+            QrmDeflatePutSymbol(&writer->deflate, value);
+            writer->lastByte = value;
+        }
+    }
+}
+
+// PUBLIC ===================================================================================================
+
+QrmPngWriter QrmPngWriterCreate(QrmOutput* output, unsigned int width, unsigned int height) {
+    QrmPngWriter result;
+    memset(&result, 0, sizeof(result));
+    if (width == 0 || height == 0) {
+        LOG("ERROR: Invalid image size");
+        return result;
+    }
+    result.output = output;
+    result.height = height;
+    result.rowLength = (width + 7) / 8;
+    result.adler = 1;
+    result.lastByte = -1;
+    ALLOC_(UnsignedByte, result.previousRow, result.rowLength);
+    ALLOC_(UnsignedByte, result.filteredRow, result.rowLength + 1);
+    ALLOC_(UnsignedByte, result.chunk, PNG_CHUNK_CAPACITY);
+    if (result.previousRow == NULL || result.filteredRow == NULL || result.chunk == NULL) {
+        QrmPngWriterDestroy(&result);
+        return result;
+    }
+    // Row before first row is zeros (white pixels in PNG = bit 0 of input rows)
+    memset(result.previousRow, 0xFF, result.rowLength);
+    result.width = width;
+
+    static const UnsignedByte signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    QrmOutputWrite(output, signature, sizeof(signature));
+    UnsignedByte header[13];
+    QrmPng_write4(header, width);
+    QrmPng_write4(header + 4, height);
+    header[8] = 1;  // Bit depth
+    header[9] = 0;  // Grayscale
+    header[10] = 0; // Deflate
+    header[11] = 0; // Adaptive filtering
+    header[12] = 0; // No interlace
+    QrmPng_writeChunk(output, "IHDR", header, sizeof(header));
+    result.deflate = QrmDeflateBitsCreate(result.chunk, PNG_CHUNK_CAPACITY, QrmPng_writeData, output);
+    return result;
+}
+
+void QrmPngWriterDestroy(QrmPngWriter* writer) {
+    DEALLOC(writer->previousRow);
+    DEALLOC(writer->filteredRow);
+    DEALLOC(writer->chunk);
+    writer->width = 0;
+}
+
+bool QrmPngWriterAddRow(QrmPngWriter* writer, const UnsignedByte* row) {
+    if (writer->width == 0 || writer->row >= writer->height || writer->output->isFailed) {
+        return false;
+    }
+    // PNG pixel = inverted input bit; Up filter: ~row - ~previous = previous - row
+    UnsignedByte* filtered = writer->filteredRow;
+    UnsignedByte* previous = writer->previousRow;
+    UnsignedByte difference = 0;
+    filtered[0] = 2;
+    for (unsigned int index = 0; index < writer->rowLength; index += 1) {
+        UnsignedByte value = (UnsignedByte)(previous[index] - row[index]);
+        filtered[index + 1] = value;
+        difference |= value;
+    }
+    memcpy(previous, row, writer->rowLength);
+    writer->adler = QrmAdler32(writer->adler, filtered, writer->rowLength + 1);
+    writer->row += 1;
+
+    bool isZero = difference == 0;
+    if (isZero && writer->isPreviousRowZero && writer->rowLength + 1 >= PNG_MIN_MATCH && writer->rowLength + 1 <= PNG_MAX_DISTANCE) {
+        // Same as previous filtered row: copy it
+        QrmPng_flushRun(writer);
+        writer->repeatLength += writer->rowLength + 1;
+        writer->lastByte = 0;
+        return true;
+    }
+    QrmPng_flushRepeat(writer);
+    QrmPng_compress(writer, filtered, writer->rowLength + 1);
+    writer->isPreviousRowZero = isZero;
+    return true;
+}
+
+bool QrmPngWriterFinish(QrmPngWriter* writer) {
+    if (writer->width == 0 || writer->row != writer->height) {
+        LOG("ERROR: Missing rows");
+        return false;
+    }
+    QrmPng_flushRun(writer);
+    QrmPng_flushRepeat(writer);
+    QrmDeflateBitsFinish(&writer->deflate, writer->adler);
+    QrmPng_writeChunk(writer->output, "IEND", NULL, 0);
+    return QrmOutputFlush(writer->output);
+}
+
+bool QrmPngWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone) {
+    QrmRaster raster = QrmRasterCreate(board, scale, quietZone, Pixel1Bit, false);
+    if (raster.width == 0) {
+        return false;
+    }
+    QrmPngWriter writer = QrmPngWriterCreate(output, raster.width, raster.width);
+    bool isSuccess = writer.width > 0;
+    const UnsignedByte* row = QrmRasterNextRow(&raster);
+    while (isSuccess && row != NULL) {
+        isSuccess = QrmPngWriterAddRow(&writer, row);
+        row = QrmRasterNextRow(&raster);
+    }
+    isSuccess = isSuccess && QrmPngWriterFinish(&writer);
+    QrmPngWriterDestroy(&writer);
+    QrmRasterDestroy(&raster);
+    return isSuccess;
+}
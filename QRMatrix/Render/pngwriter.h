@@ -0,0 +1,84 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#include "renderoutput.h"
+#include "deflate.h"
+#include "../qrmatrixboard.h"
+
+/// Write 1 bit grayscale PNG image row by row.
+/// Rows are filtered with "Up" filter (so repeated rows become zeros) and compressed by a simple
+/// deflate encoder (fixed Huffman codes, repeated bytes & repeated rows matching).
+typedef struct {
+    QrmOutput* output;
+    unsigned int width;
+    unsigned int height;
+    /// Number of bytes of each input row
+    unsigned int rowLength;
+    /// Number of added rows
+    unsigned int row;
+    bool isFailed;
+    /// Last added row & filtered row (filter type byte + `rowLength` bytes)
+    UnsignedByte* previousRow;
+    UnsignedByte* filteredRow;
+    /// Buffer of `deflate`: compressed data waiting for IDAT chunk
+    UnsignedByte* chunk;
+    QrmDeflateBits deflate;
+    /// Adler32 of uncompressed data
+    Unsigned4Bytes adler;
+    /// Last uncompressed byte & number of its repetitions not encoded yet
+    int lastByte;
+    unsigned int runLength;
+    /// Number of bytes (of zero rows) not encoded yet, to be copied from previous row
+    unsigned int repeatLength;
+    /// Previous filtered row is zero (so zero row is the same as previous uncompressed row)
+    bool isPreviousRowZero;
+} QrmPngWriter;
+
+/// Start writing PNG image (signature & header are written).
+/// @return Writer (`width` = 0 if failed).
+QrmPngWriter QrmPngWriterCreate(QrmOutput* output, unsigned int width, unsigned int height);
+/// Destructor
+void QrmPngWriterDestroy(QrmPngWriter* writer);
+/// Add next row: `(width + 7) / 8` bytes, 1 bit per pixel, most significant bit first, bit 1 = black
+/// (`Pixel1Bit` format, eg. from `QrmRasterNextRow`).
+bool QrmPngWriterAddRow(QrmPngWriter* writer, const UnsignedByte* row);
+/// Finish image after all rows are added (output is flushed).
+bool QrmPngWriterFinish(QrmPngWriter* writer);
+
+/// Write PNG image of QR board (black modules on white).
+/// @return false if failed.
+bool QrmPngWrite(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Pixels per module
+    unsigned int scale,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone
+);
+
+/// CRC32 (as of PNG & zlib). Start with `crc` = 0.
+Unsigned4Bytes QrmCrc32(Unsigned4Bytes crc, const UnsignedByte* data, size_t length);
+
+#endif // PNGWRITER_H
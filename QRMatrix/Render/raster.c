@@ -0,0 +1,105 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "raster.h"
+#include <stdlib.h>
+#include <string.h>
+
+void QrmRaster_renderModuleRow(QrmRaster* raster, UnsignedByte moduleRow) {
+    UnsignedByte* row = raster->moduleRow;
+    UnsignedByte* cells = raster->board.buffer[moduleRow];
+    // Quiet zone on both sides
+    memcpy(row, raster->quietRow, raster->rowLength);
+    unsigned int column = 0;
+    while (column < raster->board.dimension) {
+        bool isDark = (cells[column] & CellLowMask) == CellSet;
+        unsigned int start = column;
+        column += 1;
+        while (column < raster->board.dimension && ((cells[column] & CellLowMask) == CellSet) == isDark) {
+            column += 1;
+        }
+        QrmPixelFill(
+            row, raster->format,
+            (raster->quietZone + start) * raster->scale, (column - start) * raster->scale,
+            QrmPixelColor(raster->format, isDark != raster->isInverted)
+        );
+    }
+    raster->renderedModuleRow = moduleRow;
+}
+
+QrmRaster QrmRasterCreate(QrmBoard board, unsigned int scale, unsigned int quietZone, QrmPixelFormat format, bool isInverted) {
+    QrmRaster result;
+    memset(&result, 0, sizeof(result));
+    if (board.dimension == 0 || scale == 0) {
+        LOG("ERROR: Invalid board or scale");
+        return result;
+    }
+    result.board = board;
+    result.scale = scale;
+    result.quietZone = quietZone;
+    result.format = format;
+    result.isInverted = isInverted;
+    result.renderedModuleRow = -1;
+    unsigned int width = (board.dimension + 2 * quietZone) * scale;
+    result.rowLength = QrmPixelRowLength(format, width);
+    ALLOC_(UnsignedByte, result.moduleRow, result.rowLength);
+    ALLOC_(UnsignedByte, result.quietRow, result.rowLength);
+    if (result.moduleRow == NULL || result.quietRow == NULL) {
+        QrmRasterDestroy(&result);
+        return result;
+    }
+    QrmPixelFill(result.quietRow, format, 0, width, QrmPixelColor(format, isInverted));
+    result.width = width;
+    return result;
+}
+
+void QrmRasterDestroy(QrmRaster* raster) {
+    DEALLOC(raster->moduleRow);
+    DEALLOC(raster->quietRow);
+    raster->width = 0;
+    raster->rowLength = 0;
+}
+
+void QrmRasterReset(QrmRaster* raster) {
+    raster->row = 0;
+    raster->isRepeated = false;
+}
+
+const UnsignedByte* QrmRasterNextRow(QrmRaster* raster) {
+    if (raster->width == 0 || raster->row >= raster->width) {
+        return NULL;
+    }
+    unsigned int moduleRow = raster->row / raster->scale;
+    unsigned int previousModuleRow = raster->row > 0 ? (raster->row - 1) / raster->scale : 0;
+    bool isQuiet = moduleRow < raster->quietZone || moduleRow >= raster->quietZone + raster->board.dimension;
+    bool isPreviousQuiet = previousModuleRow < raster->quietZone || previousModuleRow >= raster->quietZone + raster->board.dimension;
+    raster->isRepeated = raster->row > 0 && (isQuiet ? isPreviousQuiet : previousModuleRow == moduleRow);
+    raster->row += 1;
+    if (isQuiet) {
+        return raster->quietRow;
+    }
+    UnsignedByte boardRow = moduleRow - raster->quietZone;
+    if (raster->renderedModuleRow != boardRow) {
+        QrmRaster_renderModuleRow(raster, boardRow);
+    }
+    return raster->moduleRow;
+}
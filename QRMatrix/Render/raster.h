@@ -0,0 +1,75 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include "pixel.h"
+#include "../qrmatrixboard.h"
+
+/// Generate image of QR board row by row (memory usage: some rows).
+typedef struct {
+    QrmBoard board;
+    unsigned int scale;
+    unsigned int quietZone;
+    QrmPixelFormat format;
+    /// Swap dark & light
+    bool isInverted;
+    /// Image width (= height) in pixels
+    unsigned int width;
+    /// Number of bytes of each row
+    unsigned int rowLength;
+    /// Index of next row
+    unsigned int row;
+    /// Last returned row has the same pixels as the row before it (same pointer is returned).
+    bool isRepeated;
+    /// Pixels of current module row
+    UnsignedByte* moduleRow;
+    /// Pixels of quiet zone row
+    UnsignedByte* quietRow;
+    /// Module row in `moduleRow` (-1 = none)
+    int renderedModuleRow;
+} QrmRaster;
+
+/// Constructor. Board must be kept until raster is destroyed.
+/// @return Raster (`width` = 0 if failed).
+QrmRaster QrmRasterCreate(
+    QrmBoard board,
+    /// Pixels per module
+    unsigned int scale,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone,
+    /// Colors: `QrmPixelColor`
+    QrmPixelFormat format,
+    /// Dark modules are light & vice versa
+    bool isInverted
+);
+/// Destructor
+void QrmRasterDestroy(QrmRaster* raster);
+/// Get next row of image.
+/// Scaled rows of the same module row (and quiet zone rows) are returned by reference (same pointer, `isRepeated` = true).
+/// @return Pixels of `rowLength` bytes (valid until next call or destroy) or NULL if there's no more row.
+const UnsignedByte* QrmRasterNextRow(QrmRaster* raster);
+/// Restart from first row
+void QrmRasterReset(QrmRaster* raster);
+
+#endif // RASTER_H
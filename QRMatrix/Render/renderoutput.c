@@ -0,0 +1,150 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "renderoutput.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define OUTPUT_DEFAULT_CAPACITY 4096
+
+QrmOutput QrmOutput_createEmpty(void) {
+    QrmOutput result;
+    memset(&result, 0, sizeof(result));
+    return result;
+}
+
+/// Make room for `length` more bytes
+bool QrmOutput_reserve(QrmOutput* output, size_t length) {
+    if (output->length + length <= output->capacity) {
+        return true;
+    }
+    size_t capacity = output->capacity > 0 ? output->capacity : OUTPUT_DEFAULT_CAPACITY;
+    while (capacity < output->length + length) {
+        capacity *= 2;
+    }
+    UnsignedByte* buffer = QrmRealloc(output->buffer, capacity);
+    if (buffer == NULL) {
+        LOG("ERROR: Out of memory");
+        output->isFailed = true;
+        return false;
+    }
+    output->buffer = buffer;
+    output->capacity = capacity;
+    return true;
+}
+
+QrmOutput QrmOutputCreateBuffer(size_t capacity) {
+    QrmOutput result = QrmOutput_createEmpty();
+    QrmOutput_reserve(&result, capacity > 0 ? capacity : OUTPUT_DEFAULT_CAPACITY);
+    return result;
+}
+
+QrmOutput QrmOutputCreateCallback(QrmWriteCallback callback, void* context) {
+    QrmOutput result = QrmOutput_createEmpty();
+    result.callback = callback;
+    result.context = context;
+    QrmOutput_reserve(&result, OUTPUT_DEFAULT_CAPACITY);
+    return result;
+}
+
+void QrmOutputDestroy(QrmOutput* output) {
+    DEALLOC(output->buffer);
+    *output = QrmOutput_createEmpty();
+}
+
+void QrmOutputReset(QrmOutput* output) {
+    output->length = 0;
+    output->isFailed = false;
+}
+
+bool QrmOutputFlush(QrmOutput* output) {
+    if (output->callback == NULL || output->isFailed) {
+        return !output->isFailed;
+    }
+    if (output->length > 0) {
+        if (!output->callback(output->context, output->buffer, output->length)) {
+            output->isFailed = true;
+        }
+        output->length = 0;
+    }
+    return !output->isFailed;
+}
+
+bool QrmOutputWrite(QrmOutput* output, const void* data, size_t length) {
+    if (output->isFailed) {
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+    if (output->callback != NULL && output->length + length > output->capacity) {
+        if (!QrmOutputFlush(output)) {
+            return false;
+        }
+        if (length > output->capacity) {
+            // Big chunk: pass directly
+            if (!output->callback(output->context, data, length)) {
+                output->isFailed = true;
+            }
+            return !output->isFailed;
+        }
+    }
+    if (!QrmOutput_reserve(output, length)) {
+        return false;
+    }
+    memcpy(output->buffer + output->length, data, length);
+    output->length += length;
+    return true;
+}
+
+bool QrmOutputWriteString(QrmOutput* output, const char* text) {
+    return QrmOutputWrite(output, text, strlen(text));
+}
+
+bool QrmOutputWriteUnsigned(QrmOutput* output, unsigned long value) {
+    char digits[24];
+    unsigned int index = sizeof(digits);
+    do {
+        index -= 1;
+        digits[index] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return QrmOutputWrite(output, digits + index, sizeof(digits) - index);
+}
+
+bool QrmOutputWriteDecimal(QrmOutput* output, double value) {
+    unsigned long thousandths = (unsigned long)((value < 0 ? -value : value) * 1000 + 0.5);
+    if (value < 0 && thousandths > 0) {
+        QrmOutputWrite(output, "-", 1);
+    }
+    QrmOutputWriteUnsigned(output, thousandths / 1000);
+    unsigned long fraction = thousandths % 1000;
+    if (fraction == 0) {
+        return !output->isFailed;
+    }
+    char digits[4] = { '.', (char)('0' + fraction / 100), (char)('0' + fraction / 10 % 10), (char)('0' + fraction % 10) };
+    unsigned int length = 4;
+    while (digits[length - 1] == '0') {
+        length -= 1;
+    }
+    return QrmOutputWrite(output, digits, length);
+}
@@ -0,0 +1,70 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef RENDEROUTPUT_H
+#define RENDEROUTPUT_H
+
+#include <stddef.h>
+#include "../constants.h"
+
+/// Receive output bytes.
+/// @return false to stop writing.
+typedef bool (*QrmWriteCallback)(
+    /// User context passed to `QrmOutputCreateCallback`
+    void* context,
+    const UnsignedByte* data,
+    size_t length
+);
+
+/// Destination of renderers: growable memory buffer or write callback.
+typedef struct {
+    /// Memory output: result bytes. Callback output: pending bytes (not passed to callback yet).
+    UnsignedByte* buffer;
+    size_t length;
+    size_t capacity;
+    /// NULL for memory output
+    QrmWriteCallback callback;
+    void* context;
+    /// Out of memory or callback returned false. Later writes are ignored.
+    bool isFailed;
+} QrmOutput;
+
+/// Memory output. `capacity` is initial capacity (0 = default); buffer grows as needed.
+QrmOutput QrmOutputCreateBuffer(size_t capacity);
+/// Callback output. Bytes are buffered and passed to callback in chunks (call `QrmOutputFlush` at the end).
+QrmOutput QrmOutputCreateCallback(QrmWriteCallback callback, void* context);
+/// Destructor
+void QrmOutputDestroy(QrmOutput* output);
+/// Memory output: clear content (keep capacity).
+void QrmOutputReset(QrmOutput* output);
+/// Append bytes
+bool QrmOutputWrite(QrmOutput* output, const void* data, size_t length);
+/// Append C string (without terminating 0)
+bool QrmOutputWriteString(QrmOutput* output, const char* text);
+/// Append decimal number
+bool QrmOutputWriteUnsigned(QrmOutput* output, unsigned long value);
+/// Append decimal number with up to 3 fraction digits (trailing zeros are omitted; no locale)
+bool QrmOutputWriteDecimal(QrmOutput* output, double value);
+/// Callback output: pass pending bytes to callback. Memory output: no effect.
+bool QrmOutputFlush(QrmOutput* output);
+
+#endif // RENDEROUTPUT_H
@@ -0,0 +1,394 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "sheet.h"
+#include "pixel.h"
+#include "pngwriter.h"
+#include "pbmwriter.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SHEET_DEFAULT_BAND_HEIGHT 64
+
+/// Boards of cells: array or provider
+typedef struct {
+    QrmBoard* boards;
+    QrmSheetBoardProvider provider;
+    void* context;
+    unsigned int count;
+} QrmSheet_Source;
+
+/// Context of band rendering tasks
+typedef struct {
+    QrmSheetLayout layout;
+    /// Boards of cells from index `boardOffset`
+    QrmBoard* boards;
+    unsigned int boardOffset;
+    /// Cells after this index are empty
+    unsigned int count;
+    unsigned int bandHeight;
+    unsigned int rowLength;
+    /// Buffer of each task
+    UnsignedByte** bands;
+    /// Band of first task
+    unsigned int firstBand;
+} QrmSheet_Job;
+
+QrmSheetLayout QrmSheetLayoutCreate(
+    unsigned int width,
+    unsigned int height,
+    unsigned int margin,
+    unsigned int columns,
+    unsigned int rows,
+    unsigned int scale
+) {
+    QrmSheetLayout result;
+    result.width = width;
+    result.height = height;
+    result.marginLeft = margin;
+    result.marginTop = margin;
+    result.columns = columns;
+    result.rows = rows;
+    result.cellWidth = columns > 0 && width > 2 * margin ? (width - 2 * margin) / columns : 0;
+    result.cellHeight = rows > 0 && height > 2 * margin ? (height - 2 * margin) / rows : 0;
+    result.scale = scale;
+    return result;
+}
+
+unsigned int QrmSheet_offset(unsigned int cellSize, unsigned int symbolSize) {
+    return symbolSize < cellSize ? (cellSize - symbolSize) / 2 : 0;
+}
+
+/// Draw pixel row `y` (of page) of symbol at (`left`, `top`), `visibleWidth` pixels
+void QrmSheet_drawSymbolRow(UnsignedByte* line, QrmBoard board, QrmSheetLayout layout, unsigned int left, unsigned int top, unsigned int y, unsigned int visibleWidth) {
+    UnsignedByte* cells = board.buffer[(y - top) / layout.scale];
+    UnsignedByte column = 0;
+    while (column < board.dimension) {
+        if ((cells[column] & CellLowMask) != CellSet) {
+            column += 1;
+            continue;
+        }
+        UnsignedByte start = column;
+        while (column < board.dimension && (cells[column] & CellLowMask) == CellSet) {
+            column += 1;
+        }
+        unsigned int x = start * layout.scale;
+        if (x >= visibleWidth) {
+            break;
+        }
+        unsigned int count = (column - start) * layout.scale;
+        if (count > visibleWidth - x) {
+            count = visibleWidth - x;
+        }
+        QrmPixelFill(line, Pixel1Bit, left + x, count, 1);
+    }
+}
+
+void QrmSheet_renderBand(void* context, unsigned int index) {
+    QrmSheet_Job* job = context;
+    QrmSheetLayout layout = job->layout;
+    UnsignedByte* band = job->bands[index];
+    unsigned int bandTop = (job->firstBand + index) * job->bandHeight;
+    unsigned int bandBottom = bandTop + job->bandHeight;
+    if (bandBottom > layout.height) {
+        bandBottom = layout.height;
+    }
+    memset(band, 0, (size_t)job->rowLength * job->bandHeight);
+    if (bandTop >= bandBottom || bandBottom <= layout.marginTop || layout.cellHeight == 0 || layout.cellWidth == 0) {
+        return;
+    }
+    // Grid rows intersecting this band
+    unsigned int firstRow = bandTop > layout.marginTop ? (bandTop - layout.marginTop) / layout.cellHeight : 0;
+    unsigned int lastRow = (bandBottom - 1 - layout.marginTop) / layout.cellHeight;
+    if (lastRow >= layout.rows) {
+        lastRow = layout.rows - 1;
+    }
+    for (unsigned int row = firstRow; row <= lastRow && row < layout.rows; row += 1) {
+        for (unsigned int column = 0; column < layout.columns; column += 1) {
+            unsigned int boardIndex = row * layout.columns + column;
+            if (boardIndex >= job->count) {
+                return;
+            }
+            QrmBoard board = job->boards[boardIndex - job->boardOffset];
+            if (board.dimension == 0 || board.buffer == NULL) {
+                continue;
+            }
+            unsigned int size = board.dimension * layout.scale;
+            unsigned int cellLeft = layout.marginLeft + column * layout.cellWidth;
+            unsigned int cellTop = layout.marginTop + row * layout.cellHeight;
+            unsigned int left = cellLeft + QrmSheet_offset(layout.cellWidth, size);
+            unsigned int top = cellTop + QrmSheet_offset(layout.cellHeight, size);
+            // Clip to cell & page
+            unsigned int right = cellLeft + layout.cellWidth < layout.width ? cellLeft + layout.cellWidth : layout.width;
+            unsigned int bottom = cellTop + layout.cellHeight < bandBottom ? cellTop + layout.cellHeight : bandBottom;
+            if (left >= right) {
+                continue;
+            }
+            unsigned int visibleWidth = size < right - left ? size : right - left;
+            unsigned int first = top > bandTop ? top : bandTop;
+            unsigned int last = top + size < bottom ? top + size : bottom;
+            for (unsigned int y = first; y < last; y += 1) {
+                UnsignedByte* line = band + (size_t)(y - bandTop) * job->rowLength;
+                if (y > first && (y - top) % layout.scale != 0) {
+                    // Same module row as previous pixel row
+                    QrmPixelCopy(line, line - job->rowLength, Pixel1Bit, left, visibleWidth);
+                } else {
+                    QrmSheet_drawSymbolRow(line, board, layout, left, top, y, visibleWidth);
+                }
+            }
+        }
+    }
+}
+
+/// Boards of provider for grid rows intersecting current bands
+typedef struct {
+    QrmSheet_Source source;
+    unsigned int columns;
+    QrmBoard* boards;
+    /// Grid rows in `boards`
+    unsigned int capacity;
+    unsigned int firstRow;
+    unsigned int endRow;
+} QrmSheet_Window;
+
+void QrmSheet_destroyWindowRows(QrmSheet_Window* window, unsigned int count) {
+    for (unsigned int index = 0; index < count * window->columns; index += 1) {
+        QrmBoardDestroy(&window->boards[index]);
+    }
+}
+
+QrmBoard QrmSheet_requestBoard(QrmSheet_Window* window, unsigned int row, unsigned int column) {
+    unsigned int index = row * window->columns + column;
+    return index < window->source.count ? window->source.provider(window->source.context, index) : QrmBoardCreateEmpty();
+}
+
+/// Keep boards of grid rows `first...last` only (every cell is requested once, in order)
+void QrmSheet_moveWindow(QrmSheet_Window* window, unsigned int first, unsigned int last) {
+    unsigned int dropped = (first < window->endRow ? first : window->endRow) - window->firstRow;
+    if (dropped > 0) {
+        QrmSheet_destroyWindowRows(window, dropped);
+        memmove(window->boards, window->boards + (size_t)dropped * window->columns,
+                (size_t)(window->endRow - window->firstRow - dropped) * window->columns * sizeof(QrmBoard));
+        window->firstRow += dropped;
+    }
+    // Rows which are not drawn (not expected as bands are contiguous)
+    for (; window->endRow < first; window->endRow += 1) {
+        for (unsigned int column = 0; column < window->columns; column += 1) {
+            QrmBoard board = QrmSheet_requestBoard(window, window->endRow, column);
+            QrmBoardDestroy(&board);
+        }
+        window->firstRow = window->endRow + 1;
+    }
+    for (; window->endRow <= last; window->endRow += 1) {
+        QrmBoard* boards = window->boards + (size_t)(window->endRow - window->firstRow) * window->columns;
+        for (unsigned int column = 0; column < window->columns; column += 1) {
+            boards[column] = QrmSheet_requestBoard(window, window->endRow, column);
+        }
+    }
+}
+
+bool QrmSheet_render(
+    QrmSheetLayout layout,
+    QrmSheet_Source source,
+    unsigned int bandHeight,
+    QrmThreadPool pool,
+    QrmSheetRowWriter writer,
+    void* context
+) {
+    if (layout.width == 0 || layout.height == 0 || layout.scale == 0) {
+        LOG("ERROR: Invalid sheet layout");
+        return false;
+    }
+    QrmSheet_Job job;
+    job.layout = layout;
+    job.boards = source.boards;
+    job.boardOffset = 0;
+    job.count = source.count;
+    job.bandHeight = bandHeight > 0 ? bandHeight : SHEET_DEFAULT_BAND_HEIGHT;
+    job.rowLength = QrmPixelRowLength(Pixel1Bit, layout.width);
+    job.firstBand = 0;
+    unsigned int bandCount = (layout.height + job.bandHeight - 1) / job.bandHeight;
+    // Render (threads + 1) bands at a time
+    unsigned int parallelCount = pool.threadCount + 1;
+    if (parallelCount > bandCount) {
+        parallelCount = bandCount;
+    }
+    bool isStream = source.provider != NULL && layout.columns > 0 && layout.cellHeight > 0;
+    QrmSheet_Window window;
+    memset(&window, 0, sizeof(window));
+    if (isStream) {
+        window.source = source;
+        window.columns = layout.columns;
+        // Grid rows intersecting `parallelCount` bands
+        window.capacity = ((size_t)parallelCount * job.bandHeight + layout.cellHeight - 1) / layout.cellHeight + 1;
+        ALLOC_(QrmBoard, window.boards, (size_t)window.capacity * window.columns);
+        if (window.boards == NULL) {
+            return false;
+        }
+        job.boards = window.boards;
+    } else if (source.boards == NULL) {
+        job.count = 0;
+    }
+    ALLOC_(UnsignedByte*, job.bands, parallelCount);
+    bool isSuccess = job.bands != NULL;
+    for (unsigned int index = 0; index < parallelCount && isSuccess; index += 1) {
+        ALLOC_(UnsignedByte, job.bands[index], (size_t)job.rowLength * job.bandHeight);
+        if (job.bands[index] == NULL) {
+            isSuccess = false;
+        }
+    }
+    while (isSuccess && job.firstBand < bandCount) {
+        unsigned int taskCount = bandCount - job.firstBand < parallelCount ? bandCount - job.firstBand : parallelCount;
+        if (isStream) {
+            unsigned int top = job.firstBand * job.bandHeight;
+            unsigned int bottom = top + taskCount * job.bandHeight;
+            bottom = bottom < layout.height ? bottom : layout.height;
+            if (bottom > layout.marginTop) {
+                unsigned int first = top > layout.marginTop ? (top - layout.marginTop) / layout.cellHeight : 0;
+                unsigned int last = (bottom - 1 - layout.marginTop) / layout.cellHeight;
+                last = last < layout.rows ? last : layout.rows - 1;
+                if (first < layout.rows) {
+                    QrmSheet_moveWindow(&window, first, last);
+                }
+            }
+            job.boardOffset = window.firstRow * window.columns;
+            unsigned int loadedCount = window.endRow * window.columns;
+            job.count = loadedCount < source.count ? loadedCount : source.count;
+        }
+        QrmThreadPoolRun(pool, QrmSheet_renderBand, &job, taskCount);
+        for (unsigned int index = 0; index < taskCount && isSuccess; index += 1) {
+            unsigned int top = (job.firstBand + index) * job.bandHeight;
+            for (unsigned int row = 0; row < job.bandHeight && top + row < layout.height; row += 1) {
+                if (!writer(context, job.bands[index] + (size_t)row * job.rowLength)) {
+                    isSuccess = false;
+                    break;
+                }
+            }
+        }
+        job.firstBand += taskCount;
+    }
+    if (job.bands != NULL) {
+        for (unsigned int index = 0; index < parallelCount; index += 1) {
+            DEALLOC(job.bands[index]);
+        }
+        DEALLOC(job.bands);
+    }
+    if (isStream) {
+        QrmSheet_destroyWindowRows(&window, window.endRow - window.firstRow);
+        DEALLOC(window.boards);
+    }
+    return isSuccess;
+}
+
+QrmSheet_Source QrmSheet_arraySource(QrmBoard* boards, unsigned int count) {
+    QrmSheet_Source result = { boards, NULL, NULL, count };
+    return result;
+}
+
+QrmSheet_Source QrmSheet_providerSource(QrmSheetBoardProvider provider, void* context, unsigned int count) {
+    QrmSheet_Source result = { NULL, provider, context, count };
+    return result;
+}
+
+bool QrmSheetRender(
+    QrmSheetLayout layout,
+    QrmBoard* boards,
+    unsigned int count,
+    unsigned int bandHeight,
+    QrmThreadPool pool,
+    QrmSheetRowWriter writer,
+    void* context
+) {
+    return QrmSheet_render(layout, QrmSheet_arraySource(boards, count), bandHeight, pool, writer, context);
+}
+
+bool QrmSheetRenderStream(
+    QrmSheetLayout layout,
+    QrmSheetBoardProvider provider,
+    void* providerContext,
+    unsigned int count,
+    unsigned int bandHeight,
+    QrmThreadPool pool,
+    QrmSheetRowWriter writer,
+    void* context
+) {
+    if (provider == NULL) {
+        LOG("ERROR: No board provider");
+        return false;
+    }
+    return QrmSheet_render(layout, QrmSheet_providerSource(provider, providerContext, count), bandHeight, pool, writer, context);
+}
+
+bool QrmSheet_writePngRow(void* context, const UnsignedByte* row) {
+    return QrmPngWriterAddRow((QrmPngWriter*)context, row);
+}
+
+bool QrmSheet_writePng(QrmOutput* output, QrmSheetLayout layout, QrmSheet_Source source, QrmThreadPool pool) {
+    QrmPngWriter writer = QrmPngWriterCreate(output, layout.width, layout.height);
+    if (writer.width == 0) {
+        return false;
+    }
+    bool isSuccess = QrmSheet_render(layout, source, 0, pool, QrmSheet_writePngRow, &writer) &&
+        QrmPngWriterFinish(&writer);
+    QrmPngWriterDestroy(&writer);
+    return isSuccess;
+}
+
+bool QrmSheetWritePng(QrmOutput* output, QrmSheetLayout layout, QrmBoard* boards, unsigned int count, QrmThreadPool pool) {
+    return QrmSheet_writePng(output, layout, QrmSheet_arraySource(boards, count), pool);
+}
+
+bool QrmSheetWritePngStream(QrmOutput* output, QrmSheetLayout layout, QrmSheetBoardProvider provider, void* providerContext, unsigned int count, QrmThreadPool pool) {
+    if (provider == NULL) {
+        return false;
+    }
+    return QrmSheet_writePng(output, layout, QrmSheet_providerSource(provider, providerContext, count), pool);
+}
+
+/// Context of PBM rows
+typedef struct {
+    QrmOutput* output;
+    unsigned int rowLength;
+} QrmSheet_PbmContext;
+
+bool QrmSheet_writePbmRow(void* context, const UnsignedByte* row) {
+    QrmSheet_PbmContext* pbm = context;
+    return QrmOutputWrite(pbm->output, row, pbm->rowLength);
+}
+
+bool QrmSheet_writePbm(QrmOutput* output, QrmSheetLayout layout, QrmSheet_Source source, QrmThreadPool pool) {
+    QrmSheet_PbmContext context = { output, QrmPixelRowLength(Pixel1Bit, layout.width) };
+    QrmPbmWriteHeader(output, layout.width, layout.height);
+    return QrmSheet_render(layout, source, 0, pool, QrmSheet_writePbmRow, &context) &&
+        QrmOutputFlush(output);
+}
+
+bool QrmSheetWritePbm(QrmOutput* output, QrmSheetLayout layout, QrmBoard* boards, unsigned int count, QrmThreadPool pool) {
+    return QrmSheet_writePbm(output, layout, QrmSheet_arraySource(boards, count), pool);
+}
+
+bool QrmSheetWritePbmStream(QrmOutput* output, QrmSheetLayout layout, QrmSheetBoardProvider provider, void* providerContext, unsigned int count, QrmThreadPool pool) {
+    if (provider == NULL) {
+        return false;
+    }
+    return QrmSheet_writePbm(output, layout, QrmSheet_providerSource(provider, providerContext, count), pool);
+}
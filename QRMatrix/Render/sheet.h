@@ -0,0 +1,106 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SHEET_H
+#define SHEET_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+#include "../ThreadPool/threadpool.h"
+
+/// Grid of symbols on a page (unit: pixel).
+/// Each symbol is centered in its cell (or placed at top left of cell & clipped if it is bigger than cell).
+typedef struct {
+    /// Page size
+    unsigned int width;
+    unsigned int height;
+    /// Position of first cell
+    unsigned int marginLeft;
+    unsigned int marginTop;
+    /// Number of cells
+    unsigned int columns;
+    unsigned int rows;
+    /// Cell size
+    unsigned int cellWidth;
+    unsigned int cellHeight;
+    /// Pixels per module
+    unsigned int scale;
+} QrmSheetLayout;
+
+/// Layout of `columns` x `rows` equal cells inside page margin.
+QrmSheetLayout QrmSheetLayoutCreate(
+    unsigned int width,
+    unsigned int height,
+    unsigned int margin,
+    unsigned int columns,
+    unsigned int rows,
+    unsigned int scale
+);
+
+/// Receive next row of page: `(width + 7) / 8` bytes, `Pixel1Bit` format (bit 1 = black).
+/// @return false to stop.
+typedef bool (*QrmSheetRowWriter)(void* context, const UnsignedByte* row);
+
+/// Board of cell `index` (left to right, top to bottom) for `QrmSheetRenderStream`.
+/// Called on the thread which renders, in order of cells, once per cell.
+/// Sheet destroys the board when bands below it are rendered. Empty board = empty cell.
+typedef QrmBoard (*QrmSheetBoardProvider)(void* context, unsigned int index);
+
+/// Render page in horizontal bands & pass rows to `writer` from top to bottom.
+/// Memory usage is some bands, not the whole page.
+/// @return false if failed or stopped by writer.
+bool QrmSheetRender(
+    QrmSheetLayout layout,
+    /// Boards of cells (left to right, top to bottom). Empty board = empty cell.
+    /// Boards after `columns * rows` are ignored.
+    QrmBoard* boards,
+    unsigned int count,
+    /// Number of pixel rows of each band (0 = default)
+    unsigned int bandHeight,
+    /// Bands are rendered in parallel on this pool (empty pool: on calling thread).
+    QrmThreadPool pool,
+    QrmSheetRowWriter writer,
+    void* context
+);
+
+/// Same as `QrmSheetRender` but boards are requested from `provider` while rendering:
+/// only boards of grid rows intersecting the bands being rendered are kept in memory.
+bool QrmSheetRenderStream(
+    QrmSheetLayout layout,
+    QrmSheetBoardProvider provider,
+    void* providerContext,
+    /// Number of cells to request (cells after are empty)
+    unsigned int count,
+    unsigned int bandHeight,
+    QrmThreadPool pool,
+    QrmSheetRowWriter writer,
+    void* context
+);
+
+/// Render page as 1 bit PNG image
+bool QrmSheetWritePng(QrmOutput* output, QrmSheetLayout layout, QrmBoard* boards, unsigned int count, QrmThreadPool pool);
+bool QrmSheetWritePngStream(QrmOutput* output, QrmSheetLayout layout, QrmSheetBoardProvider provider, void* providerContext, unsigned int count, QrmThreadPool pool);
+/// Render page as PBM image
+bool QrmSheetWritePbm(QrmOutput* output, QrmSheetLayout layout, QrmBoard* boards, unsigned int count, QrmThreadPool pool);
+bool QrmSheetWritePbmStream(QrmOutput* output, QrmSheetLayout layout, QrmSheetBoardProvider provider, void* providerContext, unsigned int count, QrmThreadPool pool);
+
+#endif // SHEET_H
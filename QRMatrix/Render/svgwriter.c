@@ -0,0 +1,163 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "svgwriter.h"
+#include <string.h>
+
+QrmSvgStyle QrmSvgStyleCreate(const char* backgroundColor, const char* foregroundColor) {
+    QrmSvgStyle result;
+    result.backgroundColor = backgroundColor;
+    for (UnsignedByte index = 0; index < SVG_CATEGORY_COUNT; index += 1) {
+        result.colors[index] = foregroundColor;
+    }
+    return result;
+}
+
+QrmSvgStyle QrmSvgStyleCreateDetail(
+    const char* backgroundColor,
+    const char* dataColor,
+    const char* finderColor,
+    const char* timingColor,
+    const char* darkColor,
+    const char* aligmentColor,
+    const char* versionColor,
+    const char* formatColor,
+    const char* ecColor,
+    const char* remainderColor
+) {
+    QrmSvgStyle result = QrmSvgStyleCreate(backgroundColor, NULL);
+    result.colors[0] = dataColor;
+    result.colors[CellFinder >> 4] = finderColor;
+    result.colors[CellTiming >> 4] = timingColor;
+    result.colors[CellDark >> 4] = darkColor;
+    result.colors[CellAlignment >> 4] = aligmentColor;
+    result.colors[CellVersion >> 4] = versionColor;
+    result.colors[CellFormat >> 4] = formatColor;
+    result.colors[CellErrorCorrection >> 4] = ecColor;
+    result.colors[CellRemainder >> 4] = remainderColor;
+    return result;
+}
+
+/// Path group of dark cell (-1: not drawn)
+int QrmSvg_group(UnsignedByte cell, const int* groups) {
+    if ((cell & CellLowMask) != CellSet) {
+        return -1;
+    }
+    UnsignedByte category = cell >> 4;
+    return category < SVG_CATEGORY_COUNT ? groups[category] : -1;
+}
+
+void QrmSvg_writeRun(QrmOutput* path, unsigned int x, unsigned int y, unsigned int width) {
+    QrmOutputWrite(path, "M", 1);
+    QrmOutputWriteUnsigned(path, x);
+    QrmOutputWrite(path, " ", 1);
+    QrmOutputWriteUnsigned(path, y);
+    QrmOutputWrite(path, "h", 1);
+    QrmOutputWriteUnsigned(path, width);
+    QrmOutputWrite(path, "v1h-", 4);
+    QrmOutputWriteUnsigned(path, width);
+    QrmOutputWrite(path, "z", 1);
+}
+
+bool QrmSvgWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone, QrmSvgStyle style) {
+    if (scale < 1 || board.dimension == 0) {
+        LOG("ERROR: Invalid board or scale");
+        return false;
+    }
+    // Categories having same color share 1 group (group id = first category of that color)
+    int groups[SVG_CATEGORY_COUNT];
+    for (UnsignedByte index = 0; index < SVG_CATEGORY_COUNT; index += 1) {
+        groups[index] = -1;
+        if (style.colors[index] == NULL) {
+            continue;
+        }
+        groups[index] = index;
+        for (UnsignedByte other = 0; other < index; other += 1) {
+            if (style.colors[other] != NULL && strcmp(style.colors[other], style.colors[index]) == 0) {
+                groups[index] = other;
+                break;
+            }
+        }
+    }
+    QrmOutput paths[SVG_CATEGORY_COUNT];
+    for (UnsignedByte index = 0; index < SVG_CATEGORY_COUNT; index += 1) {
+        memset(&paths[index], 0, sizeof(QrmOutput));
+        if (groups[index] == index) {
+            paths[index] = QrmOutputCreateBuffer(0);
+        }
+    }
+
+    // Classify all cells in 1 pass
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        UnsignedByte* line = board.buffer[row];
+        unsigned int column = 0;
+        while (column < board.dimension) {
+            int group = QrmSvg_group(line[column], groups);
+            if (group < 0) {
+                column += 1;
+                continue;
+            }
+            unsigned int start = column;
+            column += 1;
+            while (column < board.dimension && QrmSvg_group(line[column], groups) == group) {
+                column += 1;
+            }
+            QrmSvg_writeRun(&paths[group], quietZone + start, quietZone + row, column - start);
+        }
+    }
+
+    unsigned int cells = board.dimension + 2 * quietZone;
+    unsigned int dimension = cells * scale;
+    QrmOutputWriteString(output, "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"");
+    QrmOutputWriteUnsigned(output, dimension);
+    QrmOutputWriteString(output, "\" height=\"");
+    QrmOutputWriteUnsigned(output, dimension);
+    QrmOutputWriteString(output, "\" viewBox=\"0 0 ");
+    QrmOutputWriteUnsigned(output, cells);
+    QrmOutputWrite(output, " ", 1);
+    QrmOutputWriteUnsigned(output, cells);
+    QrmOutputWriteString(output, "\" shape-rendering=\"crispEdges\">\n");
+    if (style.backgroundColor != NULL) {
+        QrmOutputWriteString(output, "<rect fill=\"");
+        QrmOutputWriteString(output, style.backgroundColor);
+        QrmOutputWriteString(output, "\" width=\"");
+        QrmOutputWriteUnsigned(output, cells);
+        QrmOutputWriteString(output, "\" height=\"");
+        QrmOutputWriteUnsigned(output, cells);
+        QrmOutputWriteString(output, "\"/>\n");
+    }
+    bool isSuccess = true;
+    for (UnsignedByte index = 0; index < SVG_CATEGORY_COUNT; index += 1) {
+        if (paths[index].isFailed) {
+            isSuccess = false;
+        } else if (groups[index] == index && paths[index].length > 0) {
+            QrmOutputWriteString(output, "<path fill=\"");
+            QrmOutputWriteString(output, style.colors[index]);
+            QrmOutputWriteString(output, "\" d=\"");
+            QrmOutputWrite(output, paths[index].buffer, paths[index].length);
+            QrmOutputWriteString(output, "\"/>\n");
+        }
+        QrmOutputDestroy(&paths[index]);
+    }
+    QrmOutputWriteString(output, "</svg>\n");
+    return QrmOutputFlush(output) && isSuccess;
+}
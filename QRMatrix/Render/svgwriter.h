@@ -0,0 +1,72 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SVGWRITER_H
+#define SVGWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Number of cell categories (data cell + function cell types, indexed by `cell >> 4`)
+#define SVG_CATEGORY_COUNT 10
+
+/// Colors of SVG (any SVG color value, eg. "black", "#FF0000").
+typedef struct {
+    /// Background (quiet zone & light modules). NULL = transparent.
+    const char* backgroundColor;
+    /// Color of dark modules of each category, indexed by `(cell & CellHighMask) >> 4`
+    /// (0: data, CellFinder >> 4: finder, ... CellRemainder >> 4: remainder). NULL = not drawn.
+    const char* colors[SVG_CATEGORY_COUNT];
+} QrmSvgStyle;
+
+/// Style with all dark modules in the same color.
+QrmSvgStyle QrmSvgStyleCreate(const char* backgroundColor, const char* foregroundColor);
+/// Style with color per cell category.
+QrmSvgStyle QrmSvgStyleCreateDetail(
+    const char* backgroundColor,
+    const char* dataColor,
+    const char* finderColor,
+    const char* timingColor,
+    const char* darkColor,
+    const char* aligmentColor,
+    const char* versionColor,
+    const char* formatColor,
+    const char* ecColor,
+    const char* remainderColor
+);
+
+/// Write SVG of QR board.
+/// Horizontal runs of dark modules are merged, and there's 1 `<path>` per color
+/// (categories having the same color are merged). Same input always makes same output.
+/// @return false if failed (callback output is flushed at the end).
+bool QrmSvgWrite(
+    QrmOutput* output,
+    /// QR Matrix to draw
+    QrmBoard board,
+    /// How many pixels per QR cell
+    unsigned int scale,
+    /// Number of quiet zone cells around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone,
+    QrmSvgStyle style
+);
+
+#endif // SVGWRITER_H
@@ -0,0 +1,133 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "textwriter.h"
+
+/// Block characters of 2 x 2 modules; index bits: 1 = top left, 2 = top right, 4 = bottom left, 8 = bottom right
+static const char* qrmTextBlocks[] = {
+    " ", "▘", "▝", "▀", "▖", "▌", "▞", "▛", "▗", "▚", "▐", "▜", "▄", "▙", "▟", "█"
+};
+
+/// Module at (`x`, `y`) (quiet zone included) is drawn
+bool QrmText_isDrawn(QrmBoard board, unsigned int quietZone, bool isInverted, unsigned int x, unsigned int y) {
+    bool isDark = x >= quietZone && y >= quietZone && x - quietZone < board.dimension && y - quietZone < board.dimension &&
+        (board.buffer[y - quietZone][x - quietZone] & CellLowMask) == CellSet;
+    return isDark != isInverted;
+}
+
+void QrmText_writeBlocks(QrmOutput* output, QrmBoard board, unsigned int quietZone, bool isInverted, bool isQuadrant) {
+    unsigned int size = board.dimension + 2 * quietZone;
+    unsigned int columnStep = isQuadrant ? 2 : 1;
+    for (unsigned int y = 0; y < size; y += 2) {
+        for (unsigned int x = 0; x < size; x += columnStep) {
+            unsigned int index = 0;
+            for (unsigned int dx = 0; dx < 2; dx += 1) {
+                unsigned int column = isQuadrant ? x + dx : x;
+                if (column >= size) {
+                    break;
+                }
+                if (QrmText_isDrawn(board, quietZone, isInverted, column, y)) {
+                    index |= 1 << dx;
+                }
+                if (y + 1 < size && QrmText_isDrawn(board, quietZone, isInverted, column, y + 1)) {
+                    index |= 4 << dx;
+                }
+            }
+            if (!isQuadrant) {
+                // Both halves of character are the same module
+                index = (index & 0x05) * 3;
+            }
+            QrmOutputWriteString(output, qrmTextBlocks[index]);
+        }
+        QrmOutputWrite(output, "\n", 1);
+    }
+}
+
+/// Write index as `printf("%02d")` does (3 digits from 100)
+void QrmText_writeIndex(QrmOutput* output, UnsignedByte index) {
+    char digits[3] = { (char)('0' + index / 100), (char)('0' + index / 10 % 10), (char)('0' + index % 10) };
+    if (index >= 100) {
+        QrmOutputWrite(output, digits, 3);
+    } else {
+        QrmOutputWrite(output, digits + 1, 2);
+    }
+}
+
+void QrmText_writeDebug(QrmOutput* output, QrmBoard board) {
+    QrmOutputWriteString(output, "  ");
+    for (UnsignedByte index = 0; index < board.dimension; index += 1) {
+        if (index % 2 > 0) {
+            QrmOutputWriteString(output, "..");
+        } else {
+            QrmText_writeIndex(output, index);
+        }
+    }
+    QrmOutputWrite(output, "\n", 1);
+    for (UnsignedByte index = 0; index < board.dimension; index += 1) {
+        QrmText_writeIndex(output, index);
+        for (UnsignedByte jndex = 0; jndex < board.dimension; jndex += 1) {
+            UnsignedByte byte = board.buffer[index][jndex];
+            if (byte == CellNeutral) {
+                QrmOutputWriteString(output, " +");
+                continue;
+            }
+            UnsignedByte low = byte & CellLowMask;
+            UnsignedByte high = byte & CellHighMask;
+            bool isFormat = high == CellFormat || high == CellVersion;
+            if (isFormat) {
+                QrmOutputWriteString(output, "®");
+            } else if ((byte & CellFuncMask) > 0) {
+                QrmOutputWriteString(output, "•");
+            } else if (high == CellErrorCorrection) {
+                QrmOutputWriteString(output, ".");
+            } else {
+                QrmOutputWriteString(output, " ");
+            }
+            if (low == CellUnset) {
+                QrmOutputWriteString(output, "□");
+            } else if (low == CellSet) {
+                QrmOutputWriteString(output, "■");
+            } else {
+                QrmOutputWriteString(output, isFormat ? "®" : " ");
+            }
+        }
+        QrmOutputWrite(output, "\n", 1);
+    }
+}
+
+bool QrmTextWrite(QrmOutput* output, QrmBoard board, unsigned int quietZone, QrmTextStyle style, bool isInverted) {
+    if (board.dimension == 0) {
+        return false;
+    }
+    switch (style) {
+    case TextHalfBlock:
+        QrmText_writeBlocks(output, board, quietZone, isInverted, false);
+        break;
+    case TextQuadrant:
+        QrmText_writeBlocks(output, board, quietZone, isInverted, true);
+        break;
+    case TextDebug:
+        QrmText_writeDebug(output, board);
+        break;
+    }
+    return QrmOutputFlush(output);
+}
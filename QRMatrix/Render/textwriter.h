@@ -0,0 +1,51 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef TEXTWRITER_H
+#define TEXTWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Text presentation of QR board
+typedef enum {
+    /// 1 x 2 modules per character (`▀`, `▄`, `█`): square modules on most terminals
+    TextHalfBlock,
+    /// 2 x 2 modules per character (quadrant characters `▘`, `▚`, `▟`...): smallest output
+    TextQuadrant,
+    /// 1 module per 2 characters with row/column indexes & cell type legend (as `QrmBoardPrintDescription(board, true)`)
+    TextDebug
+} QrmTextStyle;
+
+/// Write QR board as UTF-8 text lines (eg. to print to terminal or log at once).
+/// @return false if failed.
+bool QrmTextWrite(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Number of quiet zone modules around symbol (not for `TextDebug`)
+    unsigned int quietZone,
+    QrmTextStyle style,
+    /// Draw light modules instead of dark modules (for light text on dark background terminals). Not for `TextDebug`.
+    bool isInverted
+);
+
+#endif // TEXTWRITER_H
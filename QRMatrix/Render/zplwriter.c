@@ -0,0 +1,117 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "zplwriter.h"
+#include "raster.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char qrmZplHexDigits[] = "0123456789ABCDEF";
+
+/// Write `count` times of hex digit `digit` (repeat count letters are added up)
+void QrmZpl_writeRun(QrmOutput* output, char digit, unsigned int count) {
+    char buffer[4];
+    unsigned int length = 0;
+    if (count > 1) {
+        while (count > 400) {
+            QrmOutputWrite(output, "z", 1);
+            count -= 400;
+        }
+        if (count >= 20) {
+            buffer[length++] = (char)('f' + count / 20);
+            count %= 20;
+        }
+        if (count > 0) {
+            buffer[length++] = (char)('F' + count);
+        }
+    }
+    buffer[length++] = digit;
+    QrmOutputWrite(output, buffer, length);
+}
+
+/// Write row as compressed hex digits
+void QrmZpl_writeRow(QrmOutput* output, const UnsignedByte* row, unsigned int rowLength) {
+    unsigned int digitCount = rowLength * 2;
+    unsigned int index = 0;
+    while (index < digitCount) {
+        UnsignedByte value = index & 1 ? row[index / 2] & 0x0F : row[index / 2] >> 4;
+        unsigned int end = index + 1;
+        while (end < digitCount && (end & 1 ? row[end / 2] & 0x0F : row[end / 2] >> 4) == value) {
+            end += 1;
+        }
+        if (end == digitCount && value == 0x0) {
+            QrmOutputWrite(output, ",", 1);
+        } else if (end == digitCount && value == 0xF) {
+            QrmOutputWrite(output, "!", 1);
+        } else {
+            QrmZpl_writeRun(output, qrmZplHexDigits[value], end - index);
+        }
+        index = end;
+    }
+}
+
+bool QrmZplWriteGraphicField(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone) {
+    QrmRaster raster = QrmRasterCreate(board, scale, quietZone, Pixel1Bit, false);
+    if (raster.width == 0) {
+        return false;
+    }
+    ALLOC(UnsignedByte, previousRow, raster.rowLength);
+    if (previousRow == NULL) {
+        QrmRasterDestroy(&raster);
+        return false;
+    }
+    unsigned long total = (unsigned long)raster.rowLength * raster.width;
+    QrmOutputWriteString(output, "^GFA,");
+    QrmOutputWriteUnsigned(output, total);
+    QrmOutputWriteString(output, ",");
+    QrmOutputWriteUnsigned(output, total);
+    QrmOutputWriteString(output, ",");
+    QrmOutputWriteUnsigned(output, raster.rowLength);
+    QrmOutputWriteString(output, ",");
+    bool isFirstRow = true;
+    const UnsignedByte* row = QrmRasterNextRow(&raster);
+    while (row != NULL) {
+        if (!isFirstRow && (raster.isRepeated || memcmp(row, previousRow, raster.rowLength) == 0)) {
+            QrmOutputWrite(output, ":", 1);
+        } else {
+            QrmZpl_writeRow(output, row, raster.rowLength);
+            memcpy(previousRow, row, raster.rowLength);
+        }
+        isFirstRow = false;
+        row = QrmRasterNextRow(&raster);
+    }
+    DEALLOC(previousRow);
+    QrmRasterDestroy(&raster);
+    return !output->isFailed;
+}
+
+bool QrmZplWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone, unsigned int x, unsigned int y) {
+    QrmOutputWriteString(output, "^XA^FO");
+    QrmOutputWriteUnsigned(output, x);
+    QrmOutputWriteString(output, ",");
+    QrmOutputWriteUnsigned(output, y);
+    if (!QrmZplWriteGraphicField(output, board, scale, quietZone)) {
+        return false;
+    }
+    QrmOutputWriteString(output, "^FS^XZ\n");
+    return QrmOutputFlush(output);
+}
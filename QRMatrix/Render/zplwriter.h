@@ -0,0 +1,45 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ZPLWRITER_H
+#define ZPLWRITER_H
+
+#include "renderoutput.h"
+#include "../qrmatrixboard.h"
+
+/// Write QR board as ZPL graphic field (`^GFA,...`) with ZPL ASCII compression:
+/// repeat count letters (`G`...`Y`: 1...19, `g`...`z`: 20...400), `,` (rest of row is white),
+/// `!` (rest of row is black), `:` (same row as previous one).
+/// @return false if failed.
+bool QrmZplWriteGraphicField(
+    QrmOutput* output,
+    QrmBoard board,
+    /// Dots per module
+    unsigned int scale,
+    /// Number of quiet zone modules around symbol (QR: 4, MicroQR: 2)
+    unsigned int quietZone
+);
+
+/// Write complete ZPL label (`^XA^FO...^GFA,...^FS^XZ`) containing QR board at position (`x`, `y`) (unit: dot).
+bool QrmZplWrite(QrmOutput* output, QrmBoard board, unsigned int scale, unsigned int quietZone, unsigned int x, unsigned int y);
+
+#endif // ZPLWRITER_H
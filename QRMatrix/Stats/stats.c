@@ -0,0 +1,224 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "stats.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+/// `QrmStatsSnapshot` is an array of counters
+#define STATS_COUNTER_COUNT (sizeof(QrmStatsSnapshot) / sizeof(unsigned long long))
+#define STATS_INDEX(FIELD) (offsetof(QrmStatsSnapshot, FIELD) / sizeof(unsigned long long))
+
+/// Counters of 1 thread. Written by owner thread only, read by any thread.
+typedef struct QrmStats_Local {
+    _Atomic unsigned long long counters[STATS_COUNTER_COUNT];
+    /// Stage times of current board (owner thread only)
+    unsigned long long pending[StatsStageCount];
+    struct QrmStats_Local* previous;
+    struct QrmStats_Local* next;
+} QrmStats_Local;
+
+static pthread_mutex_t qrmStatsMutex = PTHREAD_MUTEX_INITIALIZER;
+/// Live threads
+static QrmStats_Local* qrmStatsLocals = NULL;
+/// Counters of finished threads
+static unsigned long long qrmStatsRetired[STATS_COUNTER_COUNT];
+/// Totals at last reset
+static unsigned long long qrmStatsBaseline[STATS_COUNTER_COUNT];
+static pthread_key_t qrmStatsKey;
+static pthread_once_t qrmStatsKeyOnce = PTHREAD_ONCE_INIT;
+static _Thread_local QrmStats_Local* qrmStatsLocal = NULL;
+static _Atomic(QrmStatsCallback) qrmStatsCallback = NULL;
+static _Atomic(void*) qrmStatsCallbackContext = NULL;
+
+static const char* qrmStatsStageNames[StatsStageCount] = {
+    "segments", "version", "padding", "errorCorrection", "interleave",
+    "functionPatterns", "placement", "mask", "format"
+};
+
+/// Thread exit: move counters to retired counters
+void QrmStats_retire(void* value) {
+    QrmStats_Local* local = value;
+    pthread_mutex_lock(&qrmStatsMutex);
+    for (size_t index = 0; index < STATS_COUNTER_COUNT; index += 1) {
+        qrmStatsRetired[index] += atomic_load_explicit(&local->counters[index], memory_order_relaxed);
+    }
+    if (local->previous != NULL) {
+        local->previous->next = local->next;
+    } else {
+        qrmStatsLocals = local->next;
+    }
+    if (local->next != NULL) {
+        local->next->previous = local->previous;
+    }
+    pthread_mutex_unlock(&qrmStatsMutex);
+    // Not `DEALLOC`: allocations of this module are not counted
+    free(local);
+}
+
+void QrmStats_createKey(void) {
+    pthread_key_create(&qrmStatsKey, QrmStats_retire);
+}
+
+QrmStats_Local* QrmStats_getLocal(void) {
+    if (qrmStatsLocal != NULL) {
+        return qrmStatsLocal;
+    }
+    pthread_once(&qrmStatsKeyOnce, QrmStats_createKey);
+    QrmStats_Local* local = calloc(1, sizeof(QrmStats_Local));
+    if (local == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&qrmStatsMutex);
+    local->next = qrmStatsLocals;
+    if (qrmStatsLocals != NULL) {
+        qrmStatsLocals->previous = local;
+    }
+    qrmStatsLocals = local;
+    pthread_mutex_unlock(&qrmStatsMutex);
+    pthread_setspecific(qrmStatsKey, local);
+    qrmStatsLocal = local;
+    return local;
+}
+
+void QrmStats_add(QrmStats_Local* local, size_t index, unsigned long long value) {
+    // Single writer: no need of atomic read-modify-write
+    unsigned long long current = atomic_load_explicit(&local->counters[index], memory_order_relaxed);
+    atomic_store_explicit(&local->counters[index], current + value, memory_order_relaxed);
+}
+
+/// Sum of retired & live counters. Mutex must be locked.
+void QrmStats_total(unsigned long long* result) {
+    memcpy(result, qrmStatsRetired, sizeof(qrmStatsRetired));
+    for (QrmStats_Local* local = qrmStatsLocals; local != NULL; local = local->next) {
+        for (size_t index = 0; index < STATS_COUNTER_COUNT; index += 1) {
+            result[index] += atomic_load_explicit(&local->counters[index], memory_order_relaxed);
+        }
+    }
+}
+
+// PUBLIC METHODS ===========================================================================================
+
+QrmStatsSnapshot QrmStatsGetSnapshot(void) {
+    QrmStatsSnapshot result;
+    unsigned long long* counters = (unsigned long long*)&result;
+    pthread_mutex_lock(&qrmStatsMutex);
+    QrmStats_total(counters);
+    for (size_t index = 0; index < STATS_COUNTER_COUNT; index += 1) {
+        counters[index] -= qrmStatsBaseline[index];
+    }
+    pthread_mutex_unlock(&qrmStatsMutex);
+    return result;
+}
+
+void QrmStatsReset(void) {
+    pthread_mutex_lock(&qrmStatsMutex);
+    QrmStats_total(qrmStatsBaseline);
+    pthread_mutex_unlock(&qrmStatsMutex);
+}
+
+void QrmStatsSetCallback(QrmStatsCallback callback, void* context) {
+    atomic_store(&qrmStatsCallbackContext, context);
+    atomic_store(&qrmStatsCallback, callback);
+}
+
+const char* QrmStatsStageName(QrmStatsStage stage) {
+    return stage < StatsStageCount ? qrmStatsStageNames[stage] : "";
+}
+
+// RECORDING ================================================================================================
+
+unsigned long long QrmStatsClock(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000ULL + (unsigned long long)time.tv_nsec;
+}
+
+void QrmStatsAddStageTime(QrmStatsStage stage, unsigned long long nanoseconds) {
+    QrmStats_Local* local = QrmStats_getLocal();
+    if (local == NULL) {
+        return;
+    }
+    QrmStats_add(local, STATS_INDEX(stageNanoseconds) + stage, nanoseconds);
+    QrmStats_add(local, STATS_INDEX(stageCounts) + stage, 1);
+    local->pending[stage] += nanoseconds;
+}
+
+void QrmStatsAddSegment(QrmEncodingMode mode) {
+    QrmStats_Local* local = QrmStats_getLocal();
+    if (local == NULL) {
+        return;
+    }
+    switch (mode) {
+    case EModeNumeric:
+        QrmStats_add(local, STATS_INDEX(modeCounts), 1);
+        break;
+    case EModeAlphaNumeric:
+        QrmStats_add(local, STATS_INDEX(modeCounts) + 1, 1);
+        break;
+    case EModeByte:
+        QrmStats_add(local, STATS_INDEX(modeCounts) + 2, 1);
+        break;
+    case EModeKanji:
+        QrmStats_add(local, STATS_INDEX(modeCounts) + 3, 1);
+        break;
+    }
+}
+
+void QrmStatsAddSymbol(UnsignedByte version, QrmErrorCorrectionLevel level, bool isMicro, UnsignedByte maskId) {
+    QrmStats_Local* local = QrmStats_getLocal();
+    if (local == NULL) {
+        return;
+    }
+    QrmStats_add(local, STATS_INDEX(symbolCount), 1);
+    if (isMicro && version <= 4) {
+        QrmStats_add(local, STATS_INDEX(microVersionCounts) + version, 1);
+    } else if (!isMicro && version <= 40) {
+        QrmStats_add(local, STATS_INDEX(versionCounts) + version, 1);
+    }
+    QrmStats_add(local, STATS_INDEX(levelCounts) + (level & 0b11), 1);
+    QrmStats_add(local, STATS_INDEX(maskCounts) + (maskId & 0b111), 1);
+    QrmStatsCallback callback = atomic_load(&qrmStatsCallback);
+    if (callback != NULL) {
+        QrmStatsSymbol symbol;
+        symbol.version = version;
+        symbol.level = level;
+        symbol.isMicro = isMicro;
+        symbol.maskId = maskId;
+        memcpy(symbol.stageNanoseconds, local->pending, sizeof(local->pending));
+        callback(atomic_load(&qrmStatsCallbackContext), &symbol);
+    }
+    memset(local->pending, 0, sizeof(local->pending));
+}
+
+void QrmStatsAddAllocation(unsigned long long bytes) {
+    QrmStats_Local* local = QrmStats_getLocal();
+    if (local == NULL) {
+        return;
+    }
+    QrmStats_add(local, STATS_INDEX(allocationCount), 1);
+    QrmStats_add(local, STATS_INDEX(allocatedBytes), bytes);
+}
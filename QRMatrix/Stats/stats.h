@@ -0,0 +1,104 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "../constants.h"
+
+/// Encoding stages measured by instrumentation
+typedef enum {
+    /// Encode data segments into bit stream
+    StatsStageSegments,
+    /// Find QR version which fits data
+    StatsStageVersion,
+    /// Terminator & pad codewords
+    StatsStagePadding,
+    /// Reed-Solomon error correction codewords
+    StatsStageErrorCorrection,
+    /// Interleave data & error correction blocks
+    StatsStageInterleave,
+    /// Finder, separator, alignment, timing patterns & reserved areas
+    StatsStageFunctionPatterns,
+    /// Place codewords into board
+    StatsStagePlacement,
+    /// Apply & score masks
+    StatsStageMask,
+    /// Place format & version information
+    StatsStageFormat,
+    StatsStageCount
+} QrmStatsStage;
+
+/// Totals of all threads (since start or last `QrmStatsReset`)
+typedef struct {
+    /// Total time (nanoseconds) & number of executions of each stage
+    unsigned long long stageNanoseconds[StatsStageCount];
+    unsigned long long stageCounts[StatsStageCount];
+    /// Number of created boards
+    unsigned long long symbolCount;
+    /// Number of boards by version (QR: 1...40; index 0 is not used)
+    unsigned long long versionCounts[41];
+    /// Number of MicroQR boards by version (M1...M4; index 0 is not used)
+    unsigned long long microVersionCounts[5];
+    /// Number of boards by error correction level (index: `QrmErrorCorrectionLevel` value)
+    unsigned long long levelCounts[4];
+    /// Number of boards by mask
+    unsigned long long maskCounts[8];
+    /// Number of encoded segments by mode (index: Numeric, AlphaNumeric, Byte, Kanji)
+    unsigned long long modeCounts[4];
+    /// Number of allocations & total allocated bytes (by `ALLOC` & `REALLOC`)
+    unsigned long long allocationCount;
+    unsigned long long allocatedBytes;
+} QrmStatsSnapshot;
+
+/// Information of 1 created board
+typedef struct {
+    UnsignedByte version;
+    QrmErrorCorrectionLevel level;
+    bool isMicro;
+    UnsignedByte maskId;
+    /// Time (nanoseconds) of each stage of this board (on current thread since previous board)
+    unsigned long long stageNanoseconds[StatsStageCount];
+} QrmStatsSymbol;
+
+/// Called on the encoding thread when a board is created.
+typedef void (*QrmStatsCallback)(void* context, const QrmStatsSymbol* symbol);
+
+/// Get totals. Counters of each thread are merged.
+QrmStatsSnapshot QrmStatsGetSnapshot(void);
+/// Start counting from zero
+void QrmStatsReset(void);
+/// Set (or remove by passing NULL) callback of created boards
+void QrmStatsSetCallback(QrmStatsCallback callback, void* context);
+/// Name of stage (eg. "mask")
+const char* QrmStatsStageName(QrmStatsStage stage);
+
+// Recording functions for `STATS_...` macros (`constants.h`). Internal purpose. Do not use.
+
+/// Monotonic clock (nanoseconds)
+unsigned long long QrmStatsClock(void);
+void QrmStatsAddStageTime(QrmStatsStage stage, unsigned long long nanoseconds);
+void QrmStatsAddSegment(QrmEncodingMode mode);
+void QrmStatsAddSymbol(UnsignedByte version, QrmErrorCorrectionLevel level, bool isMicro, UnsignedByte maskId);
+void QrmStatsAddAllocation(unsigned long long bytes);
+
+#endif // STATS_H
@@ -0,0 +1,64 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "concurrentencoder.h"
+#include <stdlib.h>
+
+typedef struct {
+    QrmStructuredAppend* parts;
+    UnsignedByte count;
+    UnsignedByte parity;
+    QrmBoard* result;
+} QrmConcurrentEncoder_structuredAppendJob;
+
+void QrmConcurrentEncoder_encodePart(void* context, unsigned int index) {
+    QrmConcurrentEncoder_structuredAppendJob* job = (QrmConcurrentEncoder_structuredAppendJob*)context;
+    // Each task writes its own slot, so no lock required
+    job->result[index] = QrmEncoderEncodeStructuredAppendPart(
+        job->parts[index], (UnsignedByte)index, job->count, job->parity
+    );
+}
+
+QrmBoard* QrmEncoderMakeStructuredAppendConcurrently(
+    QrmStructuredAppend* parts,
+    unsigned int count,
+    QrmThreadPool pool
+) {
+    if (count > 16) {
+        LOG("ERROR: Structured Append only accepts 16 parts maximum");
+        return NULL;
+    }
+    if (count == 0) {
+        LOG("ERROR: No input.");
+        return NULL;
+    }
+    QrmConcurrentEncoder_structuredAppendJob job;
+    job.parts = parts;
+    job.count = (UnsignedByte)count;
+    job.parity = QrmEncoderGetStructuredAppendParity(parts, count);
+    ALLOC_(QrmBoard, job.result, count);
+    if (job.result == NULL) {
+        return NULL;
+    }
+    QrmThreadPoolRun(pool, QrmConcurrentEncoder_encodePart, &job, count);
+    return job.result;
+}
@@ -0,0 +1,41 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CONCURRENTENCODER_H
+#define CONCURRENTENCODER_H
+
+#include "../qrmatrixencoder.h"
+#include "threadpool.h"
+
+/// Encode Structured Append QR symbols, each symbol on a thread of `pool`.
+/// Boards are the same as `QrmEncoderMakeStructuredAppend`.
+/// @return Array of QRMatrixBoard (should be deleted when done).
+QrmBoard* QrmEncoderMakeStructuredAppendConcurrently(
+    /// Array of data parts to be encoded
+    QrmStructuredAppend* parts,
+    /// Number of parts
+    unsigned int count,
+    /// Threads to run on
+    QrmThreadPool pool
+);
+
+#endif // CONCURRENTENCODER_H
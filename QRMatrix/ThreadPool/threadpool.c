@@ -0,0 +1,184 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "threadpool.h"
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+
+struct QrmThreadPoolState {
+    pthread_t* threads;
+    unsigned int threadCount;
+    /// Serialize `QrmThreadPoolRun` callers
+    pthread_mutex_t runLock;
+    /// Protect below properties
+    pthread_mutex_t lock;
+    pthread_cond_t jobCondition;
+    pthread_cond_t doneCondition;
+    /// Increase on each new job so sleeping workers know there's new work
+    unsigned long generation;
+    bool isStopping;
+    QrmThreadTask task;
+    void* context;
+    /// Allocator of thread calling `QrmThreadPoolRun`, used by workers while running its tasks
+    QrmAllocator allocator;
+    unsigned int count;
+    unsigned int nextIndex;
+    unsigned int finishedCount;
+    /// Number of workers still attached to current job
+    unsigned int activeWorkers;
+};
+
+/// Claim and execute job items until there's no item left.
+void QrmThreadPool_work(QrmThreadPoolState* state) {
+    pthread_mutex_lock(&state->lock);
+    while (state->nextIndex < state->count) {
+        unsigned int index = state->nextIndex;
+        state->nextIndex += 1;
+        QrmThreadTask task = state->task;
+        void* context = state->context;
+        QrmAllocator allocator = state->allocator;
+        pthread_mutex_unlock(&state->lock);
+        QrmAllocator previous = QrmSetThreadAllocator(allocator);
+        task(context, index);
+        QrmSetThreadAllocator(previous);
+        pthread_mutex_lock(&state->lock);
+        state->finishedCount += 1;
+    }
+    pthread_mutex_unlock(&state->lock);
+}
+
+void* QrmThreadPool_workerMain(void* argument) {
+    QrmThreadPoolState* state = (QrmThreadPoolState*)argument;
+    unsigned long seenGeneration = 0;
+    pthread_mutex_lock(&state->lock);
+    while (true) {
+        while (!state->isStopping && state->generation == seenGeneration) {
+            pthread_cond_wait(&state->jobCondition, &state->lock);
+        }
+        if (state->isStopping) {
+            break;
+        }
+        seenGeneration = state->generation;
+        state->activeWorkers += 1;
+        pthread_mutex_unlock(&state->lock);
+        QrmThreadPool_work(state);
+        pthread_mutex_lock(&state->lock);
+        state->activeWorkers -= 1;
+        pthread_cond_broadcast(&state->doneCondition);
+    }
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+unsigned int QrmThreadPoolProcessorCount() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+}
+
+QrmThreadPool QrmThreadPoolCreate(unsigned int threadCount) {
+    QrmThreadPool result;
+    result.threadCount = 0;
+    result.state = NULL;
+    if (threadCount == 0) {
+        threadCount = QrmThreadPoolProcessorCount() - 1;
+    }
+    ALLOC_(QrmThreadPoolState, result.state, 1);
+    if (result.state == NULL) {
+        return result;
+    }
+    QrmThreadPoolState* state = result.state;
+    pthread_mutex_init(&state->runLock, NULL);
+    pthread_mutex_init(&state->lock, NULL);
+    pthread_cond_init(&state->jobCondition, NULL);
+    pthread_cond_init(&state->doneCondition, NULL);
+    if (threadCount > 0) {
+        ALLOC_(pthread_t, state->threads, threadCount);
+    }
+    for (unsigned int index = 0; index < threadCount && state->threads != NULL; index += 1) {
+        if (pthread_create(&state->threads[index], NULL, QrmThreadPool_workerMain, state) != 0) {
+            LOG("ERROR: Unable to create worker thread.");
+            break;
+        }
+        state->threadCount += 1;
+    }
+    result.threadCount = state->threadCount;
+    return result;
+}
+
+void QrmThreadPoolDestroy(QrmThreadPool* pool) {
+    QrmThreadPoolState* state = pool->state;
+    if (state == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&state->lock);
+    state->isStopping = true;
+    pthread_cond_broadcast(&state->jobCondition);
+    pthread_mutex_unlock(&state->lock);
+    for (unsigned int index = 0; index < state->threadCount; index += 1) {
+        pthread_join(state->threads[index], NULL);
+    }
+    if (state->threads != NULL) {
+        DEALLOC(state->threads);
+    }
+    pthread_cond_destroy(&state->doneCondition);
+    pthread_cond_destroy(&state->jobCondition);
+    pthread_mutex_destroy(&state->lock);
+    pthread_mutex_destroy(&state->runLock);
+    DEALLOC(pool->state);
+    pool->threadCount = 0;
+}
+
+void QrmThreadPoolRun(QrmThreadPool pool, QrmThreadTask task, void* context, unsigned int count) {
+    if (count == 0 || task == NULL) {
+        return;
+    }
+    QrmThreadPoolState* state = pool.state;
+    if (state == NULL || state->threadCount == 0 || count == 1) {
+        for (unsigned int index = 0; index < count; index += 1) {
+            task(context, index);
+        }
+        return;
+    }
+    pthread_mutex_lock(&state->runLock);
+    pthread_mutex_lock(&state->lock);
+    state->task = task;
+    state->context = context;
+    state->allocator = QrmGetAllocator();
+    state->count = count;
+    state->nextIndex = 0;
+    state->finishedCount = 0;
+    state->generation += 1;
+    pthread_cond_broadcast(&state->jobCondition);
+    pthread_mutex_unlock(&state->lock);
+    // Calling thread works too
+    QrmThreadPool_work(state);
+    pthread_mutex_lock(&state->lock);
+    while (state->finishedCount < count || state->activeWorkers > 0) {
+        pthread_cond_wait(&state->doneCondition, &state->lock);
+    }
+    state->task = NULL;
+    state->context = NULL;
+    state->count = 0;
+    pthread_mutex_unlock(&state->lock);
+    pthread_mutex_unlock(&state->runLock);
+}
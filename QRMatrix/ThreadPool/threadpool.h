@@ -0,0 +1,63 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "../constants.h"
+
+/// Task executed by thread pool.
+typedef void (*QrmThreadTask)(
+    /// User context passed to `QrmThreadPoolRun`
+    void* context,
+    /// Index of work item (0...count-1)
+    unsigned int index
+);
+
+typedef struct QrmThreadPoolState QrmThreadPoolState;
+
+/// Fixed set of worker threads.
+typedef struct {
+    /// Number of worker threads (the calling thread of `QrmThreadPoolRun` also works, so concurrency is `threadCount + 1`).
+    unsigned int threadCount;
+    QrmThreadPoolState* state;
+} QrmThreadPool;
+
+/// Number of online processors (1 if unknown).
+unsigned int QrmThreadPoolProcessorCount(void);
+/// Constructor.
+/// `threadCount` = 0: use `QrmThreadPoolProcessorCount() - 1` workers.
+QrmThreadPool QrmThreadPoolCreate(unsigned int threadCount);
+/// Destructor. Waits for workers to finish.
+void QrmThreadPoolDestroy(QrmThreadPool* pool);
+/// Execute `task` for every index in `0...count-1` then return.
+/// Calls from multiple threads on the same pool are serialized.
+/// Empty pool (threadCount = 0 or failed to create) runs all tasks on the calling thread.
+/// Tasks allocate with the allocator of the calling thread (see `QrmSetThreadAllocator`), whichever thread runs them.
+void QrmThreadPoolRun(
+    QrmThreadPool pool,
+    QrmThreadTask task,
+    void* context,
+    unsigned int count
+);
+
+#endif // THREADPOOL_H
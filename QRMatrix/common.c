@@ -36,14 +36,198 @@ unsigned int QrmInfoECCodewordsTotalCount(QrmSymbolInfo info) {
     return QrmInfoECBlockTotalCount(info) * info.ecCodewordsPerBlock;
 }
 
-bool qrmIsEnvValid = false;
-bool qrmIsLittleEndian = false;
+// ALLOCATOR ==============================================================================================
+
+#if QRM_NO_HEAP
+
+#include <stdatomic.h>
+
+/// Header of block of static memory (block size is a multiple of header size, header included)
+typedef struct {
+    size_t size;
+    size_t isUsed;
+} QrmHeap_Block;
+
+static QrmHeap_Block qrmHeap[(QRM_HEAP_SIZE + sizeof(QrmHeap_Block) - 1) / sizeof(QrmHeap_Block)];
+static size_t qrmHeapPeak = 0;
+/// Static memory is shared by all threads (eg. `QrmThreadPoolRun` tasks, `QrmBoardCache`): spin lock (no OS dependency)
+static atomic_flag qrmHeapLock = ATOMIC_FLAG_INIT;
+
+void QrmHeap_lock(void) {
+    while (atomic_flag_test_and_set_explicit(&qrmHeapLock, memory_order_acquire)) {
+    }
+}
+
+void QrmHeap_unlock(void) {
+    atomic_flag_clear_explicit(&qrmHeapLock, memory_order_release);
+}
+
+/// First fit allocation (lock must be held)
+void* QrmHeap_allocate(size_t count, size_t size) {
+    const size_t heapLength = sizeof(qrmHeap) / sizeof(QrmHeap_Block);
+    if (qrmHeap[0].size == 0) {
+        qrmHeap[0].size = heapLength;
+    }
+    // Number of `QrmHeap_Block` units (header + data); like `calloc`, empty request still gets usable memory
+    size_t length = 1 + (count * size + sizeof(QrmHeap_Block) - 1) / sizeof(QrmHeap_Block);
+    if (length < 2) {
+        length = 2;
+    }
+    size_t index = 0;
+    while (index < heapLength) {
+        QrmHeap_Block* block = &qrmHeap[index];
+        if (!block->isUsed) {
+            // Merge following free blocks
+            while (index + block->size < heapLength && !qrmHeap[index + block->size].isUsed) {
+                block->size += qrmHeap[index + block->size].size;
+            }
+            if (block->size >= length) {
+                if (block->size > length) {
+                    qrmHeap[index + length].size = block->size - length;
+                    qrmHeap[index + length].isUsed = false;
+                    block->size = length;
+                }
+                block->isUsed = true;
+                if ((index + length) * sizeof(QrmHeap_Block) > qrmHeapPeak) {
+                    qrmHeapPeak = (index + length) * sizeof(QrmHeap_Block);
+                }
+                memset(block + 1, 0, (length - 1) * sizeof(QrmHeap_Block));
+                return block + 1;
+            }
+        }
+        index += block->size;
+    }
+    LOG("ERROR: Out of static memory (QRM_HEAP_SIZE).");
+    return NULL;
+}
+
+void* QrmAllocator_allocate(void* context, size_t count, size_t size) {
+    (void)context;
+    QrmHeap_lock();
+    void* result = QrmHeap_allocate(count, size);
+    QrmHeap_unlock();
+    return result;
+}
+
+void QrmAllocator_release(void* context, void* pointer) {
+    (void)context;
+    if (pointer != NULL) {
+        QrmHeap_lock();
+        ((QrmHeap_Block*)pointer - 1)->isUsed = false;
+        QrmHeap_unlock();
+    }
+}
+
+void* QrmAllocator_reallocate(void* context, void* pointer, size_t size) {
+    (void)context;
+    QrmHeap_lock();
+    void* result = pointer;
+    if (pointer == NULL) {
+        result = QrmHeap_allocate(1, size);
+    } else {
+        QrmHeap_Block* block = (QrmHeap_Block*)pointer - 1;
+        size_t capacity = (block->size - 1) * sizeof(QrmHeap_Block);
+        if (size > capacity) {
+            result = QrmHeap_allocate(1, size);
+            if (result != NULL) {
+                memcpy(result, pointer, capacity);
+                block->isUsed = false;
+            }
+        }
+    }
+    QrmHeap_unlock();
+    return result;
+}
+
+size_t QrmGetHeapPeak(void) {
+    QrmHeap_lock();
+    size_t result = qrmHeapPeak;
+    QrmHeap_unlock();
+    return result;
+}
+
+#else
+
+void* QrmAllocator_allocate(void* context, size_t count, size_t size) {
+    (void)context;
+    return calloc(count, size);
+}
+
+void* QrmAllocator_reallocate(void* context, void* pointer, size_t size) {
+    (void)context;
+    return realloc(pointer, size);
+}
+
+void QrmAllocator_release(void* context, void* pointer) {
+    (void)context;
+    free(pointer);
+}
+
+#endif
+
+static QrmAllocator qrmAllocator = { NULL, QrmAllocator_allocate, QrmAllocator_reallocate, QrmAllocator_release };
+static _Thread_local QrmAllocator qrmThreadAllocator = { NULL, NULL, NULL, NULL };
+
+QrmAllocator QrmAllocatorCreateDefault(void) {
+    QrmAllocator result = { NULL, QrmAllocator_allocate, QrmAllocator_reallocate, QrmAllocator_release };
+    return result;
+}
+
+void QrmSetAllocator(QrmAllocator allocator) {
+    if (allocator.allocate == NULL || allocator.reallocate == NULL || allocator.release == NULL) {
+        allocator = QrmAllocatorCreateDefault();
+    }
+    qrmAllocator = allocator;
+}
+
+QrmAllocator QrmSetThreadAllocator(QrmAllocator allocator) {
+    QrmAllocator result = qrmThreadAllocator;
+    if (allocator.allocate == NULL || allocator.reallocate == NULL || allocator.release == NULL) {
+        QrmAllocator none = { NULL, NULL, NULL, NULL };
+        allocator = none;
+    }
+    qrmThreadAllocator = allocator;
+    return result;
+}
+
+QrmAllocator QrmGetAllocator(void) {
+    return qrmThreadAllocator.allocate != NULL ? qrmThreadAllocator : qrmAllocator;
+}
+
+void* QrmAlloc(size_t count, size_t size) {
+    if (qrmThreadAllocator.allocate != NULL) {
+        return qrmThreadAllocator.allocate(qrmThreadAllocator.context, count, size);
+    }
+    return qrmAllocator.allocate(qrmAllocator.context, count, size);
+}
+
+void* QrmRealloc(void* pointer, size_t size) {
+    if (qrmThreadAllocator.reallocate != NULL) {
+        return qrmThreadAllocator.reallocate(qrmThreadAllocator.context, pointer, size);
+    }
+    return qrmAllocator.reallocate(qrmAllocator.context, pointer, size);
+}
+
+void QrmFree(void* pointer) {
+    if (qrmThreadAllocator.release != NULL) {
+        qrmThreadAllocator.release(qrmThreadAllocator.context, pointer);
+        return;
+    }
+    qrmAllocator.release(qrmAllocator.context, pointer);
+}
+
+// ENVIRONMENT ============================================================================================
+
+// Checked at compile time (here, not in headers, which are also included by C++)
+_Static_assert(sizeof(UnsignedByte) == 1, "UnsignedByte must be 1 byte");
+_Static_assert(sizeof(Unsigned2Bytes) == 2, "Unsigned2Bytes must be 2 bytes");
+_Static_assert(sizeof(Unsigned4Bytes) == 4, "Unsigned4Bytes must be 4 bytes");
+_Static_assert(QRM_MAX_VERSION >= 1 && QRM_MAX_VERSION <= 40, "QRM_MAX_VERSION must be 1...40");
+
+const bool qrmIsEnvValid = true;
+const bool qrmIsLittleEndian = QRM_LITTLE_ENDIAN;
 
 void QrmCheckEnv() {
-    qrmIsEnvValid = (sizeof(UnsignedByte) == 1) && (sizeof(Unsigned2Bytes) == 2) && (sizeof(Unsigned4Bytes) == 4);
-    unsigned int value = 0x00000001;
-    unsigned char *ptr = (unsigned char*)&value;
-    qrmIsLittleEndian = (*ptr == 1);
 }
 
 UnsignedByte QrmGetDimensionByVersion(UnsignedByte version, bool isMicro) {
@@ -79,47 +263,8 @@ void QrmSymbolInfoInit(QrmSymbolInfo* result) {
 }
 
 QrmSymbolInfo QrmGetSymbolInfo(UnsignedByte version, QrmErrorCorrectionLevel level, bool isMicro) {
-    static const Unsigned2Bytes map[40][4][6] = {
-        {{  19,  7,  1,  19,  0,   0}, {  16, 10,  1,  16,  0,   0}, {  13, 13,  1,  13,  0,   0}, {   9, 17,  1,   9,  0,   0}},
-        {{  34, 10,  1,  34,  0,   0}, {  28, 16,  1,  28,  0,   0}, {  22, 22,  1,  22,  0,   0}, {  16, 28,  1,  16,  0,   0}},
-        {{  55, 15,  1,  55,  0,   0}, {  44, 26,  1,  44,  0,   0}, {  34, 18,  2,  17,  0,   0}, {  26, 22,  2,  13,  0,   0}},
-        {{  80, 20,  1,  80,  0,   0}, {  64, 18,  2,  32,  0,   0}, {  48, 26,  2,  24,  0,   0}, {  36, 16,  4,   9,  0,   0}},
-        {{ 108, 26,  1, 108,  0,   0}, {  86, 24,  2,  43,  0,   0}, {  62, 18,  2,  15,  2,  16}, {  46, 22,  2,  11,  2,  12}},
-        {{ 136, 18,  2,  68,  0,   0}, { 108, 16,  4,  27,  0,   0}, {  76, 24,  4,  19,  0,   0}, {  60, 28,  4,  15,  0,   0}},
-        {{ 156, 20,  2,  78,  0,   0}, { 124, 18,  4,  31,  0,   0}, {  88, 18,  2,  14,  4,  15}, {  66, 26,  4,  13,  1,  14}},
-        {{ 194, 24,  2,  97,  0,   0}, { 154, 22,  2,  38,  2,  39}, { 110, 22,  4,  18,  2,  19}, {  86, 26,  4,  14,  2,  15}},
-        {{ 232, 30,  2, 116,  0,   0}, { 182, 22,  3,  36,  2,  37}, { 132, 20,  4,  16,  4,  17}, { 100, 24,  4,  12,  4,  13}},
-        {{ 274, 18,  2,  68,  2,  69}, { 216, 26,  4,  43,  1,  44}, { 154, 24,  6,  19,  2,  20}, { 122, 28,  6,  15,  2,  16}},
-        {{ 324, 20,  4,  81,  0,   0}, { 254, 30,  1,  50,  4,  51}, { 180, 28,  4,  22,  4,  23}, { 140, 24,  3,  12,  8,  13}},
-        {{ 370, 24,  2,  92,  2,  93}, { 290, 22,  6,  36,  2,  37}, { 206, 26,  4,  20,  6,  21}, { 158, 28,  7,  14,  4,  15}},
-        {{ 428, 26,  4, 107,  0,   0}, { 334, 22,  8,  37,  1,  38}, { 244, 24,  8,  20,  4,  21}, { 180, 22, 12,  11,  4,  12}},
-        {{ 461, 30,  3, 115,  1, 116}, { 365, 24,  4,  40,  5,  41}, { 261, 20, 11,  16,  5,  17}, { 197, 24, 11,  12,  5,  13}},
-        {{ 523, 22,  5,  87,  1,  88}, { 415, 24,  5,  41,  5,  42}, { 295, 30,  5,  24,  7,  25}, { 223, 24, 11,  12,  7,  13}},
-        {{ 589, 24,  5,  98,  1,  99}, { 453, 28,  7,  45,  3,  46}, { 325, 24, 15,  19,  2,  20}, { 253, 30,  3,  15, 13,  16}},
-        {{ 647, 28,  1, 107,  5, 108}, { 507, 28, 10,  46,  1,  47}, { 367, 28,  1,  22, 15,  23}, { 283, 28,  2,  14, 17,  15}},
-        {{ 721, 30,  5, 120,  1, 121}, { 563, 26,  9,  43,  4,  44}, { 397, 28, 17,  22,  1,  23}, { 313, 28,  2,  14, 19,  15}},
-        {{ 795, 28,  3, 113,  4, 114}, { 627, 26,  3,  44, 11,  45}, { 445, 26, 17,  21,  4,  22}, { 341, 26,  9,  13, 16,  14}},
-        {{ 861, 28,  3, 107,  5, 108}, { 669, 26,  3,  41, 13,  42}, { 485, 30, 15,  24,  5,  25}, { 385, 28, 15,  15, 10,  16}},
-        {{ 932, 28,  4, 116,  4, 117}, { 714, 26, 17,  42,  0,   0}, { 512, 28, 17,  22,  6,  23}, { 406, 30, 19,  16,  6,  17}},
-        {{1006, 28,  2, 111,  7, 112}, { 782, 28, 17,  46,  0,   0}, { 568, 30,  7,  24, 16,  25}, { 442, 24, 34,  13,  0,   0}},
-        {{1094, 30,  4, 121,  5, 122}, { 860, 28,  4,  47, 14,  48}, { 614, 30, 11,  24, 14,  25}, { 464, 30, 16,  15, 14,  16}},
-        {{1174, 30,  6, 117,  4, 118}, { 914, 28,  6,  45, 14,  46}, { 664, 30, 11,  24, 16,  25}, { 514, 30, 30,  16,  2,  17}},
-        {{1276, 26,  8, 106,  4, 107}, {1000, 28,  8,  47, 13,  48}, { 718, 30,  7,  24, 22,  25}, { 538, 30, 22,  15, 13,  16}},
-        {{1370, 28, 10, 114,  2, 115}, {1062, 28, 19,  46,  4,  47}, { 754, 28, 28,  22,  6,  23}, { 596, 30, 33,  16,  4,  17}},
-        {{1468, 30,  8, 122,  4, 123}, {1128, 28, 22,  45,  3,  46}, { 808, 30,  8,  23, 26,  24}, { 628, 30, 12,  15, 28,  16}},
-        {{1531, 30,  3, 117, 10, 118}, {1193, 28,  3,  45, 23,  46}, { 871, 30,  4,  24, 31,  25}, { 661, 30, 11,  15, 31,  16}},
-        {{1631, 30,  7, 116,  7, 117}, {1267, 28, 21,  45,  7,  46}, { 911, 30,  1,  23, 37,  24}, { 701, 30, 19,  15, 26,  16}},
-        {{1735, 30,  5, 115, 10, 116}, {1373, 28, 19,  47, 10,  48}, { 985, 30, 15,  24, 25,  25}, { 745, 30, 23,  15, 25,  16}},
-        {{1843, 30, 13, 115,  3, 116}, {1455, 28,  2,  46, 29,  47}, {1033, 30, 42,  24,  1,  25}, { 793, 30, 23,  15, 28,  16}},
-        {{1955, 30, 17, 115,  0,   0}, {1541, 28, 10,  46, 23,  47}, {1115, 30, 10,  24, 35,  25}, { 845, 30, 19,  15, 35,  16}},
-        {{2071, 30, 17, 115,  1, 116}, {1631, 28, 14,  46, 21,  47}, {1171, 30, 29,  24, 19,  25}, { 901, 30, 11,  15, 46,  16}},
-        {{2191, 30, 13, 115,  6, 116}, {1725, 28, 14,  46, 23,  47}, {1231, 30, 44,  24,  7,  25}, { 961, 30, 59,  16,  1,  17}},
-        {{2306, 30, 12, 121,  7, 122}, {1812, 28, 12,  47, 26,  48}, {1286, 30, 39,  24, 14,  25}, { 986, 30, 22,  15, 41,  16}},
-        {{2434, 30,  6, 121, 14, 122}, {1914, 28,  6,  47, 34,  48}, {1354, 30, 46,  24, 10,  25}, {1054, 30,  2,  15, 64,  16}},
-        {{2566, 30, 17, 122,  4, 123}, {1992, 28, 29,  46, 14,  47}, {1426, 30, 49,  24, 10,  25}, {1096, 30, 24,  15, 46,  16}},
-        {{2702, 30,  4, 122, 18, 123}, {2102, 28, 13,  46, 32,  47}, {1502, 30, 48,  24, 14,  25}, {1142, 30, 42,  15, 32,  16}},
-        {{2812, 30, 20, 117,  4, 118}, {2216, 28, 40,  47,  7,  48}, {1582, 30, 43,  24, 22,  25}, {1222, 30, 10,  15, 67,  16}},
-        {{2956, 30, 19, 118,  6, 119}, {2334, 28, 18,  47, 31,  48}, {1666, 30, 34,  24, 34,  25}, {1276, 30, 20,  15, 61,  16}}
+    static const Unsigned2Bytes map[][4][6] = {
+#include "Tables/symbolinfo.inc"
     };
     static const Unsigned2Bytes mapMicro[4][4][2] = {
         {{  3, 2 }, {  3,  2 }, {  3,  2 }, { 3, 2 }},
@@ -129,6 +274,12 @@ QrmSymbolInfo QrmGetSymbolInfo(UnsignedByte version, QrmErrorCorrectionLevel lev
     };
 
     QrmSymbolInfo result; QrmSymbolInfoInit(&result);
+#if QRM_NO_MICRO
+    if (isMicro) {
+        LOG("ERROR: MicroQR is not supported (QRM_NO_MICRO).");
+        return result;
+    }
+#endif
 
     int versionIndex = version - 1;
     if (versionIndex < 0 || versionIndex >= (isMicro ? MICROQR_MAX_VERSION : QR_MAX_VERSION)) {
@@ -435,51 +586,41 @@ bool QrmCopyBits(
     return true;
 }
 
+bool QrmCopyValueBits(
+    Unsigned4Bytes value,
+    unsigned int count,
+    UnsignedByte* destination,
+    unsigned int destStartIndex
+) {
+    if (count == 0 || count > 32) {
+        LOG("ERROR: Count must be 1...32 (bits).");
+        return false;
+    }
+    UnsignedByte* curDestPtr = destination + destStartIndex / 8;
+    unsigned int destBitIndex = destStartIndex % 8;
+    unsigned int totalCount = count;
+    while (totalCount > 0) {
+        // Number of bits to write into current destination byte
+        unsigned int available = 8 - destBitIndex;
+        unsigned int curCount = totalCount < available ? totalCount : available;
+        unsigned int shift = available - curCount;
+        UnsignedByte pattern = (UnsignedByte)(((1u << curCount) - 1) << shift);
+        UnsignedByte bits = (UnsignedByte)(((value >> (totalCount - curCount)) << shift) & pattern);
+        *curDestPtr = (*curDestPtr & ~pattern) | bits;
+        totalCount -= curCount;
+        destBitIndex = 0;
+        curDestPtr += 1;
+    }
+    return true;
+}
+
 const UnsignedByte* QrmGetAlignmentLocations(UnsignedByte version) {
     if (version < 2 || version > QR_MAX_VERSION) {
         LOG("ERROR: Version must be 2...40");
         return NULL;
     }
     static const UnsignedByte data[][6] = {
-        {  18,    0,    0,    0,    0,    0},
-        {  22,    0,    0,    0,    0,    0},
-        {  26,    0,    0,    0,    0,    0},
-        {  30,    0,    0,    0,    0,    0},
-        {  34,    0,    0,    0,    0,    0},
-        {  22,   38,    0,    0,    0,    0},
-        {  24,   42,    0,    0,    0,    0},
-        {  26,   46,    0,    0,    0,    0},
-        {  28,   50,    0,    0,    0,    0},
-        {  30,   54,    0,    0,    0,    0},
-        {  32,   58,    0,    0,    0,    0},
-        {  34,   62,    0,    0,    0,    0},
-        {  26,   46,   66,    0,    0,    0},
-        {  26,   48,   70,    0,    0,    0},
-        {  26,   50,   74,    0,    0,    0},
-        {  30,   54,   78,    0,    0,    0},
-        {  30,   56,   82,    0,    0,    0},
-        {  30,   58,   86,    0,    0,    0},
-        {  34,   62,   90,    0,    0,    0},
-        {  28,   50,   72,   94,    0,    0},
-        {  26,   50,   74,   98,    0,    0},
-        {  30,   54,   78,  102,    0,    0},
-        {  28,   54,   80,  106,    0,    0},
-        {  32,   58,   84,  110,    0,    0},
-        {  30,   58,   86,  114,    0,    0},
-        {  34,   62,   90,  118,    0,    0},
-        {  26,   50,   74,   98,  122,    0},
-        {  30,   54,   78,  102,  126,    0},
-        {  26,   52,   78,  104,  130,    0},
-        {  30,   56,   82,  108,  134,    0},
-        {  34,   60,   86,  112,  138,    0},
-        {  30,   58,   86,  114,  142,    0},
-        {  34,   62,   90,  118,  146,    0},
-        {  30,   54,   78,  102,  126,  150},
-        {  24,   50,   76,  102,  128,  154},
-        {  28,   54,   80,  106,  132,  158},
-        {  32,   58,   84,  110,  136,  162},
-        {  26,   54,   82,  110,  138,  166},
-        {  30,   58,   86,  114,  142,  170}
+#include "Tables/alignment.inc"
     };
     return data[version - 2];
 }
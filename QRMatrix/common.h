@@ -25,8 +25,8 @@
 
 #include "constants.h"
 
-/// Maximum QR version
-#define QR_MAX_VERSION          40
+/// Maximum QR version (of this build: `QRM_MAX_VERSION`)
+#define QR_MAX_VERSION          QRM_MAX_VERSION
 /// Different dimension amount between 2 sequential versions
 #define QR_VERSION_OFFSET       4
 /// QR minimum dimension
@@ -69,9 +69,10 @@ unsigned int QrmInfoECCodewordsTotalCount(QrmSymbolInfo info);
 /// @ref: https://www.thonky.com/qr-code-tutorial/error-correction-table.
 QrmSymbolInfo QrmGetSymbolInfo(UnsignedByte version, QrmErrorCorrectionLevel level, bool isMicro);
 
-/// Current environment
-extern bool qrmIsEnvValid;
-extern bool qrmIsLittleEndian;
+/// Current environment (constants, checked at compile time)
+extern const bool qrmIsEnvValid;
+extern const bool qrmIsLittleEndian;
+/// Kept for compatibility: does nothing.
 void QrmCheckEnv(void);
 
 /// Get QR dimension by its version (version in 1...40 ~ dimension 21...177, Micro version in 1...4 ~ dimension 11...17).
@@ -138,6 +139,19 @@ bool QrmCopyBits(
     unsigned int count
 );
 
+/// Copy `count` lowest bits of `value` (highest bit first) into `destination` stating from bit at `destStartIndex`.
+/// Bits are extracted by shifting, so the result does not depend on host byte order.
+bool QrmCopyValueBits(
+    /// Source value.
+    Unsigned4Bytes value,
+    /// Number of bits to be copied (1...32).
+    unsigned int count,
+    /// Destination (bytes array).
+    UnsignedByte* destination,
+    /// Destintation starting bit index.
+    unsigned int destStartIndex
+);
+
 /// Return array of 6 items contains QR aligment locations for version 2...40
 const UnsignedByte* QrmGetAlignmentLocations(UnsignedByte version);
 
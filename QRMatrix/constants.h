@@ -25,6 +25,44 @@
 
 #define LOGABLE 0
 #define LOG_MEM 0
+/// Byte order of target: 1 = little endian, 0 = big endian.
+/// Detected at compile time (GCC, Clang: `__BYTE_ORDER__`; others are assumed little endian), define to override.
+/// Only reported by `qrmIsLittleEndian`: encoders extract bytes by shifting values, so their output does not depend on it.
+#ifndef QRM_LITTLE_ENDIAN
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define QRM_LITTLE_ENDIAN 0
+#else
+#define QRM_LITTLE_ENDIAN 1
+#endif
+#endif
+/// Instrumentation (`QRMatrix/Stats`): build with `-DQRM_STATS=1` & compile `QRMatrix/Stats/stats.c`
+#ifndef QRM_STATS
+#define QRM_STATS 0
+#endif
+/// Embedded profile: maximum QR version (1...40) of this build (tables of bigger versions are not compiled).
+#ifndef QRM_MAX_VERSION
+#define QRM_MAX_VERSION 40
+#endif
+/// Embedded profile: 1 = default allocator uses static memory of `QRM_HEAP_SIZE` bytes instead of `calloc` & `free`.
+/// The static memory is shared by all threads (guarded by a spin lock): concurrent encoders & board caches need
+/// `QRM_HEAP_SIZE` for every symbol being encoded at the same time.
+#ifndef QRM_NO_HEAP
+#define QRM_NO_HEAP 0
+#endif
+/// Embedded profile: 1 = no Kanji mode (Shift JIS maps are not compiled).
+#ifndef QRM_NO_KANJI
+#define QRM_NO_KANJI 0
+#endif
+/// Embedded profile: 1 = no MicroQR.
+#ifndef QRM_NO_MICRO
+#define QRM_NO_MICRO 0
+#endif
+/// Static memory of `QRM_NO_HEAP` build (bytes): enough to encode a symbol of `QRM_MAX_VERSION` (dimension `d`):
+/// 2 boards (`d` rows of `d` cells + block headers) and codewords, EC & polynomials (about `d² / 2`).
+/// Define to override (see `QrmGetHeapPeak`).
+#ifndef QRM_HEAP_SIZE
+#define QRM_HEAP_SIZE (2 * (17 + 4 * QRM_MAX_VERSION) * (57 + 4 * QRM_MAX_VERSION) + (17 + 4 * QRM_MAX_VERSION) * (17 + 4 * QRM_MAX_VERSION) / 2 + 2048)
+#endif
 
 #if LOGABLE
 
@@ -61,25 +99,44 @@
 
 #endif
 
+#if QRM_STATS
+
+#define STATS_BEGIN(V);             unsigned long long V = QrmStatsClock();
+#define STATS_END(S, V);            QrmStatsAddStageTime(S, QrmStatsClock() - V);
+#define STATS_SEGMENT(M);           QrmStatsAddSegment(M);
+#define STATS_SYMBOL(V, L, I, M);   QrmStatsAddSymbol(V, L, I, M);
+#define STATS_ALLOC(L, S);          QrmStatsAddAllocation((unsigned long long)(L) * (S));
+
+#else
+
+#define STATS_BEGIN(V);
+#define STATS_END(S, V);
+#define STATS_SEGMENT(M);
+#define STATS_SYMBOL(V, L, I, M);
+#define STATS_ALLOC(L, S);
+
+#endif
+
 #if LOGABLE && LOG_MEM
 
-#define ALLOC(T, V, L);     T* V = (T*)calloc(L, sizeof(T)); printf("📌 ALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T));
-#define ALLOC_(T, V, L);    V = (T*)calloc(L, sizeof(T)); printf("📌 ALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T));
-#define REALLOC(T, V, L);   V = (T*)realloc(V, L * sizeof(T)); printf("📌 REALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T));
-#define DEALLOC(V);         printf("📌 DEALLOC [%d] %s: %p 🏁\n", __LINE__, __FUNCTION__, V); free(V); V = NULL;
+#define ALLOC(T, V, L);     T* V = (T*)QrmAlloc(L, sizeof(T)); printf("📌 ALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define ALLOC_(T, V, L);    V = (T*)QrmAlloc(L, sizeof(T)); printf("📌 ALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define REALLOC(T, V, L);   V = (T*)QrmRealloc(V, L * sizeof(T)); printf("📌 REALLOC [%d] %s: %p (%d x %lu = %lu) 🏁\n", __LINE__, __FUNCTION__, V, L, sizeof(T), L * sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define DEALLOC(V);         printf("📌 DEALLOC [%d] %s: %p 🏁\n", __LINE__, __FUNCTION__, V); QrmFree(V); V = NULL;
 
 #else
 
-#define ALLOC(T, V, L);     T* V = (T*)calloc(L, sizeof(T));
-#define ALLOC_(T, V, L);    V = (T*)calloc(L, sizeof(T));
-#define REALLOC(T, V, L);   V = (T*)realloc(V, L * sizeof(T));
-#define DEALLOC(V);         free(V); V = NULL;
+#define ALLOC(T, V, L);     T* V = (T*)QrmAlloc(L, sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define ALLOC_(T, V, L);    V = (T*)QrmAlloc(L, sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define REALLOC(T, V, L);   V = (T*)QrmRealloc(V, L * sizeof(T)); STATS_ALLOC(L, sizeof(T))
+#define DEALLOC(V);         QrmFree(V); V = NULL;
 
 #endif
 
 #define VERSION "1.1.0"
 
 #include <stdbool.h>
+#include <stddef.h>
 
 typedef unsigned char UnsignedByte;
 typedef unsigned short Unsigned2Bytes;
@@ -109,4 +166,44 @@ typedef enum {
     ELevelHigh = 0b10
 } QrmErrorCorrectionLevel;
 
+/// Memory allocator used by `ALLOC`, `ALLOC_`, `REALLOC` & `DEALLOC` (all memory of QRMatrix).
+/// Memory must be released by the allocator which allocated it
+/// (including memory returned to you, eg. boards, segments, arrays of `QrmEncoderMakeStructuredAppend`).
+typedef struct {
+    /// User data passed to functions
+    void* context;
+    /// As `calloc`: zero filled memory of `count * size` bytes (NULL if failed)
+    void* (*allocate)(void* context, size_t count, size_t size);
+    /// As `realloc`
+    void* (*reallocate)(void* context, void* pointer, size_t size);
+    /// As `free` (`pointer` may be NULL)
+    void (*release)(void* context, void* pointer);
+} QrmAllocator;
+
+/// `calloc`, `realloc` & `free`
+/// (`QRM_NO_HEAP`: first fit allocator on static memory of `QRM_HEAP_SIZE` bytes, thread safe by a spin lock).
+QrmAllocator QrmAllocatorCreateDefault(void);
+/// Set global allocator. Call before any other function of QRMatrix (not thread safe).
+void QrmSetAllocator(QrmAllocator allocator);
+/// Override global allocator on current thread (eg. arena of a request).
+/// Pass allocator with NULL functions to remove override.
+/// Memory must be released with the allocator which allocated it: do not pass objects across threads with different overrides.
+/// (`QrmThreadPoolRun` tasks use the allocator of the calling thread; `QrmBoardCache` uses the allocator of the thread which created it.)
+/// @return Previous override (allocator with NULL functions if none).
+QrmAllocator QrmSetThreadAllocator(QrmAllocator allocator);
+/// Allocator of current thread (override or global allocator)
+QrmAllocator QrmGetAllocator(void);
+/// Allocate / reallocate / release using allocator of current thread
+void* QrmAlloc(size_t count, size_t size);
+void* QrmRealloc(void* pointer, size_t size);
+void QrmFree(void* pointer);
+#if QRM_NO_HEAP
+/// Maximum number of bytes of static memory used so far (including block headers), to tune `QRM_HEAP_SIZE`.
+size_t QrmGetHeapPeak(void);
+#endif
+
+#if QRM_STATS
+#include "Stats/stats.h"
+#endif
+
 #endif // CONSTANTS_H
@@ -0,0 +1,303 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef QRMATRIX_HPP
+#define QRMATRIX_HPP
+
+// C++20 wrapper of QRMatrix (header only): owning types release their memory, views do not copy.
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+extern "C" {
+#include "qrmatrixencoder.h"
+}
+
+namespace qrm {
+
+/// Error correction level
+enum class Level {
+    L = ELevelLow,
+    M = ELevelMedium,
+    Q = ELevelQuarter,
+    H = ELevelHigh
+};
+
+/// Segment encoding mode
+enum class Mode {
+    Numeric = EModeNumeric,
+    AlphaNumeric = EModeAlphaNumeric,
+    Byte = EModeByte,
+    Kanji = EModeKanji
+};
+
+enum class Error {
+    /// Data can not be encoded by given mode (or is too long)
+    InvalidData,
+    /// Invalid option (eg. FNC1 Second Position Application Indicator)
+    InvalidArgument,
+    /// Encoder failed (eg. data does not fit any version, level is not supported by MicroQR)
+    EncodingFailed
+};
+
+/// Value or error (subset of `std::expected`).
+template <typename T>
+class Result {
+public:
+    Result(T value) noexcept(std::is_nothrow_move_constructible_v<T>) : storage(std::in_place_index<0>, std::move(value)) {}
+    Result(Error error) noexcept : storage(std::in_place_index<1>, error) {}
+
+    bool has_value() const noexcept { return storage.index() == 0; }
+    explicit operator bool() const noexcept { return has_value(); }
+    /// Throws `std::bad_variant_access` if there is no value.
+    T& value() & { return std::get<0>(storage); }
+    const T& value() const & { return std::get<0>(storage); }
+    T&& value() && { return std::get<0>(std::move(storage)); }
+    /// Undefined if there is a value.
+    Error error() const noexcept { return *std::get_if<1>(&storage); }
+    /// Undefined if there is no value.
+    T& operator*() & noexcept { return *std::get_if<0>(&storage); }
+    const T& operator*() const & noexcept { return *std::get_if<0>(&storage); }
+    T&& operator*() && noexcept { return std::move(*std::get_if<0>(&storage)); }
+    T* operator->() noexcept { return std::get_if<0>(&storage); }
+    const T* operator->() const noexcept { return std::get_if<0>(&storage); }
+
+private:
+    std::variant<T, Error> storage;
+};
+
+// SEGMENT ==========================================================================================================================================
+
+/// Data segment which refers to given bytes (nothing is copied nor allocated):
+/// bytes must outlive the segment.
+class Segment {
+public:
+    /// Check bytes (like `QrmSegCreate`) & make segment of them.
+    static Result<Segment> create(Mode mode, std::span<const std::byte> data, unsigned int eci = DEFAULT_ECI_ASSIGMENT) noexcept {
+        if (data.size() > UINT_MAX) {
+            return Error::InvalidData;
+        }
+        const UnsignedByte* bytes = reinterpret_cast<const UnsignedByte*>(data.data());
+        unsigned int length = static_cast<unsigned int>(data.size());
+        if (!QrmSegValidate(static_cast<QrmEncodingMode>(mode), bytes, length)) {
+            return Error::InvalidData;
+        }
+        // Encoder only reads segment data
+        return Segment(QrmSegment { static_cast<QrmEncodingMode>(mode), length, const_cast<UnsignedByte*>(bytes), eci });
+    }
+
+    static Result<Segment> create(Mode mode, std::string_view text, unsigned int eci = DEFAULT_ECI_ASSIGMENT) noexcept {
+        return create(mode, std::as_bytes(std::span<const char>(text)), eci);
+    }
+
+    Mode mode() const noexcept { return static_cast<Mode>(segment.mode); }
+    unsigned int eci() const noexcept { return segment.eci; }
+    std::span<const std::byte> data() const noexcept {
+        return { reinterpret_cast<const std::byte*>(segment.data), segment.length };
+    }
+    /// C segment (must not be destroyed by `QrmSegDestroy`).
+    const QrmSegment& get() const noexcept { return segment; }
+
+private:
+    explicit Segment(QrmSegment segment) noexcept : segment(segment) {}
+
+    QrmSegment segment;
+};
+
+// EXTRA MODE =======================================================================================================================================
+
+/// Extra mode (stored by value: nothing is allocated).
+class Extra {
+public:
+    Extra() noexcept : mode(XModeNone), appIndicator { 0, 0 }, appIndicatorLength(0) {}
+
+    static Extra none() noexcept { return Extra(); }
+    static Extra microQr() noexcept { return Extra(XModeMicroQr); }
+    static Extra fnc1First() noexcept { return Extra(XModeFnc1First); }
+    /// Application Indicator: single ASCII letter (eg. `a`) or 2 digits number (eg. `01`).
+    static Result<Extra> fnc1Second(std::string_view appIndicator) noexcept {
+        bool isValid = false;
+        if (appIndicator.size() == 1) {
+            char letter = appIndicator[0];
+            isValid = (letter >= 'a' && letter <= 'z') || (letter >= 'A' && letter <= 'Z');
+        } else if (appIndicator.size() == 2) {
+            isValid = appIndicator[0] >= '0' && appIndicator[0] <= '9' && appIndicator[1] >= '0' && appIndicator[1] <= '9';
+        }
+        if (!isValid) {
+            return Error::InvalidArgument;
+        }
+        Extra result(XModeFnc1Second);
+        for (std::size_t index = 0; index < appIndicator.size(); index += 1) {
+            result.appIndicator[index] = static_cast<UnsignedByte>(appIndicator[index]);
+        }
+        result.appIndicatorLength = static_cast<UnsignedByte>(appIndicator.size());
+        return result;
+    }
+
+    bool isMicro() const noexcept { return mode == XModeMicroQr; }
+    /// C extra mode info which refers to this object (must not be destroyed by `QrmExtraDestroy`).
+    QrmExtraEncodingInfo get() const noexcept {
+        return QrmExtraEncodingInfo { mode, const_cast<UnsignedByte*>(appIndicator), appIndicatorLength };
+    }
+
+private:
+    explicit Extra(QrmExtraMode mode) noexcept : mode(mode), appIndicator { 0, 0 }, appIndicatorLength(0) {}
+
+    QrmExtraMode mode;
+    UnsignedByte appIndicator[2];
+    UnsignedByte appIndicatorLength;
+};
+
+// BOARD ============================================================================================================================================
+
+/// QR board (move only; released when destroyed).
+class Board {
+public:
+    Board() noexcept : board { 0, nullptr } {}
+    /// Take ownership of C board.
+    explicit Board(QrmBoard board) noexcept : board(board) {}
+    Board(Board&& other) noexcept : board(std::exchange(other.board, QrmBoard { 0, nullptr })) {}
+    Board& operator=(Board&& other) noexcept {
+        if (this != &other) {
+            QrmBoardDestroy(&board);
+            board = std::exchange(other.board, QrmBoard { 0, nullptr });
+        }
+        return *this;
+    }
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
+    ~Board() { QrmBoardDestroy(&board); }
+
+    /// Deep copy (explicit, as it allocates).
+    Board duplicate() const { return Board(QrmBoardDuplicate(board)); }
+
+    UnsignedByte dimension() const noexcept { return board.dimension; }
+    bool empty() const noexcept { return board.dimension == 0; }
+    /// Cells of a row (see `QrmBoardCell`).
+    std::span<const UnsignedByte> row(UnsignedByte index) const noexcept { return { board.buffer[index], board.dimension }; }
+    /// All rows (range of `row`).
+    auto rows() const noexcept {
+        return std::views::iota(0u, static_cast<unsigned int>(board.dimension))
+            | std::views::transform([this](unsigned int index) { return row(static_cast<UnsignedByte>(index)); });
+    }
+    /// Is module dark.
+    bool isSet(UnsignedByte row, UnsignedByte column) const noexcept {
+        return (board.buffer[row][column] & CellLowMask) == CellSet;
+    }
+
+    /// Number of bytes per row of packed modules.
+    unsigned int packedRowLength() const noexcept { return (board.dimension + 7u) / 8u; }
+    /// Write modules row by row, 1 bit per module, most significant bit first (1 = dark)
+    /// (module plane of `QrmBoardView`).
+    /// @return false if `destination` is smaller than `packedRowLength() * dimension()` bytes.
+    bool pack(std::span<UnsignedByte> destination) const noexcept {
+        unsigned int rowLength = packedRowLength();
+        if (destination.size() < static_cast<std::size_t>(rowLength) * board.dimension) {
+            return false;
+        }
+        for (unsigned int row = 0; row < board.dimension; row += 1) {
+            UnsignedByte* output = destination.data() + row * rowLength;
+            for (unsigned int index = 0; index < rowLength; index += 1) {
+                output[index] = 0;
+            }
+            for (unsigned int column = 0; column < board.dimension; column += 1) {
+                if ((board.buffer[row][column] & CellLowMask) == CellSet) {
+                    output[column >> 3] |= static_cast<UnsignedByte>(0x80 >> (column & 7));
+                }
+            }
+        }
+        return true;
+    }
+    /// `pack` into new buffer.
+    std::vector<UnsignedByte> packed() const {
+        std::vector<UnsignedByte> result(static_cast<std::size_t>(packedRowLength()) * board.dimension);
+        pack(result);
+        return result;
+    }
+
+    /// C board (still owned by this object).
+    const QrmBoard& get() const noexcept { return board; }
+    /// Give up ownership: result must be deleted by `QrmBoardDestroy`.
+    QrmBoard release() noexcept { return std::exchange(board, QrmBoard { 0, nullptr }); }
+
+private:
+    QrmBoard board;
+};
+
+// ENCODER ==========================================================================================================================================
+
+/// Encode single QR symbol (see `QrmEncoderEncode`).
+/// Allocates the same as C API (segment data & extra mode are not copied;
+/// segment headers are copied on stack, or to 1 more allocation if there are more than 16 segments).
+inline Result<Board> encode(
+    std::span<const Segment> segments,
+    Level level,
+    Extra extra = Extra(),
+    /// Optional. Minimum version
+    UnsignedByte minVersion = 0,
+    /// Optional. Force to use given mask (0-7)
+    UnsignedByte maskId = 0xFF
+) noexcept {
+    if (segments.empty() || segments.size() > UINT_MAX) {
+        return Error::InvalidArgument;
+    }
+    // Encoder takes an array of `QrmSegment` (an array of `Segment` must not be accessed as such)
+    constexpr std::size_t stackCount = 16;
+    QrmSegment stackSegments[stackCount];
+    QrmSegment* cSegments = stackSegments;
+    if (segments.size() > stackCount) {
+        cSegments = static_cast<QrmSegment*>(QrmAlloc(segments.size(), sizeof(QrmSegment)));
+        if (cSegments == nullptr) {
+            return Error::EncodingFailed;
+        }
+    }
+    for (std::size_t index = 0; index < segments.size(); index += 1) {
+        cSegments[index] = segments[index].get();
+    }
+    QrmBoard board = QrmEncoderEncode(
+        cSegments, static_cast<unsigned int>(segments.size()),
+        static_cast<QrmErrorCorrectionLevel>(level), extra.get(), minVersion, maskId
+    );
+    if (cSegments != stackSegments) {
+        QrmFree(cSegments);
+    }
+    if (board.dimension == 0) {
+        return Error::EncodingFailed;
+    }
+    return Board(board);
+}
+
+inline Result<Board> encode(const Segment& segment, Level level, Extra extra = Extra(), UnsignedByte minVersion = 0, UnsignedByte maskId = 0xFF) noexcept {
+    return encode(std::span<const Segment>(&segment, 1), level, extra, minVersion, maskId);
+}
+
+} // namespace qrm
+
+#endif // QRMATRIX_HPP
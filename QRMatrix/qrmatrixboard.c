@@ -68,6 +68,31 @@ UnsignedByte QrmBoard_remainderBitsLength(UnsignedByte version) {
     return 0;
 }
 
+/// Release `count` rows & array of rows
+void QrmBoard_destroyRows(UnsignedByte** rows, UnsignedByte count) {
+    for (UnsignedByte row = 0; row < count; row += 1) {
+        DEALLOC(rows[row]);
+    }
+    DEALLOC(rows);
+}
+
+/// Allocate `dimension` rows of `dimension` cells (zero filled).
+/// @return NULL if out of memory
+UnsignedByte** QrmBoard_createRows(UnsignedByte dimension) {
+    ALLOC(UnsignedByte*, result, dimension);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (UnsignedByte row = 0; row < dimension; row += 1) {
+        ALLOC_(UnsignedByte, result[row], dimension);
+        if (result[row] == NULL) {
+            QrmBoard_destroyRows(result, row);
+            return NULL;
+        }
+    }
+    return result;
+}
+
 // Initinalize QR =============================================================================================
 
 void QrmBoard_addFinderPattern(QrmBoard board, UnsignedByte row, UnsignedByte column) {
@@ -348,11 +373,10 @@ void QrmBoard_placeData(
 
 // Masking QR board =============================================================================================
 
-UnsignedByte** QrmBoard_mask(QrmBoard board, UnsignedByte maskNum) {
-    ALLOC(UnsignedByte*, result, board.dimension);
+/// Write `board` masked by `maskNum` into `result` (`dimension` rows; can be `board.buffer` to mask in place).
+void QrmBoard_maskInto(QrmBoard board, UnsignedByte maskNum, UnsignedByte** result) {
     UnsignedByte** buffer = board.buffer;
     for (UnsignedByte row = 0; row < board.dimension; row += 1) {
-        ALLOC_(UnsignedByte, result[row], board.dimension);
         for (UnsignedByte column = 0; column < board.dimension; column += 1) {
             UnsignedByte byte = buffer[row][column];
             UnsignedByte low = byte & CellLowMask;
@@ -428,6 +452,14 @@ UnsignedByte** QrmBoard_mask(QrmBoard board, UnsignedByte maskNum) {
             }
         }
     }
+}
+
+/// @return Masked copy of `board` (NULL if out of memory)
+UnsignedByte** QrmBoard_mask(QrmBoard board, UnsignedByte maskNum) {
+    UnsignedByte** result = QrmBoard_createRows(board.dimension);
+    if (result != NULL) {
+        QrmBoard_maskInto(board, maskNum, result);
+    }
     return result;
 }
 
@@ -607,30 +639,29 @@ unsigned int QrmBoard_evaluateMicro(UnsignedByte dimension, UnsignedByte** maske
     return sum2 * 16 + sum1;
 }
 
+/// Apply given mask or the best one to `board`.
+/// @return Applied mask ID (0xFF if out of memory: `board` is not masked)
 UnsignedByte QrmBoard_evaluate(QrmBoard board, UnsignedByte maskId, bool isMicro) {
-    static UnsignedByte microMaskIdMap[4] = {1, 4, 6, 7};
+#if QRM_NO_MICRO
+    isMicro = false; // Let compiler drop MicroQR code
+#endif
+    static const UnsignedByte microMaskIdMap[4] = {1, 4, 6, 7};
     bool isCustomMask = isMicro ? (maskId < 4) : (maskId < 8);
     if (isCustomMask) {
 #if LOGABLE
     LOG("MASKED ID: %d", maskId);
 #endif
         UnsignedByte mId = isMicro ? microMaskIdMap[maskId] : maskId;
-        UnsignedByte** mBoard = QrmBoard_mask(board, mId);
-        UnsignedByte** buffer = board.buffer;
-        for (UnsignedByte row = 0; row < board.dimension; row += 1) {
-            for (UnsignedByte column = 0; column < board.dimension; column += 1) {
-                buffer[row][column] = mBoard[row][column];
-            }
-        }
-        for (UnsignedByte row = 0; row < board.dimension; row += 1) {
-            DEALLOC(mBoard[row]);
-        }
-        DEALLOC(mBoard);
+        QrmBoard_maskInto(board, mId, board.buffer);
         return maskId;
     }
 
+    // Masks are evaluated one by one on the same scratch board, then the best one is applied to `board`
     UnsignedByte numMasks = isMicro ? 4 : 8;
-    UnsignedByte** maskedBoard[numMasks];
+    UnsignedByte** maskedBoard = QrmBoard_mask(board, isMicro ? microMaskIdMap[0] : 0);
+    if (maskedBoard == NULL) {
+        return 0xFF;
+    }
     unsigned int minScore = 0;
     UnsignedByte minId = 0;
     unsigned int maxScore = 0;
@@ -640,13 +671,15 @@ UnsignedByte QrmBoard_evaluate(QrmBoard board, UnsignedByte maskId, bool isMicro
 #endif
     for (UnsignedByte index = 0; index < numMasks; index += 1) {
         UnsignedByte mId = isMicro ? microMaskIdMap[index] : index;
-        maskedBoard[index] = QrmBoard_mask(board, mId);
+        if (index > 0) {
+            QrmBoard_maskInto(board, mId, maskedBoard);
+        }
         unsigned int score = isMicro ?
-            QrmBoard_evaluateMicro(board.dimension, maskedBoard[index]) :
-            QrmBoard_evaluateCondition1(board.dimension, maskedBoard[index]) +
-            QrmBoard_evaluateCondition2(board.dimension, maskedBoard[index]) +
-            QrmBoard_evaluateCondition3(board.dimension, maskedBoard[index]) +
-            QrmBoard_evaluateCondition4(board.dimension, maskedBoard[index]);
+            QrmBoard_evaluateMicro(board.dimension, maskedBoard) :
+            QrmBoard_evaluateCondition1(board.dimension, maskedBoard) +
+            QrmBoard_evaluateCondition2(board.dimension, maskedBoard) +
+            QrmBoard_evaluateCondition3(board.dimension, maskedBoard) +
+            QrmBoard_evaluateCondition4(board.dimension, maskedBoard);
 #if LOGABLE
         LOG("MASK [%d]: %d", index, score);
 #endif
@@ -666,19 +699,8 @@ UnsignedByte QrmBoard_evaluate(QrmBoard board, UnsignedByte maskId, bool isMicro
     LOG("MASKED ID: %d", lasId);
 #endif
 
-    UnsignedByte** buffer = board.buffer;
-    for (UnsignedByte row = 0; row < board.dimension; row += 1) {
-        for (UnsignedByte column = 0; column < board.dimension; column += 1) {
-            buffer[row][column] = maskedBoard[lasId][row][column];
-        }
-    }
-
-    for (UnsignedByte index = 0; index < numMasks; index += 1) {
-        for (UnsignedByte row = 0; row < board.dimension; row += 1) {
-            DEALLOC(maskedBoard[index][row])
-        }
-        DEALLOC(maskedBoard[index]);
-    }
+    QrmBoard_destroyRows(maskedBoard, board.dimension);
+    QrmBoard_maskInto(board, isMicro ? microMaskIdMap[lasId] : lasId, board.buffer);
 
     return lasId;
 }
@@ -686,25 +708,16 @@ UnsignedByte QrmBoard_evaluate(QrmBoard board, UnsignedByte maskId, bool isMicro
 // Version & format =============================================================================================
 
 void QrmBoard_getFormatBits(QrmErrorCorrectionLevel level, UnsignedByte maskId, UnsignedByte* buffer) {
-    static Unsigned2Bytes typeFormats[] = {
-        0b1010100000100100, 0b1010001001001010, 0b1011110011111000, 0b1011011010010110, 0b1000101111110010, 0b1000000110011100, 0b1001111100101110, 0b1001010101000000,
-        0b1110111110001000, 0b1110010111100110, 0b1111101101010100, 0b1111000100111010, 0b1100110001011110, 0b1100011000110000, 0b1101100010000010, 0b1101001011101100,
-        0b0010110100010010, 0b0010011101111100, 0b0011100111001110, 0b0011001110100000, 0b0000111011000100, 0b0000010010101010, 0b0001101000011000, 0b0001000001110110,
-        0b0110101010111110, 0b0110000011010000, 0b0111111001100010, 0b0111010000001100, 0b0100100101101000, 0b0100001100000110, 0b0101110110110100, 0b0101011111011010
+    static const Unsigned2Bytes typeFormats[] = {
+#include "Tables/formatbits.inc"
     };
 
     UnsignedByte index = level << 3;
     index |= maskId;
 
     Unsigned2Bytes value = typeFormats[index];
-    UnsignedByte* valuePtr = (UnsignedByte*)&value;
-    if (qrmIsLittleEndian) {
-        buffer[0] = valuePtr[1];
-        buffer[1] = valuePtr[0];
-    } else {
-        buffer[0] = valuePtr[0];
-        buffer[1] = valuePtr[1];
-    }
+    buffer[0] = (UnsignedByte)(value >> 8);
+    buffer[1] = (UnsignedByte)value;
 #if LOGABLE
     LOG("Format payload:");
     LOG_BIN(buffer, 2);
@@ -712,7 +725,7 @@ void QrmBoard_getFormatBits(QrmErrorCorrectionLevel level, UnsignedByte maskId,
 }
 
 void QrmBoard_getMicroFormatBits(QrmErrorCorrectionLevel level, UnsignedByte version, UnsignedByte maskId, UnsignedByte* buffer) {
-    static Unsigned2Bytes typeFormats[] = {
+    static const Unsigned2Bytes typeFormats[] = {
         0b1000100010001010, 0b1000001011100100, 0b1001110001010110, 0b1001011000111000, 0b1010101101011100, 0b1010000100110010, 0b1011111110000000, 0b1011010111101110,
         0b1100111100100110, 0b1100010101001000, 0b1101101111111010, 0b1101000110010100, 0b1110110011110000, 0b1110011010011110, 0b1111100000101100, 0b1111001001000010,
         0b0000110110111100, 0b0000011111010010, 0b0001100101100000, 0b0001001100001110, 0b0010111001101010, 0b0010010000000100, 0b0011101010110110, 0b0011000011011000,
@@ -722,14 +735,8 @@ void QrmBoard_getMicroFormatBits(QrmErrorCorrectionLevel level, UnsignedByte ver
     index = index << 2;
     index |= maskId;
     Unsigned2Bytes value = typeFormats[index];
-    UnsignedByte* valuePtr = (UnsignedByte*)&value;
-    if (qrmIsLittleEndian) {
-        buffer[0] = valuePtr[1];
-        buffer[1] = valuePtr[0];
-    } else {
-        buffer[0] = valuePtr[0];
-        buffer[1] = valuePtr[1];
-    }
+    buffer[0] = (UnsignedByte)(value >> 8);
+    buffer[1] = (UnsignedByte)value;
 #if LOGABLE
     LOG("Micro Format payload:");
     LOG_BIN(buffer, 2);
@@ -737,54 +744,14 @@ void QrmBoard_getMicroFormatBits(QrmErrorCorrectionLevel level, UnsignedByte ver
 }
 
 void QrmBoard_getVersionBits(UnsignedByte version, UnsignedByte* buffer) {
-    static Unsigned4Bytes versions[34] = {
-        0b00011111001001010000000000000000,
-        0b00100001011011110000000000000000,
-        0b00100110101001100100000000000000,
-        0b00101001001101001100000000000000,
-        0b00101110111111011000000000000000,
-        0b00110001110110001000000000000000,
-        0b00110110000100011100000000000000,
-        0b00111001100000110100000000000000,
-        0b00111110010010100000000000000000,
-        0b01000010110111100000000000000000,
-        0b01000101000101110100000000000000,
-        0b01001010100001011100000000000000,
-        0b01001101010011001000000000000000,
-        0b01010010011010011000000000000000,
-        0b01010101101000001100000000000000,
-        0b01011010001100100100000000000000,
-        0b01011101111110110000000000000000,
-        0b01100011101100010000000000000000,
-        0b01100100011110000100000000000000,
-        0b01101011111010101100000000000000,
-        0b01101100001000111000000000000000,
-        0b01110011000001101000000000000000,
-        0b01110100110011111100000000000000,
-        0b01111011010111010100000000000000,
-        0b01111100100101000000000000000000,
-        0b10000010011101010100000000000000,
-        0b10000101101111000000000000000000,
-        0b10001010001011101000000000000000,
-        0b10001101111001111100000000000000,
-        0b10010010110000101100000000000000,
-        0b10010101000010111000000000000000,
-        0b10011010100110010000000000000000,
-        0b10011101010100000100000000000000,
-        0b10100011000110100100000000000000,
+    static const Unsigned4Bytes versions[] = {
+#include "Tables/versionbits.inc"
     };
 
     Unsigned4Bytes value = versions[version - 7];
-    UnsignedByte* valuePtr = (UnsignedByte*)&value;
-    if (qrmIsLittleEndian) {
-        buffer[0] = valuePtr[3];
-        buffer[1] = valuePtr[2];
-        buffer[2] = valuePtr[1];
-    } else {
-        buffer[0] = valuePtr[0];
-        buffer[1] = valuePtr[1];
-        buffer[2] = valuePtr[2];
-    }
+    buffer[0] = (UnsignedByte)(value >> 24);
+    buffer[1] = (UnsignedByte)(value >> 16);
+    buffer[2] = (UnsignedByte)(value >> 8);
 
 #if LOGABLE
     LOG("Version payload:");
@@ -896,28 +863,25 @@ void QrmBoard_placeFormatAndVersion(QrmBoard board, UnsignedByte maskId, QrmSymb
 
 void QrmBoardDestroy(QrmBoard* board) {
     if (board->buffer != NULL && board->dimension > 0) {
-        for (UnsignedByte index = 0; index < board->dimension; index += 1) {
-            DEALLOC(board->buffer[index]);
-        }
-        DEALLOC(board->buffer);
+        QrmBoard_destroyRows(board->buffer, board->dimension);
+        board->buffer = NULL;
         board->dimension = 0;
     }
 }
 
 QrmBoard QrmBoardDuplicate(QrmBoard other) {
-    QrmBoard result;
+    QrmBoard result = QrmBoardCreateEmpty();
     if (other.dimension > 0 && other.buffer != NULL) {
+        result.buffer = QrmBoard_createRows(other.dimension);
+        if (result.buffer == NULL) {
+            return result;
+        }
         result.dimension = other.dimension;
-        ALLOC_(UnsignedByte*, result.buffer, result.dimension);
         for (UnsignedByte index = 0; index < result.dimension; index += 1) {
-            ALLOC_(UnsignedByte, result.buffer[index], result.dimension);
             for (UnsignedByte jndex = 0; jndex < result.dimension; jndex += 1) {
                 result.buffer[index][jndex] = other.buffer[index][jndex];
             }
         }
-    } else {
-        result.buffer = NULL;
-        result.dimension = 0;
     }
 
     return result;
@@ -926,10 +890,12 @@ QrmBoard QrmBoardDuplicate(QrmBoard other) {
 void QrmBoardCopy(QrmBoard* board, QrmBoard other) {
     QrmBoardDestroy(board);
     if (other.dimension > 0 && other.buffer != NULL) {
+        board->buffer = QrmBoard_createRows(other.dimension);
+        if (board->buffer == NULL) {
+            return;
+        }
         board->dimension = other.dimension;
-        ALLOC_(UnsignedByte*, board->buffer, board->dimension);
         for (UnsignedByte index = 0; index < board->dimension; index += 1) {
-            ALLOC_(UnsignedByte, board->buffer[index], board->dimension);
             for (UnsignedByte jndex = 0; jndex < board->dimension; jndex += 1) {
                 board->buffer[index][jndex] = other.buffer[index][jndex];
             }
@@ -945,11 +911,19 @@ QrmBoard QrmBoardCreateEmpty() {
 }
 
 QrmBoard QrmBoardCreate(UnsignedByte* data, UnsignedByte* errorCorrection, QrmSymbolInfo ecInfo, UnsignedByte maskId, bool isMicro){
-    QrmBoard result;
-    result.dimension = QrmGetDimensionByVersion(ecInfo.version, isMicro);
-    ALLOC_(UnsignedByte*, result.buffer, result.dimension);
+#if QRM_NO_MICRO
+    isMicro = false; // MicroQR symbols are rejected by `QrmGetSymbolInfo`; let compiler drop MicroQR code
+#endif
+    STATS_BEGIN(functionStart);
+    QrmBoard result = QrmBoardCreateEmpty();
+    UnsignedByte dimension = QrmGetDimensionByVersion(ecInfo.version, isMicro);
+    result.buffer = QrmBoard_createRows(dimension);
+    if (result.buffer == NULL) {
+        LOG("ERROR: Out of memory.");
+        return result;
+    }
+    result.dimension = dimension;
     for (UnsignedByte index = 0; index < result.dimension; index += 1) {
-        ALLOC_(UnsignedByte, result.buffer[index], result.dimension);
         for (UnsignedByte jndex = 0; jndex < result.dimension; jndex += 1) {
             result.buffer[index][jndex] = CellNeutral;
         }
@@ -965,20 +939,162 @@ QrmBoard QrmBoardCreate(UnsignedByte* data, UnsignedByte* errorCorrection, QrmSy
     } else {
         QrmBoard_addDarkAndReservedAreas(result, ecInfo);
     }
+    STATS_END(StatsStageFunctionPatterns, functionStart);
+    STATS_BEGIN(placementStart);
     QrmBoard_placeData(
         result, data, errorCorrection, ecInfo,
         isMicro ? 0 : QrmBoard_remainderBitsLength(ecInfo.version),
         isMicro
         );
+    STATS_END(StatsStagePlacement, placementStart);
+    STATS_BEGIN(maskStart);
     UnsignedByte lastMaskId = QrmBoard_evaluate(result, maskId, isMicro);
+    STATS_END(StatsStageMask, maskStart);
+    if (lastMaskId == 0xFF) {
+        LOG("ERROR: Out of memory.");
+        QrmBoardDestroy(&result);
+        return result;
+    }
+    STATS_BEGIN(formatStart);
     if (isMicro) {
         QrmBoard_placeMicroFormat(result, lastMaskId, ecInfo);
     } else {
         QrmBoard_placeFormatAndVersion(result, lastMaskId, ecInfo);
     }
+    STATS_END(StatsStageFormat, formatStart);
+    STATS_SYMBOL(ecInfo.version, ecInfo.level, isMicro, lastMaskId);
     return result;
 }
 
+QrmBoard QrmBoardFromCodewords(QrmCodewords codewords, UnsignedByte maskId) {
+    if (codewords.version == 0 || codewords.data == NULL) {
+        return QrmBoardCreateEmpty();
+    }
+    QrmSymbolInfo ecInfo = QrmGetSymbolInfo(codewords.version, codewords.level, codewords.isMicro);
+    if (ecInfo.codewords != codewords.dataLength || QrmInfoECCodewordsTotalCount(ecInfo) != codewords.ecLength) {
+        LOG("ERROR: Codewords do not match QR version and level.");
+        return QrmBoardCreateEmpty();
+    }
+    return QrmBoardCreate(
+        codewords.data, codewords.data + codewords.dataLength,
+        ecInfo, maskId, codewords.isMicro
+    );
+}
+
+// CODEWORDS =============================================================================================
+
+void QrmCodewordsDestroy(QrmCodewords* codewords) {
+    if (codewords->data != NULL) {
+        DEALLOC(codewords->data);
+    }
+    codewords->version = 0;
+    codewords->dataLength = 0;
+    codewords->ecLength = 0;
+}
+
+QrmCodewords QrmCodewordsCreateEmpty() {
+    QrmCodewords result;
+    result.version = 0;
+    result.level = ELevelLow;
+    result.isMicro = false;
+    result.dataLength = 0;
+    result.ecLength = 0;
+    result.data = NULL;
+    return result;
+}
+
+QrmCodewords QrmCodewordsCreate(QrmSymbolInfo ecInfo, bool isMicro) {
+    QrmCodewords result = QrmCodewordsCreateEmpty();
+    if (ecInfo.version == 0) {
+        return result;
+    }
+    result.version = ecInfo.version;
+    result.level = ecInfo.level;
+    result.isMicro = isMicro;
+    result.dataLength = ecInfo.codewords;
+    result.ecLength = QrmInfoECCodewordsTotalCount(ecInfo);
+    ALLOC_(UnsignedByte, result.data, result.dataLength + result.ecLength);
+    if (result.data == NULL) {
+        return QrmCodewordsCreateEmpty();
+    }
+    return result;
+}
+
+// RECTANGLES =============================================================================================
+
+bool QrmBoard_isRectCell(UnsignedByte cell, Unsigned2Bytes filter) {
+    return (cell & CellLowMask) == CellSet && (filter & (1 << (cell >> 4))) != 0;
+}
+
+void QrmBoard_addRect(QrmRect rect, QrmRect* rects, unsigned int capacity, unsigned int* count) {
+    if (*count < capacity) {
+        rects[*count] = rect;
+    }
+    *count += 1;
+}
+
+unsigned int QrmBoardToRects(QrmBoard board, Unsigned2Bytes filter, QrmRect* rects, unsigned int capacity) {
+    if (board.dimension == 0 || board.buffer == NULL) {
+        return 0;
+    }
+    // Rectangles reaching previous row (sorted by x) & those reaching current row
+    ALLOC(QrmRect, opened, board.dimension);
+    ALLOC(QrmRect, nextOpened, board.dimension);
+    if (opened == NULL || nextOpened == NULL) {
+        DEALLOC(opened);
+        DEALLOC(nextOpened);
+        return 0;
+    }
+    unsigned int count = 0;
+    unsigned int openedCount = 0;
+    for (UnsignedByte row = 0; row < board.dimension; row += 1) {
+        UnsignedByte* line = board.buffer[row];
+        unsigned int nextOpenedCount = 0;
+        unsigned int openedIndex = 0;
+        UnsignedByte column = 0;
+        while (column < board.dimension) {
+            if (!QrmBoard_isRectCell(line[column], filter)) {
+                column += 1;
+                continue;
+            }
+            UnsignedByte start = column;
+            while (column < board.dimension && QrmBoard_isRectCell(line[column], filter)) {
+                column += 1;
+            }
+            UnsignedByte width = column - start;
+            // Close rectangles which can not continue
+            while (openedIndex < openedCount && opened[openedIndex].x < start) {
+                QrmBoard_addRect(opened[openedIndex], rects, capacity, &count);
+                openedIndex += 1;
+            }
+            if (openedIndex < openedCount && opened[openedIndex].x == start && opened[openedIndex].width == width) {
+                QrmRect rect = opened[openedIndex];
+                rect.height += 1;
+                nextOpened[nextOpenedCount] = rect;
+                openedIndex += 1;
+            } else {
+                QrmRect rect = { start, row, width, 1 };
+                nextOpened[nextOpenedCount] = rect;
+            }
+            nextOpenedCount += 1;
+        }
+        while (openedIndex < openedCount) {
+            QrmBoard_addRect(opened[openedIndex], rects, capacity, &count);
+            openedIndex += 1;
+        }
+        QrmRect* swap = opened;
+        opened = nextOpened;
+        nextOpened = swap;
+        openedCount = nextOpenedCount;
+    }
+    for (unsigned int index = 0; index < openedCount; index += 1) {
+        QrmBoard_addRect(opened[index], rects, capacity, &count);
+    }
+    DEALLOC(opened);
+    DEALLOC(nextOpened);
+    return count;
+}
+
 // PRINT =============================================================================================
 
 void QrmBoardPrintDescription(QrmBoard board, bool isTypeVisible) {
@@ -67,6 +67,29 @@ typedef struct {
     UnsignedByte** buffer;
 } QrmBoard;
 
+/// Final codewords stream of a QR symbol (data + error correction, interleaved)
+typedef struct {
+    /// QR version (0 = empty)
+    UnsignedByte version;
+    /// EC level
+    QrmErrorCorrectionLevel level;
+    /// MicroQR
+    bool isMicro;
+    /// Number of data codewords (first part of `data`)
+    unsigned int dataLength;
+    /// Number of error correction codewords (last part of `data`)
+    unsigned int ecLength;
+    /// `dataLength + ecLength` bytes
+    UnsignedByte* data;
+} QrmCodewords;
+
+/// Destructor
+void QrmCodewordsDestroy(QrmCodewords* codewords);
+/// Place holder.
+QrmCodewords QrmCodewordsCreateEmpty(void);
+/// Allocate (zero filled) codewords for given symbol (`version` = 0 if out of memory).
+QrmCodewords QrmCodewordsCreate(QrmSymbolInfo ecInfo, bool isMicro);
+
 void QrmBoardDestroy(QrmBoard* board);
 QrmBoard QrmBoardDuplicate(QrmBoard other);
 void QrmBoardCopy(QrmBoard* board, QrmBoard other);
@@ -75,6 +98,38 @@ QrmBoard QrmBoardCreateEmpty(void);
 /// To create QR board, refer `QRMatrixEncoder`.
 /// This constructor is for internal purpose.
 QrmBoard QrmBoardCreate(UnsignedByte* data, UnsignedByte* errorCorrection, QrmSymbolInfo ecInfo, UnsignedByte maskId, bool isMicro);
+/// Make QR board (place codewords, mask, place format & version) from codewords stream of `QrmEncoderEncodeCodewords`.
+QrmBoard QrmBoardFromCodewords(
+    QrmCodewords codewords,
+    /// Optional. Force to use given mask (0-7). Pass 0xFF to evaluate the best mask.
+    UnsignedByte maskId
+);
+/// Rectangle of modules (unit: module)
+typedef struct {
+    UnsignedByte x;
+    UnsignedByte y;
+    UnsignedByte width;
+    UnsignedByte height;
+} QrmRect;
+
+/// `QrmBoardToRects` filter: all cell types
+#define QRM_CELL_FILTER_ALL         0xFFFF
+/// `QrmBoardToRects` filter bit of cell type (eg. `QRM_CELL_FILTER(CellFinder)`; data cells: `QRM_CELL_FILTER(CellNeutral)`).
+/// Combine with `|`.
+#define QRM_CELL_FILTER(cellType)   (1 << ((cellType) >> 4))
+
+/// Decompose dark modules into axis aligned rectangles
+/// (runs of each row, then runs of same position & width on sequential rows are merged).
+/// @return Number of rectangles (may be greater than `capacity`: call with `capacity` = 0 to get required capacity).
+unsigned int QrmBoardToRects(
+    QrmBoard board,
+    /// Cell types to include (`QRM_CELL_FILTER_ALL` or combination of `QRM_CELL_FILTER`)
+    Unsigned2Bytes filter,
+    /// Output (first `capacity` rectangles are written). Can be NULL if `capacity` = 0.
+    QrmRect* rects,
+    unsigned int capacity
+);
+
 void QrmBoardPrintDescription(QrmBoard board, bool isTypeVisible);
 
 #endif // QRMATRIXBOARD_H
@@ -0,0 +1,812 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef QRMATRIXCONSTEXPR_HPP
+#define QRMATRIXCONSTEXPR_HPP
+
+// Compile time encoder (C++20, header only): `constexpr auto board = qrm::encode<"text", qrm::Level::M>();`
+// gives the same modules as `QrmEncoderEncode` of 1 segment (default ECI, best mask), from the tables of the C core.
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include "qrmatrix.hpp"
+
+extern "C" {
+#include "Encoder/numericencoder.h"
+#include "Encoder/alphanumericencoder.h"
+}
+
+namespace qrm {
+
+/// String literal as template argument.
+template <std::size_t Size>
+struct FixedString {
+    char data[Size] = {};
+
+    constexpr FixedString(const char (&text)[Size]) noexcept {
+        for (std::size_t index = 0; index < Size; index += 1) {
+            data[index] = text[index];
+        }
+    }
+    /// Without null terminator
+    constexpr std::string_view view() const noexcept { return std::string_view(data, Size - 1); }
+};
+
+/// Board encoded at compile time: modules row by row, 1 bit per module, most significant bit first (1 = dark)
+/// (same layout as `qrm::Board::pack`).
+template <UnsignedByte Dimension>
+struct StaticBoard {
+    static constexpr UnsignedByte dimension = Dimension;
+    /// Number of bytes per row of `modules`
+    static constexpr unsigned int rowStride = (Dimension + 7u) / 8u;
+
+    UnsignedByte version = 0;
+    Level level = Level::L;
+    UnsignedByte maskId = 0;
+    std::array<UnsignedByte, rowStride * Dimension> modules = {};
+
+    constexpr bool isSet(UnsignedByte row, UnsignedByte column) const noexcept {
+        return (modules[row * rowStride + (column >> 3)] & (0x80 >> (column & 7))) != 0;
+    }
+    constexpr std::span<const UnsignedByte> row(UnsignedByte index) const noexcept {
+        return std::span<const UnsignedByte>(modules).subspan(index * rowStride, rowStride);
+    }
+    constexpr bool operator==(const StaticBoard&) const = default;
+};
+
+namespace detail {
+
+// TABLES ===========================================================================================================================================
+
+inline constexpr Unsigned2Bytes symbolInfoTable[][4][6] = {
+#include "Tables/symbolinfo.inc"
+};
+inline constexpr UnsignedByte alignmentTable[][6] = {
+#include "Tables/alignment.inc"
+};
+inline constexpr UnsignedByte gfExp[512] = {
+#include "Tables/gf256exp.inc"
+};
+inline constexpr UnsignedByte gfLog[256] = {
+#include "Tables/gf256log.inc"
+};
+inline constexpr Unsigned2Bytes formatBitsTable[] = {
+#include "Tables/formatbits.inc"
+};
+inline constexpr Unsigned4Bytes versionBitsTable[] = {
+#include "Tables/versionbits.inc"
+};
+
+// SYMBOL INFO ======================================================================================================================================
+
+/// `QrmSymbolInfo` of QR (not MicroQR)
+struct SymbolInfo {
+    UnsignedByte version;
+    unsigned int codewords;
+    unsigned int ecCodewordsPerBlock;
+    unsigned int group1Blocks;
+    unsigned int group1BlockCodewords;
+    unsigned int group2Blocks;
+    unsigned int group2BlockCodewords;
+
+    constexpr unsigned int blockCount() const noexcept { return group1Blocks + group2Blocks; }
+    constexpr unsigned int ecCodewords() const noexcept { return blockCount() * ecCodewordsPerBlock; }
+};
+
+constexpr unsigned int levelIndex(Level level) noexcept {
+    switch (level) {
+    case Level::L:
+        return 0;
+    case Level::M:
+        return 1;
+    case Level::Q:
+        return 2;
+    case Level::H:
+        return 3;
+    }
+    return 0;
+}
+
+constexpr SymbolInfo getSymbolInfo(UnsignedByte version, Level level) noexcept {
+    const Unsigned2Bytes* data = symbolInfoTable[version - 1][levelIndex(level)];
+    return SymbolInfo { version, data[0], data[1], data[2], data[3], data[4], data[5] };
+}
+
+/// Data + EC codewords (same for all levels)
+constexpr unsigned int totalCodewords(UnsignedByte version) noexcept {
+    SymbolInfo info = getSymbolInfo(version, Level::L);
+    return info.codewords + info.ecCodewords();
+}
+
+constexpr UnsignedByte dimensionOf(UnsignedByte version) noexcept {
+    return static_cast<UnsignedByte>((version - 1) * QR_VERSION_OFFSET + QR_MIN_DIMENSION);
+}
+
+/// `QrmGetCharactersCountIndicatorLength` of QR
+constexpr unsigned int charactersCountIndicatorLength(UnsignedByte version, Mode mode) noexcept {
+    unsigned int range = version <= 9 ? 0 : (version <= 26 ? 1 : 2);
+    switch (mode) {
+    case Mode::Numeric:
+        return 10 + range * 2;
+    case Mode::AlphaNumeric:
+        return 9 + range * 2;
+    case Mode::Byte:
+        return range == 0 ? 8 : 16;
+    case Mode::Kanji:
+        return 8 + range * 2;
+    }
+    return 0;
+}
+
+// ENCODE DATA ======================================================================================================================================
+
+constexpr int alphaNumericIndex(char character) noexcept {
+    constexpr std::string_view table = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    std::size_t position = table.find(character);
+    return position == std::string_view::npos ? -1 : static_cast<int>(position);
+}
+
+constexpr bool isValid(std::string_view text, Mode mode) noexcept {
+    if (text.empty()) {
+        return false;
+    }
+    for (char character : text) {
+        switch (mode) {
+        case Mode::Numeric:
+            if (character < '0' || character > '9') {
+                return false;
+            }
+            break;
+        case Mode::AlphaNumeric:
+            if (alphaNumericIndex(character) < 0) {
+                return false;
+            }
+            break;
+        case Mode::Byte:
+            break;
+        case Mode::Kanji:
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Bits of mode indicator & data (without characters count indicator)
+constexpr unsigned int encodedDataBitsCount(std::size_t length, Mode mode) noexcept {
+    unsigned int result = 4;
+    switch (mode) {
+    case Mode::Numeric:
+        result += static_cast<unsigned int>(length / 3) * NUM_TRIPLE_DIGITS_BITS_LEN;
+        result += length % 3 == 1 ? NUM_SINGLE_DIGIT_BITS_LEN : (length % 3 == 2 ? NUM_DOUBLE_DIGITS_BITS_LEN : 0);
+        break;
+    case Mode::AlphaNumeric:
+        result += static_cast<unsigned int>(length / 2) * ALPHA_NUM_PAIR_CHARS_BITS_LEN + static_cast<unsigned int>(length % 2) * ALPHA_NUM_SINGLE_CHAR_BITS_LEN;
+        break;
+    case Mode::Byte:
+        result += static_cast<unsigned int>(length) * 8;
+        break;
+    case Mode::Kanji:
+        result += static_cast<unsigned int>(length / 2) * 13;
+        break;
+    }
+    return result;
+}
+
+/// Smallest version to encode `length` characters (as `QRMatrixEncoder_findVersion`).
+/// @return 0 if data is too long.
+constexpr UnsignedByte findVersion(std::size_t length, Level level, Mode mode) noexcept {
+    unsigned int totalDataBitsCount = encodedDataBitsCount(length, mode);
+    for (UnsignedByte version = 1; version <= QR_MAX_VERSION; version += 1) {
+        unsigned int capacity = getSymbolInfo(version, level).codewords * 8;
+        if (totalDataBitsCount >= capacity) {
+            continue;
+        }
+        if (totalDataBitsCount + charactersCountIndicatorLength(version, mode) <= capacity) {
+            return version;
+        }
+    }
+    return 0;
+}
+
+/// `QrmCopyValueBits`
+constexpr void copyValueBits(Unsigned4Bytes value, unsigned int count, UnsignedByte* destination, unsigned int destStartIndex) noexcept {
+    UnsignedByte* curDestPtr = destination + destStartIndex / 8;
+    unsigned int destBitIndex = destStartIndex % 8;
+    unsigned int totalCount = count;
+    while (totalCount > 0) {
+        unsigned int available = 8 - destBitIndex;
+        unsigned int curCount = totalCount < available ? totalCount : available;
+        unsigned int shift = available - curCount;
+        UnsignedByte pattern = static_cast<UnsignedByte>(((1u << curCount) - 1) << shift);
+        UnsignedByte bits = static_cast<UnsignedByte>(((value >> (totalCount - curCount)) << shift) & pattern);
+        *curDestPtr = static_cast<UnsignedByte>((*curDestPtr & ~pattern) | bits);
+        totalCount -= curCount;
+        destBitIndex = 0;
+        curDestPtr += 1;
+    }
+}
+
+/// Mode, characters count, data, terminator & padding into `buffer` (`info.codewords` bytes).
+constexpr void encodeData(std::string_view text, Mode mode, SymbolInfo info, UnsignedByte* buffer) noexcept {
+    unsigned int bitIndex = 0;
+    copyValueBits(static_cast<Unsigned4Bytes>(mode), 4, buffer, bitIndex);
+    bitIndex += 4;
+    unsigned int charCountIndicatorLen = charactersCountIndicatorLength(info.version, mode);
+    copyValueBits(static_cast<Unsigned4Bytes>(text.size()), charCountIndicatorLen, buffer, bitIndex);
+    bitIndex += charCountIndicatorLen;
+    std::size_t index = 0;
+    switch (mode) {
+    case Mode::Numeric:
+        while (index < text.size()) {
+            std::size_t groupLen = text.size() - index > 2 ? 3 : text.size() - index;
+            Unsigned4Bytes value = 0;
+            for (std::size_t idx = 0; idx < groupLen; idx += 1) {
+                value = value * 10 + static_cast<Unsigned4Bytes>(text[index + idx] - '0');
+            }
+            unsigned int bitLen = groupLen == 3 ? NUM_TRIPLE_DIGITS_BITS_LEN : (groupLen == 2 ? NUM_DOUBLE_DIGITS_BITS_LEN : NUM_SINGLE_DIGIT_BITS_LEN);
+            copyValueBits(value, bitLen, buffer, bitIndex);
+            bitIndex += bitLen;
+            index += groupLen;
+        }
+        break;
+    case Mode::AlphaNumeric:
+        while (index < text.size()) {
+            Unsigned4Bytes value = static_cast<Unsigned4Bytes>(alphaNumericIndex(text[index]));
+            unsigned int bitLen = ALPHA_NUM_SINGLE_CHAR_BITS_LEN;
+            if (text.size() - index > 1) {
+                value = value * ALPHA_NUM_MULTIPLICATION + static_cast<Unsigned4Bytes>(alphaNumericIndex(text[index + 1]));
+                bitLen = ALPHA_NUM_PAIR_CHARS_BITS_LEN;
+                index += 1;
+            }
+            copyValueBits(value, bitLen, buffer, bitIndex);
+            bitIndex += bitLen;
+            index += 1;
+        }
+        break;
+    case Mode::Byte:
+        for (char character : text) {
+            copyValueBits(static_cast<UnsignedByte>(character), 8, buffer, bitIndex);
+            bitIndex += 8;
+        }
+        break;
+    case Mode::Kanji:
+        break;
+    }
+    // Terminator (buffer is zero filled), multiple of 8, then fill up
+    unsigned int bufferBitsLen = info.codewords * 8;
+    bitIndex = bitIndex + 4 < bufferBitsLen ? bitIndex + 4 : bufferBitsLen;
+    bitIndex = (bitIndex + 7) / 8 * 8;
+    UnsignedByte curByteFilling = 0b11101100;
+    while (bitIndex < bufferBitsLen) {
+        buffer[bitIndex / 8] = curByteFilling;
+        bitIndex += 8;
+        curByteFilling = curByteFilling == 0b11101100 ? 0b00010001 : 0b11101100;
+    }
+}
+
+// ERROR CORRECTION =================================================================================================================================
+
+constexpr UnsignedByte gfMultiply(UnsignedByte left, UnsignedByte right) noexcept {
+    if (left == 0 || right == 0) {
+        return 0;
+    }
+    return gfExp[gfLog[left] + gfLog[right]];
+}
+
+/// `QrmGetErrorCorrections` of a block (`count` ≤ 30)
+constexpr void errorCorrection(const UnsignedByte* data, unsigned int length, unsigned int count, UnsignedByte* result) noexcept {
+    UnsignedByte generator[31] = {};
+    generator[0] = 1;
+    for (unsigned int index = 0; index < count; index += 1) {
+        // Multiply by (x + 2^index)
+        UnsignedByte factor = gfExp[index % 255];
+        for (unsigned int jndex = index + 1; jndex > 0; jndex -= 1) {
+            generator[jndex] ^= gfMultiply(generator[jndex - 1], factor);
+        }
+    }
+    UnsignedByte remainder[30] = {};
+    for (unsigned int index = 0; index < length; index += 1) {
+        UnsignedByte coef = data[index] ^ remainder[0];
+        for (unsigned int jndex = 1; jndex < count; jndex += 1) {
+            remainder[jndex - 1] = remainder[jndex] ^ gfMultiply(generator[jndex], coef);
+        }
+        remainder[count - 1] = gfMultiply(generator[count], coef);
+    }
+    for (unsigned int index = 0; index < count; index += 1) {
+        result[index] = remainder[index];
+    }
+}
+
+/// Final (interleaved data + EC) codewords stream
+template <UnsignedByte Version>
+constexpr std::array<UnsignedByte, totalCodewords(Version)> encodeCodewords(std::string_view text, Level level, Mode mode) noexcept {
+    SymbolInfo info = getSymbolInfo(Version, level);
+    std::array<UnsignedByte, totalCodewords(Version)> buffer = {};
+    std::array<UnsignedByte, totalCodewords(Version)> result = {};
+    encodeData(text, mode, info, buffer.data());
+    // EC of all blocks (after data in `buffer`)
+    UnsignedByte* ecBuffer = buffer.data() + info.codewords;
+    unsigned int offset = 0;
+    for (unsigned int block = 0; block < info.blockCount(); block += 1) {
+        unsigned int blockSize = block < info.group1Blocks ? info.group1BlockCodewords : info.group2BlockCodewords;
+        errorCorrection(buffer.data() + offset, blockSize, info.ecCodewordsPerBlock, ecBuffer + block * info.ecCodewordsPerBlock);
+        offset += blockSize;
+    }
+    // Interleave (group 2 blocks are 1 codeword longer than group 1 blocks)
+    unsigned int group2Offset = info.group1Blocks * info.group1BlockCodewords;
+    unsigned int maxBlockSize = info.group2Blocks > 0 ? info.group2BlockCodewords : info.group1BlockCodewords;
+    unsigned int resIndex = 0;
+    for (unsigned int index = 0; index < maxBlockSize; index += 1) {
+        if (index < info.group1BlockCodewords) {
+            for (unsigned int block = 0; block < info.group1Blocks; block += 1) {
+                result[resIndex] = buffer[block * info.group1BlockCodewords + index];
+                resIndex += 1;
+            }
+        }
+        for (unsigned int block = 0; block < info.group2Blocks; block += 1) {
+            result[resIndex] = buffer[group2Offset + block * info.group2BlockCodewords + index];
+            resIndex += 1;
+        }
+    }
+    for (unsigned int index = 0; index < info.ecCodewordsPerBlock; index += 1) {
+        for (unsigned int block = 0; block < info.blockCount(); block += 1) {
+            result[resIndex] = ecBuffer[block * info.ecCodewordsPerBlock + index];
+            resIndex += 1;
+        }
+    }
+    return result;
+}
+
+// BOARD ============================================================================================================================================
+
+/// Cells (`QrmBoardCell`) of board
+template <UnsignedByte Dimension>
+struct Cells {
+    UnsignedByte buffer[Dimension * Dimension] = {};
+
+    constexpr UnsignedByte& operator()(int row, int column) noexcept { return buffer[row * Dimension + column]; }
+    constexpr UnsignedByte operator()(int row, int column) const noexcept { return buffer[row * Dimension + column]; }
+};
+
+template <UnsignedByte Dimension>
+constexpr void setSquare(Cells<Dimension>& cells, int row, int column, int size, bool isFill, bool isSet, UnsignedByte prefix) noexcept {
+    UnsignedByte value = static_cast<UnsignedByte>((isSet ? CellSet : CellUnset) | prefix);
+    for (int rIndex = row; rIndex < row + size; rIndex += 1) {
+        for (int cIndex = column; cIndex < column + size; cIndex += 1) {
+            if (isFill || rIndex == row || rIndex == row + size - 1 || cIndex == column || cIndex == column + size - 1) {
+                cells(rIndex, cIndex) = value;
+            }
+        }
+    }
+}
+
+template <UnsignedByte Dimension>
+constexpr void addFinderPattern(Cells<Dimension>& cells, int row, int column) noexcept {
+    setSquare(cells, row, column, 7, false, true, CellFinder);
+    setSquare(cells, row + 1, column + 1, 5, false, false, CellFinder);
+    setSquare(cells, row + 2, column + 2, 3, true, true, CellFinder);
+}
+
+template <UnsignedByte Dimension>
+constexpr void addAlignmentPattern(Cells<Dimension>& cells, int row, int column) noexcept {
+    for (int rIndex = row - 2; rIndex < row + 3; rIndex += 1) {
+        for (int cIndex = column - 2; cIndex < column + 3; cIndex += 1) {
+            if (cells(rIndex, cIndex) != CellNeutral) {
+                return;
+            }
+        }
+    }
+    setSquare(cells, row - 2, column - 2, 5, false, true, CellAlignment);
+    setSquare(cells, row - 1, column - 1, 3, false, false, CellAlignment);
+    cells(row, column) = CellSet | CellAlignment;
+}
+
+/// Function patterns & reserved areas (`QrmBoardCreate`)
+template <UnsignedByte Dimension>
+constexpr void addFunctionPatterns(Cells<Dimension>& cells, UnsignedByte version) noexcept {
+    constexpr int dimension = Dimension;
+    addFinderPattern(cells, 0, 0);
+    addFinderPattern(cells, 0, dimension - 7);
+    addFinderPattern(cells, dimension - 7, 0);
+    // Separators
+    UnsignedByte separator = CellUnset | CellSeparator;
+    for (int index = 0; index < 8; index += 1) {
+        cells(7, index) = separator;
+        cells(index, 7) = separator;
+        cells(7, dimension - index - 1) = separator;
+        cells(index, dimension - 8) = separator;
+        cells(dimension - 8, index) = separator;
+        cells(dimension - index - 1, 7) = separator;
+    }
+    // Alignment patterns
+    if (version >= 2) {
+        const UnsignedByte* array = alignmentTable[version - 2];
+        addAlignmentPattern(cells, 6, 6);
+        for (int index = 0; index < 6; index += 1) {
+            int value = array[index];
+            if (value > 0) {
+                addAlignmentPattern(cells, 6, value);
+                addAlignmentPattern(cells, value, 6);
+                addAlignmentPattern(cells, value, value);
+                for (int jndex = 0; jndex < 6; jndex += 1) {
+                    int value2 = array[jndex];
+                    if (value2 > 0 && value != value2) {
+                        addAlignmentPattern(cells, value, value2);
+                        addAlignmentPattern(cells, value2, value);
+                    }
+                }
+            }
+        }
+    }
+    // Timing patterns
+    for (int index = 6; index < dimension - 6; index += 1) {
+        UnsignedByte value = static_cast<UnsignedByte>(CellTiming | ((index % 2) == 0 ? CellSet : CellUnset));
+        cells(6, index) = value;
+        cells(index, 6) = value;
+    }
+    // Dark cell & reserved cells for format & version
+    cells(dimension - 8, 8) = CellDark | CellSet;
+    for (int index = 0; index < 8; index += 1) {
+        if (cells(8, index) == CellNeutral) {
+            cells(8, index) = CellFormat | CellUnset;
+        }
+        if (cells(index, 8) == CellNeutral) {
+            cells(index, 8) = CellFormat | CellUnset;
+        }
+        if (cells(dimension - index - 1, 8) == CellNeutral) {
+            cells(dimension - index - 1, 8) = CellFormat | CellUnset;
+        }
+        cells(8, dimension - index - 1) = CellFormat | CellUnset;
+    }
+    cells(8, 8) = CellFormat | CellUnset;
+    if (version < 7) {
+        return;
+    }
+    for (int index = 0; index < 3; index += 1) {
+        for (int jndex = 0; jndex < 6; jndex += 1) {
+            cells(jndex, dimension - 9 - index) = CellVersion | CellUnset;
+            cells(dimension - 9 - index, jndex) = CellVersion | CellUnset;
+        }
+    }
+}
+
+/// `QrmBoard_remainderBitsLength`
+constexpr unsigned int remainderBitsLength(UnsignedByte version) noexcept {
+    if (version >= 2 && version <= 6) {
+        return 7;
+    }
+    if ((version >= 14 && version <= 20) || (version >= 28 && version <= 34)) {
+        return 3;
+    }
+    if (version >= 21 && version <= 27) {
+        return 4;
+    }
+    return 0;
+}
+
+/// Progress of `placeData`
+struct PlacementState {
+    unsigned int dataBitTotal = 0;
+    unsigned int ecBitTotal = 0;
+    unsigned int remainderCount = 0;
+    UnsignedByte phase = 0;
+    unsigned int byteIndex = 0;
+    UnsignedByte bitIndex = 0;
+    unsigned int bitCount = 0;
+};
+
+/// Fill data bit into cell (`QrmBoard_fillDataBit`, `QrmBoard_checkFilledBit`): data codewords, EC codewords, then remainder bits.
+/// @return true if completed.
+template <UnsignedByte Dimension>
+constexpr bool fillDataBit(Cells<Dimension>& cells, int row, int column, const UnsignedByte* data, const UnsignedByte* errorCorrection, PlacementState& state) noexcept {
+    UnsignedByte value = 0;
+    UnsignedByte mask = static_cast<UnsignedByte>(0b10000000 >> state.bitIndex);
+    UnsignedByte prefix = 0x00;
+    switch (state.phase) {
+    case 0:
+        value = data[state.byteIndex];
+        break;
+    case 1:
+        value = errorCorrection[state.byteIndex];
+        prefix = CellErrorCorrection;
+        break;
+    default:
+        mask = 0;
+        prefix = CellRemainder;
+        break;
+    }
+    cells(row, column) = static_cast<UnsignedByte>(((value & mask) > 0 ? CellSet : CellUnset) | prefix);
+    state.bitIndex += 1;
+    if (state.bitIndex > 7) {
+        state.bitIndex = 0;
+        state.byteIndex += 1;
+    }
+    state.bitCount += 1;
+    switch (state.phase) {
+    case 0:
+        if (state.bitCount >= state.dataBitTotal) {
+            state = PlacementState { state.dataBitTotal, state.ecBitTotal, state.remainderCount, 1 };
+        }
+        break;
+    case 1:
+        if (state.bitCount >= state.ecBitTotal) {
+            state = PlacementState { state.dataBitTotal, state.ecBitTotal, state.remainderCount, 2 };
+            return state.remainderCount == 0;
+        }
+        break;
+    default:
+        return state.bitCount >= state.remainderCount;
+    }
+    return false;
+}
+
+/// Fill codewords into board (`QrmBoard_placeData`)
+template <UnsignedByte Dimension>
+constexpr void placeData(Cells<Dimension>& cells, const UnsignedByte* data, const UnsignedByte* errorCorrection, SymbolInfo info) noexcept {
+    constexpr int dimension = Dimension;
+    PlacementState state { info.codewords * 8, info.ecCodewords() * 8, remainderBitsLength(info.version), 0 };
+    bool isUpward = true;
+    bool isCompleted = false;
+    int column = dimension - 1;
+    while (column >= 0 && !isCompleted) {
+        for (int step = 0; step < dimension && !isCompleted; step += 1) {
+            int row = isUpward ? dimension - 1 - step : step;
+            if (cells(row, column) == CellNeutral) {
+                isCompleted = fillDataBit(cells, row, column, data, errorCorrection, state);
+            }
+            // As the C core: 2nd cell of the pair is filled even after completion
+            if (column > 0 && cells(row, column - 1) == CellNeutral) {
+                isCompleted = fillDataBit(cells, row, column - 1, data, errorCorrection, state);
+            }
+        }
+        column -= 2;
+        if (column == 6) {
+            column -= 1;
+        }
+        isUpward = !isUpward;
+    }
+}
+
+/// Condition of mask `maskNum` (`QrmBoard_maskInto`)
+constexpr bool isMaskedCell(UnsignedByte maskNum, int row, int column) noexcept {
+    switch (maskNum) {
+    case 0:
+        return ((row + column) % 2) == 0;
+    case 1:
+        return (row % 2) == 0;
+    case 2:
+        return (column % 3) == 0;
+    case 3:
+        return ((row + column) % 3) == 0;
+    case 4:
+        return ((row / 2 + column / 3) % 2) == 0;
+    case 5:
+        return ((row * column) % 2 + (row * column) % 3) == 0;
+    case 6:
+        return (((row * column) % 2 + (row * column) % 3) % 2) == 0;
+    case 7:
+        return (((row + column) % 2 + (row * column) % 3) % 2) == 0;
+    default:
+        return false;
+    }
+}
+
+/// Mask cell (function patterns & remainder bits are unchanged)
+constexpr UnsignedByte maskCell(UnsignedByte byte, UnsignedByte maskNum, int row, int column) noexcept {
+    if ((byte & CellFuncMask) > 0 || !isMaskedCell(maskNum, row, column)) {
+        return byte;
+    }
+    UnsignedByte low = byte & CellLowMask;
+    if (low == CellSet) {
+        low = CellUnset;
+    } else if (low == CellUnset) {
+        low = CellSet;
+    }
+    return static_cast<UnsignedByte>((byte & CellHighMask) | low);
+}
+
+/// Colors (`CellSet`, `CellUnset`) of board masked by `maskNum`
+/// @return Number of dark modules
+template <UnsignedByte Dimension>
+constexpr unsigned int maskColors(const Cells<Dimension>& cells, UnsignedByte maskNum, UnsignedByte* colors) noexcept {
+    unsigned int darkCount = 0;
+    int index = 0;
+    for (int row = 0; row < Dimension; row += 1) {
+        for (int column = 0; column < Dimension; column += 1) {
+            colors[index] = maskCell(cells.buffer[index], maskNum, row, column) & CellLowMask;
+            darkCount += colors[index] == CellSet ? 1 : 0;
+            index += 1;
+        }
+    }
+    return darkCount;
+}
+
+/// Penalty score of masked board colors (same score as `QrmBoard_evaluateCondition1...4`, computed in less operations)
+template <UnsignedByte Dimension>
+constexpr unsigned int evaluate(const UnsignedByte* colors, unsigned int darkCount) noexcept {
+    constexpr int dimension = Dimension;
+    // Finder like patterns of condition 3 (1011101 0000 & 0000 1011101), 2 bits per cell (`CellSet >> 2`, `CellUnset >> 2`)
+    constexpr Unsigned4Bytes pattern1 = 0b10'01'10'10'10'01'10'01'01'01'01;
+    constexpr Unsigned4Bytes pattern2 = 0b01'01'01'01'10'01'10'10'10'01'10;
+    unsigned int result = 0;
+    UnsignedByte sameColorCount = 0;
+    UnsignedByte curColor = CellDark;
+    // Rows then columns
+    for (int pass = 0; pass < 2; pass += 1) {
+        int lineStep = pass == 0 ? dimension : 1;
+        int cellStep = pass == 0 ? 1 : dimension;
+        for (int outer = 0; outer < dimension; outer += 1) {
+            const UnsignedByte* cell = colors + outer * lineStep;
+            Unsigned4Bytes window = 0;
+            for (int inner = 0; inner < dimension; inner += 1, cell += cellStep) {
+                // Condition 1: runs of same color (counted across lines, as the C core does)
+                if (*cell == curColor) {
+                    sameColorCount = static_cast<UnsignedByte>(sameColorCount + 1);
+                } else {
+                    curColor = *cell;
+                    if (sameColorCount >= 5) {
+                        result += 3 + (sameColorCount - 5);
+                    }
+                    sameColorCount = 0;
+                }
+                // Condition 2: 2x2 blocks
+                if (pass == 0 && outer < dimension - 1 && inner < dimension - 1 &&
+                    *cell == cell[1] && *cell == cell[dimension] && *cell == cell[dimension + 1]) {
+                    result += 3;
+                }
+                // Condition 3: 11 cells window starting before `dimension - 11`
+                window = ((window << 2) | (*cell >> 2)) & 0x3FFFFF;
+                if (inner >= 10 && inner < dimension - 1 && (window == pattern1 || window == pattern2)) {
+                    result += 40;
+                }
+            }
+        }
+        if (sameColorCount >= 5) {
+            result += 3 + (sameColorCount - 5);
+        }
+        sameColorCount = 0;
+    }
+    // Condition 4: proportion of dark modules
+    double percent = (static_cast<double>(darkCount) / static_cast<double>(dimension * dimension)) * 100.0;
+    int pre5 = static_cast<int>(static_cast<unsigned int>(percent / 5) * 5);
+    int next5 = pre5 + 5;
+    pre5 = (pre5 > 50 ? pre5 - 50 : 50 - pre5) / 5;
+    next5 = (next5 > 50 ? next5 - 50 : 50 - next5) / 5;
+    result += static_cast<unsigned int>(pre5 > next5 ? next5 : pre5) * 10;
+    return result;
+}
+
+template <UnsignedByte Dimension>
+constexpr void setReservedCell(Cells<Dimension>& cells, int row, int column, bool isSet) noexcept {
+    UnsignedByte high = cells(row, column) & CellHighMask;
+    if (high == CellFormat || high == CellVersion) {
+        cells(row, column) = static_cast<UnsignedByte>(high | (isSet ? CellSet : CellUnset));
+    }
+}
+
+/// `QrmBoard_placeFormatAndVersion`
+template <UnsignedByte Dimension>
+constexpr void placeFormatAndVersion(Cells<Dimension>& cells, Level level, UnsignedByte maskId, UnsignedByte version) noexcept {
+    constexpr int dimension = Dimension;
+    Unsigned2Bytes format = formatBitsTable[(static_cast<unsigned int>(level) << 3) | maskId];
+    for (int index = 0; index < 15; index += 1) {
+        bool isSet = (format & (0x8000 >> index)) != 0;
+        if (index < 6) {
+            setReservedCell(cells, 8, index, isSet);
+            setReservedCell(cells, dimension - index - 1, 8, isSet);
+        } else if (index > 8) {
+            setReservedCell(cells, 8, dimension - (15 - index), isSet);
+            setReservedCell(cells, 14 - index, 8, isSet);
+        } else if (index == 6) {
+            setReservedCell(cells, 8, index + 1, isSet);
+            setReservedCell(cells, dimension - index - 1, 8, isSet);
+        } else if (index == 7) {
+            setReservedCell(cells, 8, index + 1, isSet);
+            setReservedCell(cells, 8, dimension - (15 - index), isSet);
+        } else {
+            setReservedCell(cells, 14 - index + 1, 8, isSet);
+            setReservedCell(cells, 8, dimension - (15 - index), isSet);
+        }
+    }
+    if (version < 7) {
+        return;
+    }
+    Unsigned4Bytes bits = versionBitsTable[version - 7];
+    int row1 = dimension - 9;
+    int col1 = 5;
+    int row2 = 5;
+    int col2 = dimension - 9;
+    for (int index = 0; index < 18; index += 1) {
+        bool isSet = (bits & (0x80000000u >> index)) != 0;
+        setReservedCell(cells, row1, col1, isSet);
+        if (row1 == dimension - 11) {
+            row1 = dimension - 9;
+            col1 -= 1;
+        } else {
+            row1 -= 1;
+        }
+        setReservedCell(cells, row2, col2, isSet);
+        if (col2 == dimension - 11) {
+            col2 = dimension - 9;
+            row2 -= 1;
+        } else {
+            col2 -= 1;
+        }
+    }
+}
+
+template <UnsignedByte Version>
+constexpr StaticBoard<dimensionOf(Version)> encodeBoard(std::string_view text, Level level, Mode mode) noexcept {
+    constexpr UnsignedByte dimension = dimensionOf(Version);
+    std::array<UnsignedByte, totalCodewords(Version)> codewords = encodeCodewords<Version>(text, level, mode);
+    Cells<dimension> cells;
+    addFunctionPatterns(cells, Version);
+    SymbolInfo info = getSymbolInfo(Version, level);
+    placeData(cells, codewords.data(), codewords.data() + info.codewords, info);
+    // Best mask (lowest penalty; first one if equal)
+    UnsignedByte colors[dimension * dimension] = {};
+    unsigned int minScore = 0;
+    UnsignedByte minId = 0;
+    for (UnsignedByte maskId = 0; maskId < 8; maskId += 1) {
+        unsigned int darkCount = maskColors(cells, maskId, colors);
+        unsigned int score = evaluate<dimension>(colors, darkCount);
+        if (minScore == 0 || minScore > score) {
+            minScore = score;
+            minId = maskId;
+        }
+    }
+    for (int index = 0; index < dimension * dimension; index += 1) {
+        cells.buffer[index] = maskCell(cells.buffer[index], minId, index / dimension, index % dimension);
+    }
+    placeFormatAndVersion(cells, level, minId, Version);
+
+    StaticBoard<dimension> result;
+    result.version = Version;
+    result.level = level;
+    result.maskId = minId;
+    for (int row = 0; row < dimension; row += 1) {
+        for (int column = 0; column < dimension; column += 1) {
+            if ((cells(row, column) & CellLowMask) == CellSet) {
+                result.modules[row * result.rowStride + (column >> 3)] |= static_cast<UnsignedByte>(0x80 >> (column & 7));
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+/// Encode `Text` at compile time (1 segment, default ECI, best mask), eg. `constexpr auto board = qrm::encode<"text", qrm::Level::M>();`.
+/// GCC default `-fconstexpr-ops-limit` fits symbols up to about version 20 (version 40 needs about 100000000).
+template <FixedString Text, Level ECLevel, Mode EncodingMode = Mode::Byte>
+consteval auto encode() noexcept {
+    static_assert(detail::isValid(Text.view(), EncodingMode), "Text can not be encoded by given mode (Kanji mode is not supported)");
+    constexpr UnsignedByte version = detail::findVersion(Text.view().size(), ECLevel, EncodingMode);
+    static_assert(version > 0, "Text is too long");
+    return detail::encodeBoard<(version > 0 ? version : 1)>(Text.view(), ECLevel, EncodingMode);
+}
+
+} // namespace qrm
+
+#endif // QRMATRIXCONSTEXPR_HPP
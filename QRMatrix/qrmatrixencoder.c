@@ -23,18 +23,15 @@
 #include "qrmatrixencoder.h"
 #include "common.h"
 #include <stdlib.h>
+#include <string.h>
 #include "Encoder/numericencoder.h"
 #include "Encoder/alphanumericencoder.h"
 #include "Encoder/kanjiencoder.h"
 
 #include "Polynomial/polynomial.h"
 
-bool qrmIsEnvInited = false;
-
 void QRMatrixInit() {
-    QrmCheckEnv();
-    QrmPolynomialInitialize();
-    qrmIsEnvInited = true;
+    // Tables are constant data & environment is checked at compile time: nothing to do
 }
 
 // PREPARE DATA --------------------------------------------------------------------------------------------------------------------------------------
@@ -195,38 +192,22 @@ QrmSymbolInfo QRMatrixEncoder_findVersion(
 
 /// Encode ECI Indicator
 UnsignedByte* QRMatrixEncoder_encodeEciIndicator(Unsigned4Bytes indicator, UnsignedByte* resultLength) {
-    UnsignedByte* indicatorPtr = (UnsignedByte*)&indicator;
     UnsignedByte* result = NULL;
     if (indicator <= 127) {
         *resultLength = 1;
         ALLOC_(UnsignedByte, result, 1);
-        if (qrmIsLittleEndian) {
-            result[0] = indicatorPtr[0] & 0x7F;
-        } else {
-            result[0] = indicatorPtr[3] & 0x7F;
-        }
+        result[0] = (UnsignedByte)(indicator & 0x7F);
     } else if (indicator <= 16383) {
         *resultLength = 2;
         ALLOC_(UnsignedByte, result, 2);
-        if (qrmIsLittleEndian) {
-            result[0] = (indicatorPtr[1] & 0x3F) | 0x80;
-            result[1] = indicatorPtr[0];
-        } else {
-            result[0] = (indicatorPtr[2] & 0x3F) | 0x80;
-            result[1] = indicatorPtr[3];
-        }
+        result[0] = (UnsignedByte)(((indicator >> 8) & 0x3F) | 0x80);
+        result[1] = (UnsignedByte)(indicator & 0xFF);
     } else if (indicator <= 999999) {
         *resultLength = 3;
         ALLOC_(UnsignedByte, result, 3);
-        if (qrmIsLittleEndian) {
-            result[0] = (indicatorPtr[2] & 0x1F) | 0xC0;
-            result[1] = indicatorPtr[1];
-            result[2] = indicatorPtr[0];
-        } else {
-            result[0] = (indicatorPtr[1] & 0x1F) | 0xC0;
-            result[1] = indicatorPtr[2];
-            result[2] = indicatorPtr[3];
-        }
+        result[0] = (UnsignedByte)(((indicator >> 16) & 0x1F) | 0xC0);
+        result[1] = (UnsignedByte)((indicator >> 8) & 0xFF);
+        result[2] = (UnsignedByte)(indicator & 0xFF);
     } else {
         LOG("ERROR: Invalid ECI Indicator");
         *resultLength = 0;
@@ -235,7 +216,8 @@ UnsignedByte* QRMatrixEncoder_encodeEciIndicator(Unsigned4Bytes indicator, Unsig
 }
 
 /// Encode segments into buffer
-void QRMatrixEncoder_encodeSegment(
+/// @return false if out of memory
+bool QRMatrixEncoder_encodeSegment(
     UnsignedByte* buffer,
     QrmSegment segment,
     unsigned int segmentIndex,
@@ -245,14 +227,16 @@ void QRMatrixEncoder_encodeSegment(
     QrmExtraEncodingInfo extraMode
 ) {
     if (segment.length == 0) {
-        return;
+        return true;
     }
     bool isMicro = extraMode.mode == XModeMicroQr;
-    unsigned int uintSize = sizeof(unsigned int);
     // ECI Header if enable
     if (!isMicro && segment.eci != DEFAULT_ECI_ASSIGMENT) {
         UnsignedByte eciLen = 0;
         UnsignedByte* eciHeader = QRMatrixEncoder_encodeEciIndicator(segment.eci, &eciLen);
+        if (eciLen > 0 && eciHeader == NULL) {
+            return false;
+        }
         if (eciLen > 0) {
             // 4 bits of ECI mode indicator
             UnsignedByte eciModeHeader = 0b0111;
@@ -286,13 +270,9 @@ void QRMatrixEncoder_encodeSegment(
             case 1:
                 fnc1Header = extraMode.appIndicator[0] + 100;
                 break;
-            case 2: {
-                ALLOC(UnsignedByte, numStr, 3);
-                numStr[0] = extraMode.appIndicator[0];
-                numStr[1] = extraMode.appIndicator[1];
-                fnc1Header = atoi((const char*)numStr);
-                DEALLOC(numStr);
-            }
+            case 2:
+                // 2 digits (validated by `QRMatrixEncoder_encodeSingleCodewords`)
+                fnc1Header = (extraMode.appIndicator[0] - '0') * 10 + (extraMode.appIndicator[1] - '0');
                 break;
             default:
                 break;
@@ -321,15 +301,7 @@ void QRMatrixEncoder_encodeSegment(
         charCount = segment.length / 2;
         break;
     }
-    QrmCopyBits(
-        (UnsignedByte*)&charCount,
-        uintSize,
-        uintSize * 8 - charCountIndicatorLen,
-        qrmIsLittleEndian,
-        buffer,
-        *bitIndex,
-        charCountIndicatorLen
-    );
+    QrmCopyValueBits(charCount, charCountIndicatorLen, buffer, *bitIndex);
     *bitIndex += charCountIndicatorLen;
 
     LOG("SEGMENT:\n%s version: %d\nMode: %d\nEC Level: %d\nChar count: %d\nPayload length: %d\nEC Length: %d",
@@ -358,9 +330,12 @@ void QRMatrixEncoder_encodeSegment(
     }
         break;
     case EModeKanji:
+#if !QRM_NO_KANJI
         *bitIndex += QrmKanjiEncode(segment.data, segment.length, buffer, *bitIndex);
+#endif
         break;
     }
+    return true;
 }
 
 // ERROR CORRECTION ---------------------------------------------------------------------------------------------------------------------------------
@@ -405,6 +380,9 @@ UnsignedByte* QRMatrixEncoder_generateErrorCorrection(
     }
 
     QrmPolynomial mesg = QrmPolynomialCreate(blockSize);
+    if (mesg.terms == NULL) {
+        return NULL;
+    }
     for (unsigned int index = 0; index < blockSize; index += 1) {
         mesg.terms[index] = encodedData[offset + index];
     }
@@ -415,6 +393,11 @@ UnsignedByte* QRMatrixEncoder_generateErrorCorrection(
         return NULL;
     }
     ALLOC(UnsignedByte, result, ecc.length);
+    if (result == NULL) {
+        QrmPolynomialDestroy(&mesg);
+        QrmPolynomialDestroy(&ecc);
+        return NULL;
+    }
     for (unsigned int index = 0; index < ecc.length; index += 1) {
         result[index] = ecc.terms[index];
     }
@@ -431,7 +414,7 @@ UnsignedByte* QRMatrixEncoder_generateErrorCorrection(
 
 
 /// Generate Error correction bytes
-/// @return Binary data (should be deleted on unused). 2D array contains EC bytes for all blocks.
+/// @return Binary data (should be deleted on unused). 2D array contains EC bytes for all blocks (NULL if out of memory).
 UnsignedByte** QRMatrixEncoder_generateErrorCorrections(
     /// Bytes from previous (encode data) step
     UnsignedByte* encodedData,
@@ -440,6 +423,9 @@ UnsignedByte** QRMatrixEncoder_generateErrorCorrections(
 ) {
     UnsignedByte maxGroup = QrmInfoGroupCount(ecInfo);
     ALLOC(UnsignedByte*, result, QrmInfoECBlockTotalCount(ecInfo));
+    if (result == NULL) {
+        return NULL;
+    }
     unsigned int blockIndex = 0;
     for (UnsignedByte group = 0; group < maxGroup; group += 1) {
         UnsignedByte maxBlock = 0;
@@ -455,6 +441,13 @@ UnsignedByte** QRMatrixEncoder_generateErrorCorrections(
         }
         for (UnsignedByte block = 0; block < maxBlock; block += 1) {
             result[blockIndex] = QRMatrixEncoder_generateErrorCorrection(encodedData, ecInfo, group, block);
+            if (result[blockIndex] == NULL) {
+                for (unsigned int index = 0; index < blockIndex; index += 1) {
+                    DEALLOC(result[index]);
+                }
+                DEALLOC(result);
+                return NULL;
+            }
             blockIndex += 1;
         }
     }
@@ -465,83 +458,52 @@ UnsignedByte** QRMatrixEncoder_generateErrorCorrections(
 
 /// Interleave data codeworks
 /// Throw error if QR has only 1 block in total (check ecInfo before call this function)
-/// @return Binary data (should be deleted on unused)
-UnsignedByte* QRMatrixEncoder_interleave(
+void QRMatrixEncoder_interleave(
     /// Encoded data
     UnsignedByte* encodedData,
     /// EC info
-    QrmSymbolInfo ecInfo
+    QrmSymbolInfo ecInfo,
+    /// Destination (`ecInfo.codewords` bytes)
+    UnsignedByte* result
 ) {
     unsigned int blockCount = QrmInfoECBlockTotalCount(ecInfo);
     if (blockCount == 1) {
         LOG("ERROR: Interleave not required");
-        return NULL;
-    }
-    ALLOC(UnsignedByte, result, ecInfo.codewords);
-    UnsignedByte* blockPtr[blockCount];
-    UnsignedByte* blockEndPtr[blockCount];
-    UnsignedByte groupCount = QrmInfoGroupCount(ecInfo);
-    unsigned int blockIndex = 0;
-
-    for (UnsignedByte group = 0; group < groupCount; group += 1) {
-        UnsignedByte blockCount = ecInfo.group1Blocks;
-        unsigned int blockSize = ecInfo.group1BlockCodewords;
-        if (group == 1) {
-            blockCount = ecInfo.group2Blocks;
-            blockSize = ecInfo.group2BlockCodewords;
-        }
-        for (UnsignedByte block = 0; block < blockCount; block += 1) {
-            unsigned int offset = 0;
-            if (group == 1) {
-                offset += ecInfo.group1Blocks * ecInfo.group1BlockCodewords;
-            }
-            offset += block * blockSize;
-            blockPtr[blockIndex] = &encodedData[offset];
-            blockEndPtr[blockIndex] = &encodedData[offset + blockSize - 1];
-            blockIndex += 1;
-        }
+        return;
     }
-
-    blockIndex = 0;
+    // Take codeword `index` of each block in turn (group 2 blocks are 1 codeword longer than group 1 blocks)
+    unsigned int group2Offset = ecInfo.group1Blocks * ecInfo.group1BlockCodewords;
+    unsigned int maxBlockSize = ecInfo.group2Blocks > 0 ? ecInfo.group2BlockCodewords : ecInfo.group1BlockCodewords;
     unsigned int resIndex = 0;
-    bool found = true;
-    while (found) {
-        result[resIndex] = *blockPtr[blockIndex];
-        resIndex += 1;
-        blockPtr[blockIndex] += 1;
-
-        unsigned int loopCount = 0;
-        found = false;
-        while (loopCount < blockCount) {
-            blockIndex += 1;
-            if (blockIndex >= blockCount) {
-                blockIndex = 0;
-            }
-            if (blockPtr[blockIndex] <= blockEndPtr[blockIndex]) {
-                found = true;
-                break;
+    for (unsigned int index = 0; index < maxBlockSize; index += 1) {
+        if (index < ecInfo.group1BlockCodewords) {
+            for (unsigned int block = 0; block < ecInfo.group1Blocks; block += 1) {
+                result[resIndex] = encodedData[block * ecInfo.group1BlockCodewords + index];
+                resIndex += 1;
             }
-            loopCount += 1;
+        }
+        for (unsigned int block = 0; block < ecInfo.group2Blocks; block += 1) {
+            result[resIndex] = encodedData[group2Offset + block * ecInfo.group2BlockCodewords + index];
+            resIndex += 1;
         }
     }
-    return result;
 }
 
 /// Interleave error correction codeworks
 /// Throw error if QR has only 1 block in total (check ecInfo before call this function)
-/// @return Binary data (should be deleted on unused)
-UnsignedByte* QRMatrixEncoder_interleaveEC(
+void QRMatrixEncoder_interleaveEC(
     /// Error correction data
     UnsignedByte** data,
     /// EC info
-    QrmSymbolInfo ecInfo
+    QrmSymbolInfo ecInfo,
+    /// Destination (`QrmInfoECCodewordsTotalCount(ecInfo)` bytes)
+    UnsignedByte* result
 ) {
     unsigned int blockCount = QrmInfoECBlockTotalCount(ecInfo);
     if (blockCount == 1) {
         LOG("ERROR: Interleave not required");
-        return NULL;
+        return;
     }
-    ALLOC(UnsignedByte, result, QrmInfoECCodewordsTotalCount(ecInfo));
     unsigned int resIndex = 0;
     for (unsigned int index = 0; index < ecInfo.ecCodewordsPerBlock; index += 1) {
         for (unsigned int jndex = 0; jndex < blockCount; jndex += 1) {
@@ -549,7 +511,6 @@ UnsignedByte* QRMatrixEncoder_interleaveEC(
             resIndex += 1;
         }
     }
-    return result;
 }
 
 // FINALIZE -----------------------------------------------------------------------------------------------------------------------------------------
@@ -562,11 +523,13 @@ void QRMatrixEncoder_clean(UnsignedByte* buffer, UnsignedByte** ecBuffer, QrmSym
     DEALLOC(buffer);
 }
 
-QrmBoard QRMatrixEncoder_finishEncodingData(
+/// Pad data, generate EC then interleave all into final codewords stream.
+/// `buffer` is deleted.
+/// @return Codewords (`version` = 0 if out of memory)
+QrmCodewords QRMatrixEncoder_finishEncodingData(
     UnsignedByte* buffer,
     QrmSymbolInfo ecInfo,
     unsigned int* bitIndex,
-    UnsignedByte maskId,
     QrmExtraEncodingInfo extraMode
 ) {
     bool isMicro = (extraMode.mode == XModeMicroQr);
@@ -576,6 +539,7 @@ QrmBoard QRMatrixEncoder_finishEncodingData(
     if (isMicroV13) {
         bufferBitsLen -= 4;
     }
+    STATS_BEGIN(paddingStart);
     /// Terminator
     unsigned int terminatorLength = isMicro ? QrmGetMicroTerminatorLength(ecInfo.version) : 4;
     for (unsigned int index = 0; *bitIndex < bufferBitsLen && index < terminatorLength; index += 1) {
@@ -615,46 +579,58 @@ QrmBoard QRMatrixEncoder_finishEncodingData(
         }
     }
     *bitIndex = bufferBitsLen;
+    STATS_END(StatsStagePadding, paddingStart);
 
     // Error corrections
+    STATS_BEGIN(ecStart);
     UnsignedByte** ecBuffer = QRMatrixEncoder_generateErrorCorrections(buffer, ecInfo);
+    STATS_END(StatsStageErrorCorrection, ecStart);
+    if (ecBuffer == NULL) {
+        LOG("ERROR: Out of memory.");
+        DEALLOC(buffer);
+        return QrmCodewordsCreateEmpty();
+    }
 
     LOG("Input Data:")
     LOG_BIN(buffer, ecInfo.codewords);
 
+    QrmCodewords result = QrmCodewordsCreate(ecInfo, isMicro);
+    if (result.data == NULL) {
+        LOG("ERROR: Out of memory.");
+        QRMatrixEncoder_clean(buffer, ecBuffer, ecInfo);
+        return result;
+    }
+    UnsignedByte* ecResult = result.data + result.dataLength;
+    STATS_BEGIN(interleaveStart);
     // Interleave ...
     if (QrmInfoECBlockTotalCount(ecInfo) > 1) {
-        UnsignedByte *interleave = QRMatrixEncoder_interleave(buffer, ecInfo);
-        UnsignedByte *ecInterleave = QRMatrixEncoder_interleaveEC(ecBuffer, ecInfo);
+        QRMatrixEncoder_interleave(buffer, ecInfo, result.data);
+        QRMatrixEncoder_interleaveEC(ecBuffer, ecInfo, ecResult);
 
         LOG("Interleave data:");
-        LOG_BIN(interleave, ecInfo.codewords);
+        LOG_BIN(result.data, ecInfo.codewords);
         LOG("Interleave EC:");
-        LOG_BIN(ecInterleave, QrmInfoECCodewordsTotalCount(ecInfo));
-
-        QrmBoard board = QrmBoardCreate(interleave, ecInterleave, ecInfo, maskId, isMicro);
+        LOG_BIN(ecResult, QrmInfoECCodewordsTotalCount(ecInfo));
+    } else {
+        // ... or not
+        LOG("EC:");
+        LOG_BIN(ecBuffer[0], ecInfo.ecCodewordsPerBlock);
 
-        DEALLOC(interleave);
-        DEALLOC(ecInterleave);
-        QRMatrixEncoder_clean(buffer, ecBuffer, ecInfo);
-        return board;
+        memcpy(result.data, buffer, result.dataLength);
+        memcpy(ecResult, ecBuffer[0], result.ecLength);
     }
-    // ... or not
-    LOG("EC:");
-    LOG_BIN(ecBuffer[0], ecInfo.ecCodewordsPerBlock);
-
-    QrmBoard board = QrmBoardCreate(buffer, ecBuffer[0], ecInfo, maskId, isMicro);
+    STATS_END(StatsStageInterleave, interleaveStart);
     QRMatrixEncoder_clean(buffer, ecBuffer, ecInfo);
-    return board;
+    return result;
 }
 
-QrmBoard QRMatrixEncoder_encodeSingle(
+/// Encode segments into final codewords stream
+QrmCodewords QRMatrixEncoder_encodeSingleCodewords(
     QrmSegment* segments,
     unsigned int count,
     QrmErrorCorrectionLevel level,
     QrmExtraEncodingInfo extraMode,
     UnsignedByte minVersion,
-    UnsignedByte maskId,
     UnsignedByte sequenceIndex,
     UnsignedByte sequenceTotal,
     UnsignedByte parity
@@ -667,7 +643,7 @@ QrmBoard QRMatrixEncoder_encodeSingle(
     }
     if (segCount == 0) {
         LOG("ERROR: No input.");
-        return QrmBoardCreateEmpty();
+        return QrmCodewordsCreateEmpty();
     }
     if (extraMode.mode == XModeFnc1Second) {
         bool isValid = false;
@@ -689,20 +665,26 @@ QrmBoard QRMatrixEncoder_encodeSingle(
         }
         if (!isValid) {
             LOG("ERROR: Invalid Application Indicator for FNC1 Second Position mode");
-            return QrmBoardCreateEmpty();
+            return QrmCodewordsCreateEmpty();
         }
     }
     bool isStructuredAppend = sequenceTotal > 0 && sequenceTotal <= 16;
+    STATS_BEGIN(versionStart);
     QrmSymbolInfo ecInfo = QRMatrixEncoder_findVersion(segments, count, level, minVersion, extraMode, isStructuredAppend);
+    STATS_END(StatsStageVersion, versionStart);
     if (ecInfo.version == 0) {
         LOG("ERROR: Unable to find suitable QR version.");
-        return QrmBoardCreateEmpty();
+        return QrmCodewordsCreateEmpty();
     }
     if (isStructuredAppend && extraMode.mode == XModeMicroQr) {
         extraMode = QrmExtraCreateNone();
     }
     // Allocate
     ALLOC(UnsignedByte, buffer, ecInfo.codewords);
+    if (buffer == NULL) {
+        LOG("ERROR: Out of memory.");
+        return QrmCodewordsCreateEmpty();
+    }
     unsigned int bitIndex = 0;
     // Structured append
     if (isStructuredAppend) {
@@ -718,11 +700,38 @@ QrmBoard QRMatrixEncoder_encodeSingle(
         bitIndex += 8;
     }
     // Encode data
+    STATS_BEGIN(segmentsStart);
     for (unsigned int index = 0; index < count; index += 1) {
-        QRMatrixEncoder_encodeSegment(buffer, segments[index], index, level, ecInfo, &bitIndex, extraMode);
+        if (!QRMatrixEncoder_encodeSegment(buffer, segments[index], index, level, ecInfo, &bitIndex, extraMode)) {
+            LOG("ERROR: Out of memory.");
+            DEALLOC(buffer);
+            return QrmCodewordsCreateEmpty();
+        }
+        STATS_SEGMENT(segments[index].mode);
     }
+    STATS_END(StatsStageSegments, segmentsStart);
     // Finish
-    return QRMatrixEncoder_finishEncodingData(buffer, ecInfo, &bitIndex, maskId, extraMode);
+    return QRMatrixEncoder_finishEncodingData(buffer, ecInfo, &bitIndex, extraMode);
+}
+
+QrmBoard QRMatrixEncoder_encodeSingle(
+    QrmSegment* segments,
+    unsigned int count,
+    QrmErrorCorrectionLevel level,
+    QrmExtraEncodingInfo extraMode,
+    UnsignedByte minVersion,
+    UnsignedByte maskId,
+    UnsignedByte sequenceIndex,
+    UnsignedByte sequenceTotal,
+    UnsignedByte parity
+) {
+    QrmCodewords codewords = QRMatrixEncoder_encodeSingleCodewords(
+        segments, count, level, extraMode, minVersion,
+        sequenceIndex, sequenceTotal, parity
+    );
+    QrmBoard board = QrmBoardFromCodewords(codewords, maskId);
+    QrmCodewordsDestroy(&codewords);
+    return board;
 }
 
 // PUBLIC METHODS -----------------------------------------------------------------------------------------------------------------------------------
@@ -735,15 +744,23 @@ QrmBoard QrmEncoderEncode(
     UnsignedByte minVersion,
     UnsignedByte maskId
 ) {
-    if (!qrmIsEnvInited || !qrmIsEnvValid) {
-        LOG("ERROR: Environment is not initialized or invalid");
-        return QrmBoardCreateEmpty();
-    }
     return QRMatrixEncoder_encodeSingle(
         segments, count, level, extraMode, minVersion, maskId, 0, 0, 0
     );
 }
 
+QrmCodewords QrmEncoderEncodeCodewords(
+    QrmSegment* segments,
+    unsigned int count,
+    QrmErrorCorrectionLevel level,
+    QrmExtraEncodingInfo extraMode,
+    UnsignedByte minVersion
+) {
+    return QRMatrixEncoder_encodeSingleCodewords(
+        segments, count, level, extraMode, minVersion, 0, 0, 0
+    );
+}
+
 UnsignedByte QrmEncoderGetVersion(
     QrmSegment* segments,
     unsigned int count,
@@ -764,16 +781,60 @@ UnsignedByte QrmEncoderGetVersion(
     return ecInfo.version;
 }
 
+UnsignedByte QrmEncoderGetStructuredAppendParity(
+    QrmStructuredAppend* parts,
+    unsigned int count
+) {
+    // XOR is associative, so fold 8 bytes at once then fold the word into a single byte.
+    unsigned long long wordParity = 0;
+    UnsignedByte parity = 0;
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmStructuredAppend part = parts[index];
+        for (unsigned int segIndex = 0; segIndex < part.count; segIndex += 1) {
+            QrmSegment segment = part.segments[segIndex];
+            const UnsignedByte* bytes = segment.data;
+            unsigned int length = segment.length;
+            unsigned int idx = 0;
+            for (; idx + sizeof(wordParity) <= length; idx += sizeof(wordParity)) {
+                unsigned long long word;
+                memcpy(&word, bytes + idx, sizeof(word));
+                wordParity ^= word;
+            }
+            for (; idx < length; idx += 1) {
+                parity ^= bytes[idx];
+            }
+        }
+    }
+    wordParity ^= wordParity >> 32;
+    wordParity ^= wordParity >> 16;
+    wordParity ^= wordParity >> 8;
+    return parity ^ (UnsignedByte)wordParity;
+}
+
+QrmBoard QrmEncoderEncodeStructuredAppendPart(
+    QrmStructuredAppend part,
+    UnsignedByte index,
+    UnsignedByte total,
+    UnsignedByte parity
+) {
+    if (total == 0 || total > 16 || index >= total) {
+        LOG("ERROR: Invalid Structured Append sequence");
+        return QrmBoardCreateEmpty();
+    }
+    return QRMatrixEncoder_encodeSingle(
+        part.segments, part.count,
+        part.level, part.extraMode,
+        part.minVersion, part.maskId,
+        index, total, parity
+    );
+}
+
 QrmBoard* QrmEncoderMakeStructuredAppend(
     /// Array of data parts to be encoded
     QrmStructuredAppend* parts,
     /// Number of parts
     unsigned int count
 ) {
-    if (!qrmIsEnvInited || !qrmIsEnvValid) {
-        LOG("ERROR: Environment is not initialized or invalid");
-        return NULL;
-    }
     if (count > 16) {
         LOG("ERROR: Structured Append only accepts 16 parts maximum");
         return NULL;
@@ -786,31 +847,98 @@ QrmBoard* QrmEncoderMakeStructuredAppend(
         // Should change to encode single QR symbol or throw error?
         // But no rule prevents to make a Structured Append QR symbol single part
 //    }
-    UnsignedByte parity = 0;
+    UnsignedByte parity = QrmEncoderGetStructuredAppendParity(parts, count);
+    ALLOC(QrmBoard, result, count);
+    if (result == NULL) {
+        return NULL;
+    }
     for (UnsignedByte index = 0; index < count; index += 1) {
-        QrmStructuredAppend part = parts[index];
-        for (unsigned int segIndex = 0; segIndex < part.count; segIndex += 1) {
-            QrmSegment segment = part.segments[segIndex];
-            for (unsigned int idx = 0; idx < segment.length; idx += 1) {
-                if (index == 0 && segIndex == 0 && idx == 0) {
-                    parity = segment.data[idx];
-                } else {
-                    parity = parity ^ segment.data[idx];
-                }
-            }
+        // Board is moved into result (no copy)
+        result[index] = QrmEncoderEncodeStructuredAppendPart(parts[index], index, count, parity);
+    }
+    return result;
+}
+
+/// Maximum number of bytes (Byte mode) of a Structured Append symbol
+unsigned int QRMatrixEncoder_structuredAppendByteCapacity(UnsignedByte version, QrmErrorCorrectionLevel level) {
+    QrmSymbolInfo info = QrmGetSymbolInfo(version, level, false);
+    unsigned int capacity = info.codewords * 8;
+    // Structured Append header, mode indicator, character count
+    unsigned int headerBits = 20 + 4 + QrmGetCharactersCountIndicatorLength(version, EModeByte, false);
+    if (capacity <= headerBits) {
+        return 0;
+    }
+    return (capacity - headerBits) / 8;
+}
+
+QrmBoard* QrmEncoderStructuredAppendAuto(
+    QrmDataSource source,
+    QrmErrorCorrectionLevel level,
+    UnsignedByte maxVersion,
+    unsigned int* count
+) {
+    *count = 0;
+    if (maxVersion == 0 || maxVersion > QR_MAX_VERSION) {
+        maxVersion = QR_MAX_VERSION;
+    }
+    unsigned int length = 0;
+    bool isOwned = false;
+    UnsignedByte* data = QrmDataSourceRead(source, &length, &isOwned);
+    if (data == NULL) {
+        LOG("ERROR: No input.");
+        return NULL;
+    }
+    // Minimum number of parts
+    unsigned int maxCapacity = QRMatrixEncoder_structuredAppendByteCapacity(maxVersion, level);
+    unsigned int partCount = maxCapacity > 0 ? (length + maxCapacity - 1) / maxCapacity : 0;
+    if (partCount == 0 || partCount > 16) {
+        LOG("ERROR: Data does not fit 16 symbols.");
+        if (isOwned) {
+            DEALLOC(data);
         }
+        return NULL;
     }
-    ALLOC(QrmBoard, result, count);
-    for (UnsignedByte index = 0; index < count; index += 1) {
-        QrmStructuredAppend part = parts[index];
-        QrmBoard board = QRMatrixEncoder_encodeSingle(
-            part.segments, part.count,
-            part.level, part.extraMode,
-            part.minVersion, part.maskId,
-            index, count, parity
-        );
-        QrmBoardCopy(&result[index], board);
-        QrmBoardDestroy(&board);
+    // Even split: biggest part is ceil(length / partCount) bytes
+    unsigned int partLength = length / partCount;
+    unsigned int remaining = length % partCount;
+    unsigned int biggestPart = partLength + (remaining > 0 ? 1 : 0);
+    UnsignedByte version = 1;
+    while (version < maxVersion && QRMatrixEncoder_structuredAppendByteCapacity(version, level) < biggestPart) {
+        version += 1;
+    }
+    // Segments point into input data (no copy, so they are not destroyed)
+    QrmSegment segments[16];
+    QrmStructuredAppend parts[16];
+    unsigned int offset = 0;
+    for (unsigned int index = 0; index < partCount; index += 1) {
+        QrmSegment* segment = &segments[index];
+        segment->mode = EModeByte;
+        segment->eci = DEFAULT_ECI_ASSIGMENT;
+        segment->data = data + offset;
+        segment->length = partLength + (index < remaining ? 1 : 0);
+        offset += segment->length;
+
+        QrmStructuredAppend* part = &parts[index];
+        *part = QrmStrAppCreateEmpty();
+        part->segments = segment;
+        part->count = 1;
+        part->level = level;
+        part->minVersion = version;
+    }
+    UnsignedByte parity = QrmEncoderGetStructuredAppendParity(parts, partCount);
+    ALLOC(QrmBoard, result, partCount);
+    if (result == NULL) {
+        if (isOwned) {
+            DEALLOC(data);
+        }
+        return NULL;
+    }
+    for (unsigned int index = 0; index < partCount; index += 1) {
+        result[index] = QrmEncoderEncodeStructuredAppendPart(parts[index], index, partCount, parity);
+    }
+    if (isOwned) {
+        DEALLOC(data);
     }
+    *count = partCount;
     return result;
 }
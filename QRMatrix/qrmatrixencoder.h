@@ -28,7 +28,7 @@
 #include "qrmatrixsegment.h"
 #include "qrmatrixextramode.h"
 
-/// Must call this first start
+/// Kept for compatibility: does nothing (library is ready to use from any thread without initialization).
 void QRMatrixInit(void);
 
 /// Get QR Version (dimension) to encode given data.
@@ -47,6 +47,7 @@ UnsignedByte QrmEncoderGetVersion(
 );
 
 /// Encode single QR symbol
+/// @return Board (empty if data does not fit or out of memory)
 QrmBoard QrmEncoderEncode(
     /// Array of segments to be encoded
     QrmSegment* segments,
@@ -64,8 +65,47 @@ QrmBoard QrmEncoderEncode(
     UnsignedByte maskId
 );
 
+/// Encode single QR symbol data without making QR board:
+/// result is the final (interleaved data + EC) codewords stream.
+/// Use `QrmBoardFromCodewords` to make QR board later.
+/// @return Codewords (should be deleted when done); `version` = 0 if failed.
+QrmCodewords QrmEncoderEncodeCodewords(
+    /// Array of segments to be encoded
+    QrmSegment* segments,
+    /// Number of segments
+    unsigned int count,
+    /// Error correction info
+    QrmErrorCorrectionLevel level,
+    /// Extra mode
+    QrmExtraEncodingInfo extraMode,
+    /// Optional. Limit minimum version
+    /// (result version = max(minimum version, required version to fit data).
+    UnsignedByte minVersion
+);
+
+/// Parity byte of Structured Append data (XOR of all data bytes of all parts).
+UnsignedByte QrmEncoderGetStructuredAppendParity(
+    /// Array of data parts to be encoded
+    QrmStructuredAppend* parts,
+    /// Number of parts
+    unsigned int count
+);
+
+/// Encode 1 symbol of Structured Append QR symbols.
+/// Use this to encode parts separately (eg. on different threads).
+QrmBoard QrmEncoderEncodeStructuredAppendPart(
+    /// Data part to be encoded
+    QrmStructuredAppend part,
+    /// Position of this part (0...total-1)
+    UnsignedByte index,
+    /// Number of parts (1...16)
+    UnsignedByte total,
+    /// Parity from `QrmEncoderGetStructuredAppendParity`
+    UnsignedByte parity
+);
+
 /// Encode Structured Append QR symbols
-/// @return Array of QRMatrixBoard (should be deleted when done).
+/// @return Array of QRMatrixBoard (should be deleted when done; failed parts are empty boards) or NULL if out of memory.
 QrmBoard* QrmEncoderMakeStructuredAppend(
     /// Array of data parts to be encoded
     QrmStructuredAppend* parts,
@@ -73,4 +113,19 @@ QrmBoard* QrmEncoderMakeStructuredAppend(
     unsigned int count
 );
 
+/// Split data into minimum number of Structured Append symbols (Byte mode, default ECI).
+/// Data is split evenly and all symbols have the same version
+/// (the smallest version which fits the biggest part).
+/// @return Array of QRMatrixBoard (should be deleted when done) or NULL if data does not fit 16 symbols of `maxVersion` (or out of memory).
+QrmBoard* QrmEncoderStructuredAppendAuto(
+    /// Input data
+    QrmDataSource source,
+    /// Error correction level
+    QrmErrorCorrectionLevel level,
+    /// Maximum version of symbols (1...40; 0 = 40)
+    UnsignedByte maxVersion,
+    /// To store number of result boards
+    unsigned int* count
+);
+
 #endif // QRMATRIXENCODER_H
@@ -36,6 +36,10 @@ QrmExtraEncodingInfo QrmExtraDuplicate(QrmExtraEncodingInfo other) {
     if (other.appIndicator != NULL) {
         result.appIndicatorLength = other.appIndicatorLength;
         ALLOC_(UnsignedByte, result.appIndicator, result.appIndicatorLength);
+        if (result.appIndicator == NULL) {
+            result.appIndicatorLength = 0;
+            return result;
+        }
         for (unsigned int index = 0; index < other.appIndicatorLength; index += 1) {
             result.appIndicator[index] = other.appIndicator[index];
         }
@@ -67,6 +71,10 @@ QrmExtraEncodingInfo QrmExtraCreateFnc1Second(const UnsignedByte* appId, Unsigne
     result.mode = XModeFnc1Second;
     result.appIndicatorLength = appIdLen;
     ALLOC_(UnsignedByte, result.appIndicator, appIdLen);
+    if (result.appIndicator == NULL) {
+        result.appIndicatorLength = 0;
+        return result;
+    }
     for (unsigned int index = 0; index < appIdLen; index += 1) {
         result.appIndicator[index] = appId[index];
     }
@@ -94,6 +102,10 @@ QrmStructuredAppend QrmStrAppCreate(QrmSegment* segs, unsigned int segCount, Qrm
     result.extraMode = QrmExtraCreateNone();
     if (segCount > 0 && segs != NULL) {
         ALLOC_(QrmSegment, result.segments, segCount);
+        if (result.segments == NULL) {
+            result.count = 0;
+            return result;
+        }
         for (unsigned int index = 0; index < segCount; index += 1) {
             QrmSegCopy(&result.segments[index], segs[index]);
         }
@@ -124,6 +136,10 @@ QrmStructuredAppend QrmStrAppDuplicate(QrmStructuredAppend other) {
     result.extraMode = QrmExtraDuplicate(other.extraMode);
     if (other.segments != NULL) {
         ALLOC_(QrmSegment, result.segments, other.count);
+        if (result.segments == NULL) {
+            result.count = 0;
+            return result;
+        }
         for (unsigned int index = 0; index < other.count; index += 1) {
             QrmSegCopy(&result.segments[index], other.segments[index]);
         }
@@ -144,8 +160,11 @@ void QrmStrAppFillSegs(QrmStructuredAppend* target, QrmSegment* segs, unsigned i
         target->count = 0;
     }
     if (segs != NULL && segCount > 0) {
-        target->count = segCount;
         ALLOC_(QrmSegment, target->segments, segCount);
+        if (target->segments == NULL) {
+            return;
+        }
+        target->count = segCount;
         for (unsigned int index = 0; index < segCount; index += 1) {
             QrmSegCopy(&target->segments[index], segs[index]);
         }
@@ -25,6 +25,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
 
 // Data Validation ----------------------------------------------------------------------------------------------------------------------------------
 
@@ -51,20 +55,16 @@ bool QrmSeg_validateAlphaNumeric(const UnsignedByte* data, unsigned int length)
 }
 
 bool QrmSeg_validateKanji(const UnsignedByte* data, unsigned int length) {
+#if QRM_NO_KANJI
+    LOG("ERROR: Kanji mode is not supported (QRM_NO_KANJI).");
+    return false;
+#endif
     // Only accept 2 bytes ShiftJIS characters
     if ((length % 2) > 0) {
         return false;
     }
     for (unsigned int index = 0; index < length; index += 2) {
-        Unsigned2Bytes curChar = 0;
-        UnsignedByte* curCharPtr = (UnsignedByte*)&curChar;
-        if (qrmIsLittleEndian) {
-            *curCharPtr = data[index + 1];
-            *(curCharPtr + 1) = data[index];
-        } else {
-            *curCharPtr = data[index];
-            *(curCharPtr + 1) = data[index + 1];
-        }
+        Unsigned2Bytes curChar = (Unsigned2Bytes)((data[index] << 8) | data[index + 1]);
         bool isValid = (
             (curChar >= 0x8140) && (curChar <= 0x9FFC)) ||
             ((curChar >= 0xE040) && (curChar <= 0xEBBF)
@@ -112,6 +112,9 @@ QrmSegment QrmSegCreate(QrmEncodingMode mode, const UnsignedByte *data, unsigned
     result.eci = eciIndicator;
     if (result.length > 0 && data != NULL) {
         ALLOC_(UnsignedByte, result.data, result.length);
+        if (result.data == NULL) {
+            return QrmSegCreateEmpty();
+        }
         for (unsigned int index = 0; index < result.length; index += 1) {
             result.data[index] = data[index];
         }
@@ -141,6 +144,10 @@ void QrmSegFill(QrmSegment* segment, QrmEncodingMode mode, const UnsignedByte* d
     segment->eci = eciIndicator;
     if (length > 0 && data != NULL) {
         ALLOC_(UnsignedByte, segment->data, segment->length);
+        if (segment->data == NULL) {
+            segment->length = 0;
+            return;
+        }
         for (unsigned int index = 0; index < segment->length; index += 1) {
             segment->data[index] = data[index];
         }
@@ -161,6 +168,10 @@ QrmSegment QrmSegDuplicate(QrmSegment other) {
     result.eci = other.eci;
     if (result.length > 0 && other.data != NULL) {
         ALLOC_(UnsignedByte, result.data, result.length);
+        if (result.data == NULL) {
+            result.length = 0;
+            return result;
+        }
         for (unsigned int index = 0; index < result.length; index += 1) {
             result.data[index] = other.data[index];
         }
@@ -170,3 +181,85 @@ QrmSegment QrmSegDuplicate(QrmSegment other) {
     }
     return result;
 }
+
+bool QrmSegValidate(QrmEncodingMode mode, const UnsignedByte* data, unsigned int length) {
+    return QrmSeg_validateInputBytes(mode, data, length);
+}
+
+// DATA SOURCE --------------------------------------------------------------------------------------------------------------------------------------
+
+QrmDataSource QrmDataSourceCreateBuffer(const UnsignedByte* data, unsigned int length) {
+    QrmDataSource result;
+    result.data = data;
+    result.length = data != NULL ? length : 0;
+    result.fileDescriptor = -1;
+    return result;
+}
+
+QrmDataSource QrmDataSourceCreateFile(int fileDescriptor) {
+    QrmDataSource result;
+    result.data = NULL;
+    result.length = 0;
+    result.fileDescriptor = fileDescriptor;
+    return result;
+}
+
+UnsignedByte* QrmDataSourceRead(QrmDataSource source, unsigned int* length, bool* isOwned) {
+    *length = 0;
+    *isOwned = false;
+    if (source.fileDescriptor < 0) {
+        if (source.data == NULL || source.length == 0) {
+            return NULL;
+        }
+        *length = source.length;
+        return (UnsignedByte*)source.data;
+    }
+    // Regular file: allocate once by its size; pipe: grow buffer
+    unsigned int capacity = 4096;
+    struct stat info;
+    if (fstat(source.fileDescriptor, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        capacity = (unsigned int)info.st_size + 1;
+    }
+    ALLOC(UnsignedByte, result, capacity);
+    unsigned int count = 0;
+    bool isFailed = result == NULL;
+    while (!isFailed) {
+        if (count == capacity) {
+            if (capacity > UINT_MAX / 2) {
+                isFailed = true;
+                break;
+            }
+            capacity *= 2;
+            // Keep old buffer to release it if failed
+            UnsignedByte* grown = result;
+            REALLOC(UnsignedByte, grown, capacity);
+            if (grown == NULL) {
+                isFailed = true;
+                break;
+            }
+            result = grown;
+        }
+        ssize_t readCount = read(source.fileDescriptor, result + count, capacity - count);
+        if (readCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            isFailed = true;
+            break;
+        }
+        if (readCount == 0) {
+            break;
+        }
+        count += (unsigned int)readCount;
+    }
+    if (isFailed || count == 0) {
+        LOG("ERROR: Unable to read input.");
+        if (result != NULL) {
+            DEALLOC(result);
+        }
+        return NULL;
+    }
+    *length = count;
+    *isOwned = true;
+    return result;
+}
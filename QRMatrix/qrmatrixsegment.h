@@ -61,5 +61,32 @@ void QrmSegFill(QrmSegment* segment, QrmEncodingMode mode, const UnsignedByte* d
 void QrmSegCopy(QrmSegment* segment, QrmSegment other);
 /// Copy constructor
 QrmSegment QrmSegDuplicate(QrmSegment other);
+/// Check if given bytes can be encoded by given mode (the validation of `QrmSegCreate`).
+bool QrmSegValidate(QrmEncodingMode mode, const UnsignedByte* data, unsigned int length);
+
+/// Input bytes from memory or from a file descriptor.
+typedef struct {
+    /// Memory source (used when `fileDescriptor` < 0). Not copied.
+    const UnsignedByte* data;
+    /// Number of `data` bytes
+    unsigned int length;
+    /// File descriptor source (read until end of file; not closed).
+    int fileDescriptor;
+} QrmDataSource;
+
+/// Source from memory
+QrmDataSource QrmDataSourceCreateBuffer(const UnsignedByte* data, unsigned int length);
+/// Source from file descriptor (file, pipe, socket ...)
+QrmDataSource QrmDataSourceCreateFile(int fileDescriptor);
+/// Get all bytes of source.
+/// Memory source is returned directly; file descriptor is read once into a new buffer.
+/// @return Bytes (must be deleted if `isOwned` is true) or NULL if empty/failed (including read error).
+UnsignedByte* QrmDataSourceRead(
+    QrmDataSource source,
+    /// To store number of bytes
+    unsigned int* length,
+    /// To store if result is a new buffer
+    bool* isOwned
+);
 
 #endif // QRMATRIXSEGMENT_H
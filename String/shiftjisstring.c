@@ -133,8 +133,10 @@ ShiftJisString SjCreateFromUnicodes(const UnicodePoint unicodes) {
         return result;
     }
 
-    Unsigned2Bytes (*map1)[188] = ShiftJisString_KanjiUnicode1Map(); // 31
-    Unsigned2Bytes (*map2)[188] = ShiftJisString_KanjiUnicode2Map(); // 29
+#if !QRM_NO_KANJI
+    const Unsigned2Bytes (*map1)[188] = ShiftJisString_KanjiUnicode1Map(); // 31
+    const Unsigned2Bytes (*map2)[188] = ShiftJisString_KanjiUnicode2Map(); // 29
+#endif
 
     ALLOC_(UnsignedByte, result.charsMap, result.charCount);
 
@@ -172,6 +174,7 @@ ShiftJisString SjCreateFromUnicodes(const UnicodePoint unicodes) {
         } else {
             UnsignedByte firstByte = 0;
             UnsignedByte secondByte = 0;
+#if !QRM_NO_KANJI
             for (UnsignedByte idx = 0; idx < 31; idx += 1) {
                 for (UnsignedByte jdx = 0; jdx < 188; jdx += 1) {
                     Unsigned2Bytes code = map1[idx][jdx];
@@ -198,6 +201,7 @@ ShiftJisString SjCreateFromUnicodes(const UnicodePoint unicodes) {
                     }
                 }
             }
+#endif
             if (firstByte == 0) {
                 LOG("ERROR: Given data contains invalid character.");
                 break;
@@ -266,8 +270,10 @@ UnicodePoint SjToUnicodes(ShiftJisString source) {
     }
     UnicodePoint result = UPCreateEmpty(source.charCount);
     UnsignedByte* charPtr = source.raw;
-    Unsigned2Bytes (*map1)[188] = ShiftJisString_KanjiUnicode1Map();
-    Unsigned2Bytes (*map2)[188] = ShiftJisString_KanjiUnicode2Map();
+#if !QRM_NO_KANJI
+    const Unsigned2Bytes (*map1)[188] = ShiftJisString_KanjiUnicode1Map();
+    const Unsigned2Bytes (*map2)[188] = ShiftJisString_KanjiUnicode2Map();
+#endif
 
     for (unsigned int index = 0; index < source.charCount; index += 1) {
         UnsignedByte charSize = source.charsMap[index];
@@ -284,6 +290,7 @@ UnicodePoint SjToUnicodes(ShiftJisString source) {
                 point = curByte - 0xA1 + 0xFF61;
             }
         } else {
+#if !QRM_NO_KANJI
             UnsignedByte nextByte = *(charPtr + 1);
             UnsignedByte secondIndex = nextByte - 0x40;
             if (nextByte > 0x7F) {
@@ -302,6 +309,7 @@ UnicodePoint SjToUnicodes(ShiftJisString source) {
                     point = (Unsigned4Bytes)value;
                 }
             }
+#endif
         }
         result.raw[index] = point;
         charPtr += charSize;
@@ -22,9 +22,11 @@
 
 #include "shiftjisstringmap.h"
 
+#if !QRM_NO_KANJI
+
 /// Unicode map for Kanji in 0x8100...0x9FFF
-Unsigned2Bytes (*(ShiftJisString_KanjiUnicode1Map)())[188] {
-    static Unsigned2Bytes result[][188] = {
+const Unsigned2Bytes (*(ShiftJisString_KanjiUnicode1Map)(void))[188] {
+    static const Unsigned2Bytes result[][188] = {
         {
             0x3000 /*　 0x8140*/, 0x3001 /*、 0x8141*/, 0x3002 /*。 0x8142*/, 0xFF0C /*， 0x8143*/, 0xFF0E /*． 0x8144*/, 0x30FB /*・ 0x8145*/,
             0xFF1A /*： 0x8146*/, 0xFF1B /*； 0x8147*/, 0xFF1F /*？ 0x8148*/, 0xFF01 /*！ 0x8149*/, 0x309B /*゛ 0x814A*/, 0x309C /*゜ 0x814B*/,
@@ -1084,8 +1086,8 @@ Unsigned2Bytes (*(ShiftJisString_KanjiUnicode1Map)())[188] {
 }
 
 /// Unicode map for Kanji in 0xE000...0xFCFF
-Unsigned2Bytes (*(ShiftJisString_KanjiUnicode2Map)())[188] {
-    static Unsigned2Bytes result[][188] = {
+const Unsigned2Bytes (*(ShiftJisString_KanjiUnicode2Map)(void))[188] {
+    static const Unsigned2Bytes result[][188] = {
         {
             0x6F3E /*漾 0xE040*/, 0x6F13 /*漓 0xE041*/, 0x6EF7 /*滷 0xE042*/, 0x6F86 /*澆 0xE043*/, 0x6F7A /*潺 0xE044*/, 0x6F78 /*潸 0xE045*/,
             0x6F81 /*澁 0xE046*/, 0x6F80 /*澀 0xE047*/, 0x6F6F /*潯 0xE048*/, 0x6F5B /*潛 0xE049*/, 0x6FF3 /*濳 0xE04A*/, 0x6F6D /*潭 0xE04B*/,
@@ -2075,3 +2077,5 @@ Unsigned2Bytes (*(ShiftJisString_KanjiUnicode2Map)())[188] {
     };
     return result;
 }
+
+#endif
@@ -25,9 +25,13 @@
 
 #include "../QRMatrix/constants.h"
 
+#if !QRM_NO_KANJI
+
 /// Unicode map for Kanji in 0x8100...0x9FFF (31 lines)
-Unsigned2Bytes (*(ShiftJisString_KanjiUnicode1Map)(void))[188];
+const Unsigned2Bytes (*(ShiftJisString_KanjiUnicode1Map)(void))[188];
 /// Unicode map for Kanji in 0xE000...0xFCFF (29 lines)
-Unsigned2Bytes (*(ShiftJisString_KanjiUnicode2Map)(void))[188];
+const Unsigned2Bytes (*(ShiftJisString_KanjiUnicode2Map)(void))[188];
+
+#endif
 
 #endif // SHIFTJISSTRINGMAP_H
@@ -92,6 +92,9 @@ UnicodePoint UPSubstring(UnicodePoint source, unsigned int startIndex, unsigned
 }
 
 bool UnicodePoint_testKanji(Unsigned4Bytes point) {
+#if QRM_NO_KANJI
+    return false;
+#endif
     UnicodePoint unicodes = UPCreate(&point, 1);
     ShiftJisString shiftjis = SjCreateFromUnicodes(unicodes);
     bool result = shiftjis.isValid && shiftjis.minBytesPerChar > 1 && shiftjis.maxBytesPerChar > 1;
@@ -137,7 +137,7 @@ Utf8String U8Create(
     return result;
 }
 
-unsigned char* U8String_fromUnicode(UnsignedByte* codePtr, UnsignedByte* destPtr, const unsigned char charSize) {
+unsigned char* U8String_fromUnicode(Unsigned4Bytes code, UnsignedByte* destPtr, const unsigned char charSize) {
     unsigned char prefix = 0;
     switch (charSize) {
     case 2:
@@ -154,20 +154,15 @@ unsigned char* U8String_fromUnicode(UnsignedByte* codePtr, UnsignedByte* destPtr
     }
     UnsignedByte secondaryPrefix = SECONDARY_BYTE_PREFIX;
     unsigned int prefixBitLen = charSize + 1;
-    const unsigned int sourceSize = 4 * 8;
     // Fist byte
-    unsigned int firstByteDataLen = 8 - prefixBitLen;
-    unsigned int sourceIndex = sourceSize - firstByteDataLen - ((unsigned int)charSize - 1) * 6;
-    *destPtr = prefix;
-    QrmCopyBits(codePtr, 4, sourceIndex, qrmIsLittleEndian, destPtr, prefixBitLen, firstByteDataLen);
+    unsigned int shift = ((unsigned int)charSize - 1) * 6;
+    *destPtr = prefix | (UnsignedByte)((code >> shift) & (0xFF >> prefixBitLen));
     destPtr += 1;
-    sourceIndex += firstByteDataLen;
     // Next bytes
-    for (int index = 0; index < charSize - 1; index += 1) {
-        *destPtr = secondaryPrefix;
-        QrmCopyBits(codePtr, 4, sourceIndex, qrmIsLittleEndian, destPtr, 2, 6);
+    while (shift > 0) {
+        shift -= 6;
+        *destPtr = secondaryPrefix | (UnsignedByte)((code >> shift) & 0x3F);
         destPtr += 1;
-        sourceIndex += 6;
     }
     return destPtr;
 }
@@ -219,12 +214,11 @@ Utf8String U8CreateFromUnicodes(
     for (int index = 0; index < length; index += 1) {
         UnsignedByte charSize = result.charsMap[index];
         Unsigned4Bytes code = codes[index];
-        UnsignedByte* codePtr = (UnsignedByte*)&code;
         if (charSize == 1) {
             *ptr = (UnsignedByte)code;
             ptr += 1;
         } else {
-            ptr = U8String_fromUnicode(codePtr, ptr, charSize);
+            ptr = U8String_fromUnicode(code, ptr, charSize);
         }
     }
 
@@ -233,30 +227,14 @@ Utf8String U8CreateFromUnicodes(
 }
 
 Unsigned4Bytes U8String_toUnicode(UnsignedByte* source, UnsignedByte charSize) {
-    unsigned int u4BSize = (unsigned int)sizeof(Unsigned4Bytes);
     Unsigned4Bytes result = 0;
-    UnsignedByte* resultPtr = (UnsignedByte*)&result;
-    unsigned int resultBitIndex = u4BSize * 8;
     if (charSize == 1) {
         result = (Unsigned4Bytes)*source;
     } else {
-        UnsignedByte* lastByte = source + charSize - 1;
-        for (int index = 0; index < charSize; index += 1) {
-            UnsignedByte *curByte = lastByte - index;
-            unsigned int prefixBitCount = 2;
-            if (curByte == source) {
-                prefixBitCount = charSize + 1;
-            }
-            unsigned int bitCount = 8 - prefixBitCount;
-            resultBitIndex -= bitCount;
-            QrmCopyBits(curByte, 1, prefixBitCount, qrmIsLittleEndian, resultPtr, resultBitIndex, bitCount);
-        }
-        if (qrmIsLittleEndian) { // Reverse bytes
-            Unsigned4Bytes tmp = result;
-            UnsignedByte* tmpPtr = (UnsignedByte*)&tmp;
-            for (int index = 0; index < u4BSize; index += 1) {
-                resultPtr[index] = tmpPtr[u4BSize - index - 1];
-            }
+        // First byte: data bits after `charSize + 1` prefix bits; next bytes: 6 data bits each
+        result = (Unsigned4Bytes)(source[0] & (0xFF >> (charSize + 1)));
+        for (int index = 1; index < charSize; index += 1) {
+            result = (result << 6) | (Unsigned4Bytes)(source[index] & 0x3F);
         }
     }
     return result;
@@ -0,0 +1,544 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Per-stage micro-benchmarks of QRMatrix.
+// Usage: qrmatrix_bench [--filter TEXT] [--min-time MILLISECONDS] [--quick] [--output FILE]
+// Result (JSON): time (ns/op), allocations/op & bytes/op of each benchmark.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "qrmatrixencoder.h"
+#include "Encoder/numericencoder.h"
+#include "Encoder/alphanumericencoder.h"
+#include "Encoder/kanjiencoder.h"
+#include "Allocator/countingallocator.h"
+#include "Stats/stats.h"
+#include "String/utf8string.h"
+#include "String/unicodepoint.h"
+#include "String/latinstring.h"
+#include "String/shiftjisstring.h"
+
+// Internal functions of QRMatrix (not declared in public headers)
+UnsignedByte** QRMatrixEncoder_generateErrorCorrections(UnsignedByte* encodedData, QrmSymbolInfo ecInfo);
+void QRMatrixEncoder_interleave(UnsignedByte* encodedData, QrmSymbolInfo ecInfo, UnsignedByte* result);
+void QRMatrixEncoder_interleaveEC(UnsignedByte** data, QrmSymbolInfo ecInfo, UnsignedByte* result);
+UnsignedByte** QrmBoard_mask(QrmBoard board, UnsignedByte maskNum);
+unsigned int QrmBoard_evaluateCondition1(UnsignedByte dimension, UnsignedByte** maskedBoard);
+unsigned int QrmBoard_evaluateCondition2(UnsignedByte dimension, UnsignedByte** maskedBoard);
+unsigned int QrmBoard_evaluateCondition3(UnsignedByte dimension, UnsignedByte** maskedBoard);
+unsigned int QrmBoard_evaluateCondition4(UnsignedByte dimension, UnsignedByte** maskedBoard);
+unsigned int QrmBoard_evaluateMicro(UnsignedByte dimension, UnsignedByte** maskedBoard);
+
+#define BENCH_MAX_PAYLOAD 8192
+
+typedef struct {
+    const char* filter;
+    unsigned long long minTime;
+    bool isQuick;
+    FILE* output;
+    unsigned int count;
+    QrmCountingAllocator counting;
+} QrmBench;
+
+typedef void (*QrmBench_Operation)(void* context);
+
+/// Symbol & data of benchmark
+typedef struct {
+    UnsignedByte version;
+    bool isMicro;
+    QrmErrorCorrectionLevel level;
+    QrmSymbolInfo ecInfo;
+    QrmEncodingMode mode;
+    UnsignedByte* payload;
+    unsigned int length;
+    QrmSegment segment;
+    UnsignedByte* buffer;
+    UnsignedByte* data;
+    UnsignedByte** ecBlocks;
+    QrmCodewords codewords;
+    UnsignedByte** masked;
+    UnsignedByte dimension;
+    UnicodePoint unicodes;
+    unsigned int bits;
+} QrmBench_Case;
+
+const char* QrmBench_levelName(QrmErrorCorrectionLevel level) {
+    switch (level) {
+    case ELevelLow:
+        return "L";
+    case ELevelMedium:
+        return "M";
+    case ELevelQuarter:
+        return "Q";
+    case ELevelHigh:
+        return "H";
+    }
+    return "";
+}
+
+const char* QrmBench_modeName(QrmEncodingMode mode) {
+    switch (mode) {
+    case EModeNumeric:
+        return "numeric";
+    case EModeAlphaNumeric:
+        return "alphaNumeric";
+    case EModeByte:
+        return "byte";
+    case EModeKanji:
+        return "kanji";
+    }
+    return "";
+}
+
+/// JSON fields of symbol (version, micro, level)
+void QrmBench_symbolFields(char* buffer, size_t size, QrmBench_Case* item) {
+    snprintf(
+        buffer, size, "\"version\": %u, \"micro\": %s, \"level\": \"%s\"",
+        item->version, item->isMicro ? "true" : "false", QrmBench_levelName(item->level)
+    );
+}
+
+/// Measure `operation` & write result
+void QrmBench_run(QrmBench* bench, const char* name, const char* fields, QrmBench_Operation operation, void* context) {
+    if (bench->filter != NULL && strstr(name, bench->filter) == NULL) {
+        return;
+    }
+    // Warm up & count allocations of 1 operation
+    QrmCountingAllocatorReset(bench->counting);
+    QrmAllocator previous = QrmSetThreadAllocator(bench->counting.allocator);
+    operation(context);
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(bench->counting);
+    // Double number of iterations until it takes minimum time
+    unsigned long long iterations = 1;
+    unsigned long long elapsed = 0;
+    QrmStatsSnapshot before;
+    QrmStatsSnapshot after;
+    while (true) {
+        before = QrmStatsGetSnapshot();
+        unsigned long long start = QrmStatsClock();
+        for (unsigned long long index = 0; index < iterations; index += 1) {
+            operation(context);
+        }
+        elapsed = QrmStatsClock() - start;
+        after = QrmStatsGetSnapshot();
+        if (elapsed >= bench->minTime || iterations >= (1ULL << 40)) {
+            break;
+        }
+        unsigned long long estimate = elapsed > 0 ? iterations * bench->minTime / elapsed + 1 : iterations * 100;
+        iterations = estimate > iterations * 100 ? iterations * 100 : (estimate > iterations * 2 ? estimate : iterations * 2);
+    }
+    fprintf(
+        bench->output, "%s    {\"name\": \"%s\"%s%s, \"iterations\": %llu, \"nsPerOp\": %.1f, \"allocsPerOp\": %llu, \"bytesPerOp\": %llu",
+        bench->count > 0 ? ",\n" : "", name, fields[0] != 0 ? ", " : "", fields, iterations,
+        (double)elapsed / iterations, counters.allocationCount, counters.totalBytes
+    );
+    // Encoding stages executed by operation
+    bool hasStage = false;
+    for (unsigned int stage = 0; stage < StatsStageCount; stage += 1) {
+        unsigned long long time = after.stageNanoseconds[stage] - before.stageNanoseconds[stage];
+        if (after.stageCounts[stage] == before.stageCounts[stage]) {
+            continue;
+        }
+        fprintf(
+            bench->output, "%s\"%s\": %.1f", hasStage ? ", " : ", \"stageNsPerOp\": {",
+            QrmStatsStageName(stage), (double)time / iterations
+        );
+        hasStage = true;
+    }
+    fprintf(bench->output, "%s}", hasStage ? "}" : "");
+    fflush(bench->output);
+    bench->count += 1;
+}
+
+// DATA =====================================================================================================
+
+/// Fill `payload` with `count` characters of `mode`
+/// @return Number of bytes
+unsigned int QrmBench_makePayload(QrmEncodingMode mode, unsigned int count, UnsignedByte* payload) {
+    static const char* alphaNumeric = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    // ShiftJIS kanji characters: 日本語字
+    static const UnsignedByte kanji[] = { 0x93, 0xFA, 0x96, 0x7B, 0x8C, 0xEA, 0x8E, 0x9A };
+    Unsigned4Bytes random = 12345;
+    for (unsigned int index = 0; index < count; index += 1) {
+        random = random * 1103515245 + 12345;
+        switch (mode) {
+        case EModeNumeric:
+            payload[index] = (UnsignedByte)('0' + (random >> 16) % 10);
+            break;
+        case EModeAlphaNumeric:
+            payload[index] = (UnsignedByte)alphaNumeric[(random >> 16) % 45];
+            break;
+        case EModeByte:
+            payload[index] = (UnsignedByte)(random >> 16);
+            break;
+        case EModeKanji: {
+            unsigned int character = (random >> 16) % 4;
+            payload[2 * index] = kanji[2 * character];
+            payload[2 * index + 1] = kanji[2 * character + 1];
+        }
+            break;
+        }
+    }
+    return mode == EModeKanji ? count * 2 : count;
+}
+
+/// Version which fits `count` characters (0 if none)
+UnsignedByte QrmBench_versionOf(QrmBench_Case* item, unsigned int count, UnsignedByte* payload) {
+    unsigned int length = QrmBench_makePayload(item->mode, count, payload);
+    QrmSegment segment = QrmSegCreate(item->mode, payload, length, DEFAULT_ECI_ASSIGMENT);
+    QrmExtraEncodingInfo extra = item->isMicro ? QrmExtraCreate(XModeMicroQr) : QrmExtraCreateNone();
+    UnsignedByte result = QrmEncoderGetVersion(&segment, 1, item->level, extra, false);
+    QrmSegDestroy(&segment);
+    QrmExtraDestroy(&extra);
+    return result;
+}
+
+/// Make payload of maximum length which fits symbol
+/// @return false if data of mode does not fit symbol
+bool QrmBench_makeFullPayload(QrmBench_Case* item) {
+    unsigned int maxCount = item->mode == EModeKanji ? BENCH_MAX_PAYLOAD / 2 : BENCH_MAX_PAYLOAD;
+    unsigned int low = 0;
+    unsigned int high = maxCount;
+    while (low < high) {
+        unsigned int middle = (low + high + 1) / 2;
+        UnsignedByte version = QrmBench_versionOf(item, middle, item->payload);
+        if (version > 0 && version <= item->version) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    if (low == 0) {
+        return false;
+    }
+    item->length = QrmBench_makePayload(item->mode, low, item->payload);
+    return true;
+}
+
+// OPERATIONS ===============================================================================================
+
+void QrmBench_copyBits(void* context) {
+    QrmBench_Case* item = context;
+    for (unsigned int index = 0; index < 64; index += 1) {
+        QrmCopyBits(item->payload, 4, 32 - item->bits, true, item->buffer, index * 7, item->bits);
+    }
+}
+
+void QrmBench_copyValueBits(void* context) {
+    QrmBench_Case* item = context;
+    for (unsigned int index = 0; index < 64; index += 1) {
+        QrmCopyValueBits(0x78563412, item->bits, item->buffer, index * 7);
+    }
+}
+
+void QrmBench_encodeMode(void* context) {
+    QrmBench_Case* item = context;
+    switch (item->mode) {
+    case EModeNumeric:
+        QrmNumericEncode(item->payload, item->length, item->buffer, 4);
+        break;
+    case EModeAlphaNumeric:
+        QrmAlphaNumericEncode(item->payload, item->length, item->buffer, 4);
+        break;
+    case EModeByte:
+        QrmCopyBits(item->payload, item->length, 0, false, item->buffer, 4, item->length * 8);
+        break;
+    case EModeKanji:
+        QrmKanjiEncode(item->payload, item->length, item->buffer, 4);
+        break;
+    }
+}
+
+void QrmBench_encode(void* context) {
+    QrmBench_Case* item = context;
+    QrmExtraEncodingInfo extra = item->isMicro ? QrmExtraCreate(XModeMicroQr) : QrmExtraCreateNone();
+    QrmBoard board = QrmEncoderEncode(&item->segment, 1, item->level, extra, item->version, 0xFF);
+    QrmBoardDestroy(&board);
+    QrmExtraDestroy(&extra);
+}
+
+void QrmBench_freeBlocks(UnsignedByte** blocks, QrmSymbolInfo ecInfo) {
+    unsigned int count = QrmInfoECBlockTotalCount(ecInfo);
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmFree(blocks[index]);
+    }
+    QrmFree(blocks);
+}
+
+void QrmBench_errorCorrection(void* context) {
+    QrmBench_Case* item = context;
+    QrmBench_freeBlocks(QRMatrixEncoder_generateErrorCorrections(item->data, item->ecInfo), item->ecInfo);
+}
+
+void QrmBench_interleave(void* context) {
+    QrmBench_Case* item = context;
+    QRMatrixEncoder_interleave(item->data, item->ecInfo, item->buffer);
+    QRMatrixEncoder_interleaveEC(item->ecBlocks, item->ecInfo, item->buffer + item->ecInfo.codewords);
+}
+
+void QrmBench_board(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard board = QrmBoardFromCodewords(item->codewords, 0xFF);
+    QrmBoardDestroy(&board);
+}
+
+void QrmBench_boardFixedMask(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard board = QrmBoardFromCodewords(item->codewords, 0);
+    QrmBoardDestroy(&board);
+}
+
+void QrmBench_mask(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard board = QrmBoardFromCodewords(item->codewords, 0);
+    UnsignedByte** masked = QrmBoard_mask(board, 0);
+    for (UnsignedByte row = 0; row < board.dimension; row += 1) {
+        QrmFree(masked[row]);
+    }
+    QrmFree(masked);
+    QrmBoardDestroy(&board);
+}
+
+void QrmBench_condition1(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard_evaluateCondition1(item->dimension, item->masked);
+}
+
+void QrmBench_condition2(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard_evaluateCondition2(item->dimension, item->masked);
+}
+
+void QrmBench_condition3(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard_evaluateCondition3(item->dimension, item->masked);
+}
+
+void QrmBench_condition4(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard_evaluateCondition4(item->dimension, item->masked);
+}
+
+void QrmBench_conditionMicro(void* context) {
+    QrmBench_Case* item = context;
+    QrmBoard_evaluateMicro(item->dimension, item->masked);
+}
+
+void QrmBench_utf8ToUnicodes(void* context) {
+    QrmBench_Case* item = context;
+    Utf8String text = U8Create(item->payload, item->length);
+    UnicodePoint unicodes = U8ToUnicodes(text);
+    UPDestroy(&unicodes);
+    U8Destroy(&text);
+}
+
+void QrmBench_unicodesToUtf8(void* context) {
+    QrmBench_Case* item = context;
+    Utf8String text = U8CreateFromUnicodes(item->unicodes);
+    U8Destroy(&text);
+}
+
+void QrmBench_unicodesToShiftJis(void* context) {
+    QrmBench_Case* item = context;
+    ShiftJisString text = SjCreateFromUnicodes(item->unicodes);
+    SjDestroy(&text);
+}
+
+void QrmBench_unicodesToLatin(void* context) {
+    QrmBench_Case* item = context;
+    LatinString text = LtCreateFromUnicodes(item->unicodes);
+    LtDestroy(&text);
+}
+
+void QrmBench_makeSegments(void* context) {
+    QrmBench_Case* item = context;
+    unsigned int count = 0;
+    QrmSegment* segments = UPMakeSegments(item->unicodes, item->level, &count, false);
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmSegDestroy(&segments[index]);
+    }
+    QrmFree(segments);
+}
+
+// SUITES ===================================================================================================
+
+void QrmBench_runCopyBits(QrmBench* bench, QrmBench_Case* item) {
+    static const unsigned int bitCounts[] = { 4, 8, 13, 32 };
+    memcpy(item->payload, "\x12\x34\x56\x78", 4);
+    for (unsigned int index = 0; index < sizeof(bitCounts) / sizeof(bitCounts[0]); index += 1) {
+        char fields[64];
+        item->bits = bitCounts[index];
+        snprintf(fields, sizeof(fields), "\"bits\": %u, \"calls\": 64", item->bits);
+        QrmBench_run(bench, "copyBits", fields, QrmBench_copyBits, item);
+        QrmBench_run(bench, "copyValueBits", fields, QrmBench_copyValueBits, item);
+    }
+}
+
+/// Benchmarks of symbol (version & level)
+void QrmBench_runSymbol(QrmBench* bench, QrmBench_Case* item, bool isPenaltyIncluded) {
+    char fields[256];
+    char symbolFields[128];
+    QrmBench_symbolFields(symbolFields, sizeof(symbolFields), item);
+    // Modes
+    static const QrmEncodingMode modes[] = { EModeNumeric, EModeAlphaNumeric, EModeByte, EModeKanji };
+    for (unsigned int index = 0; index < 4; index += 1) {
+        item->mode = modes[index];
+        if (!QrmBench_makeFullPayload(item)) {
+            continue;
+        }
+        snprintf(fields, sizeof(fields), "%s, \"mode\": \"%s\", \"length\": %u", symbolFields, QrmBench_modeName(item->mode), item->length);
+        item->segment = QrmSegCreate(item->mode, item->payload, item->length, DEFAULT_ECI_ASSIGMENT);
+        char name[64];
+        snprintf(name, sizeof(name), "encoder.%s", QrmBench_modeName(item->mode));
+        QrmBench_run(bench, name, fields, QrmBench_encodeMode, item);
+        QrmBench_run(bench, "encode", fields, QrmBench_encode, item);
+        QrmSegDestroy(&item->segment);
+    }
+    // Codewords stages (data is not important)
+    ALLOC(UnsignedByte, data, item->ecInfo.codewords);
+    item->data = data;
+    QrmBench_makePayload(EModeByte, item->ecInfo.codewords, item->data);
+    QrmBench_run(bench, "errorCorrection", symbolFields, QrmBench_errorCorrection, item);
+    item->ecBlocks = QRMatrixEncoder_generateErrorCorrections(item->data, item->ecInfo);
+    QrmBench_run(bench, "interleave", symbolFields, QrmBench_interleave, item);
+    // Board
+    item->codewords = QrmCodewordsCreate(item->ecInfo, item->isMicro);
+    QrmBench_makePayload(EModeByte, item->codewords.dataLength + item->codewords.ecLength, item->codewords.data);
+    QrmBench_run(bench, "board", symbolFields, QrmBench_board, item);
+    QrmBench_run(bench, "board.fixedMask", symbolFields, QrmBench_boardFixedMask, item);
+    if (isPenaltyIncluded) {
+        QrmBench_run(bench, "penalty.mask", symbolFields, QrmBench_mask, item);
+        QrmBoard board = QrmBoardFromCodewords(item->codewords, 0);
+        item->masked = QrmBoard_mask(board, 0);
+        item->dimension = board.dimension;
+        if (item->isMicro) {
+            QrmBench_run(bench, "penalty.micro", symbolFields, QrmBench_conditionMicro, item);
+        } else {
+            QrmBench_run(bench, "penalty.condition1", symbolFields, QrmBench_condition1, item);
+            QrmBench_run(bench, "penalty.condition2", symbolFields, QrmBench_condition2, item);
+            QrmBench_run(bench, "penalty.condition3", symbolFields, QrmBench_condition3, item);
+            QrmBench_run(bench, "penalty.condition4", symbolFields, QrmBench_condition4, item);
+        }
+        for (UnsignedByte row = 0; row < board.dimension; row += 1) {
+            QrmFree(item->masked[row]);
+        }
+        QrmFree(item->masked);
+        QrmBoardDestroy(&board);
+    }
+    QrmCodewordsDestroy(&item->codewords);
+    QrmBench_freeBlocks(item->ecBlocks, item->ecInfo);
+    DEALLOC(item->data);
+}
+
+void QrmBench_runStrings(QrmBench* bench, QrmBench_Case* item) {
+    // Mixed text: ASCII, Latin-1, Japanese
+    static const char* sample = "QRMatrix 0123456789 caf\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E ";
+    static const unsigned int lengths[] = { 256, 4096 };
+    size_t sampleLength = strlen(sample);
+    for (unsigned int index = 0; index < 2; index += 1) {
+        item->length = 0;
+        while (item->length + sampleLength <= lengths[index]) {
+            memcpy(item->payload + item->length, sample, sampleLength);
+            item->length += sampleLength;
+        }
+        Utf8String text = U8Create(item->payload, item->length);
+        item->unicodes = U8ToUnicodes(text);
+        U8Destroy(&text);
+        item->level = ELevelMedium;
+        char fields[64];
+        snprintf(fields, sizeof(fields), "\"bytes\": %u, \"characters\": %u", item->length, item->unicodes.length);
+        QrmBench_run(bench, "string.utf8ToUnicodes", fields, QrmBench_utf8ToUnicodes, item);
+        QrmBench_run(bench, "string.unicodesToUtf8", fields, QrmBench_unicodesToUtf8, item);
+        QrmBench_run(bench, "string.unicodesToShiftJis", fields, QrmBench_unicodesToShiftJis, item);
+        QrmBench_run(bench, "string.unicodesToLatin", fields, QrmBench_unicodesToLatin, item);
+        QrmBench_run(bench, "string.makeSegments", fields, QrmBench_makeSegments, item);
+        UPDestroy(&item->unicodes);
+    }
+}
+
+bool QrmBench_isQuickVersion(UnsignedByte version) {
+    return version == 1 || version == 2 || version == 5 || version == 10 || version == 20 || version == 40;
+}
+
+int main(int argc, char** argv) {
+    QrmBench bench;
+    memset(&bench, 0, sizeof(bench));
+    bench.minTime = 10 * 1000000ULL;
+    bench.output = stdout;
+    for (int index = 1; index < argc; index += 1) {
+        if (strcmp(argv[index], "--filter") == 0 && index + 1 < argc) {
+            bench.filter = argv[++index];
+        } else if (strcmp(argv[index], "--min-time") == 0 && index + 1 < argc) {
+            bench.minTime = strtoull(argv[++index], NULL, 10) * 1000000ULL;
+        } else if (strcmp(argv[index], "--quick") == 0) {
+            bench.isQuick = true;
+        } else if (strcmp(argv[index], "--output") == 0 && index + 1 < argc) {
+            bench.output = fopen(argv[++index], "w");
+            if (bench.output == NULL) {
+                fprintf(stderr, "Unable to open %s\n", argv[index]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Usage: %s [--filter TEXT] [--min-time MILLISECONDS] [--quick] [--output FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    QRMatrixInit();
+    bench.counting = QrmCountingAllocatorCreate(QrmAllocatorCreateDefault());
+    QrmBench_Case item;
+    memset(&item, 0, sizeof(item));
+    ALLOC(UnsignedByte, payload, BENCH_MAX_PAYLOAD * 2);
+    ALLOC(UnsignedByte, buffer, BENCH_MAX_PAYLOAD * 2);
+    item.payload = payload;
+    item.buffer = buffer;
+    fprintf(bench.output, "{\n  \"library\": \"QRMatrix\",\n  \"libraryVersion\": \"%s\",\n  \"minTimeMs\": %llu,\n  \"benchmarks\": [\n", VERSION, bench.minTime / 1000000ULL);
+    QrmBench_runCopyBits(&bench, &item);
+    static const QrmErrorCorrectionLevel levels[] = { ELevelLow, ELevelMedium, ELevelQuarter, ELevelHigh };
+    for (unsigned int symbol = 0; symbol < 44; symbol += 1) {
+        item.isMicro = symbol >= 40;
+        item.version = item.isMicro ? symbol - 39 : symbol + 1;
+        if (bench.isQuick && !item.isMicro && !QrmBench_isQuickVersion(item.version)) {
+            continue;
+        }
+        for (unsigned int level = 0; level < 4; level += 1) {
+            item.level = levels[level];
+            item.ecInfo = QrmGetSymbolInfo(item.version, item.level, item.isMicro);
+            if (item.ecInfo.version == 0 || item.ecInfo.codewords == 0) {
+                continue;
+            }
+            // Penalty evaluation does not depend on level
+            QrmBench_runSymbol(&bench, &item, level == 0 || (item.isMicro && item.version == 1));
+        }
+        fprintf(stderr, "%s%u done\n", item.isMicro ? "M" : "Version ", item.version);
+    }
+    QrmBench_runStrings(&bench, &item);
+    fprintf(bench.output, "\n  ]\n}\n");
+    DEALLOC(payload);
+    DEALLOC(buffer);
+    QrmCountingAllocatorDestroy(&bench.counting);
+    if (bench.output != stdout) {
+        fclose(bench.output);
+    }
+    return 0;
+}
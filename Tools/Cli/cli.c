@@ -0,0 +1,1108 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Batch encoder: read records (NDJSON or CSV) from a file (memory mapped) or stdin,
+// encode them on worker threads, write SVG / PNG / PBM files (or stdout) or a board archive.
+// Usage: qrmatrix [options] [INPUT] (see `QrmCli_printUsage`)
+//
+// Record fields: payload (text, required), level (L, M, Q, H), mode (auto, numeric, alphanumeric, byte, kanji), name (output name).
+// - NDJSON: {"payload": "Hello", "level": "H", "name": "hello"} (other keys are ignored)
+// - CSV: payload,level,mode,name (only payload is required; quoted fields as of RFC 4180; header line "payload,..." is skipped)
+//
+// Pipeline: reader thread -> input queue -> encoder threads -> output queue -> writer thread.
+// Records are passed in batches; the number of batches is fixed, so memory usage is bounded
+// (reader waits for a free batch when encoders or writer are slower).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "qrmatrixencoder.h"
+#include "ThreadPool/threadpool.h"
+#include "Archive/boardarchive.h"
+#include "Render/svgwriter.h"
+#include "Render/pngwriter.h"
+#include "Render/pbmwriter.h"
+#include "Common/payload.h"
+
+/// Number of records per batch
+#define CLI_BATCH_SIZE 64
+/// Number of batches per encoder thread
+#define CLI_BATCHES_PER_THREAD 4
+/// Stdout output is written when buffered data reaches this size
+#define CLI_WRITE_BUFFER_SIZE (1 << 20)
+/// Initial buffer size of stdin input
+#define CLI_READ_BUFFER_SIZE (1 << 20)
+/// Read pages of mapped input are released after each this number of bytes
+#define CLI_RELEASE_SIZE (8 << 20)
+
+typedef enum {
+    FormatNdjson,
+    FormatCsv
+} QrmCli_InputFormat;
+
+typedef enum {
+    OutputSvg,
+    OutputPng,
+    OutputPbm,
+    OutputArchive
+} QrmCli_OutputFormat;
+
+/// Parsed record. Strings are in `arena` of batch.
+typedef struct {
+    size_t payload;
+    unsigned int payloadLength;
+    size_t name;
+    unsigned int nameLength;
+    QrmErrorCorrectionLevel level;
+    QrmPayloadHint mode;
+    /// Error of parsing or encoding (NULL = success)
+    const char* error;
+} QrmCli_Record;
+
+/// Records passed through pipeline
+typedef struct {
+    /// Order of batch in input
+    unsigned long long sequence;
+    /// Number of first record in input (1 based)
+    unsigned long long firstRecord;
+    unsigned int count;
+    QrmCli_Record records[CLI_BATCH_SIZE];
+    char* arena;
+    size_t arenaLength;
+    size_t arenaCapacity;
+    /// Rendered images (file outputs)
+    QrmOutput outputs[CLI_BATCH_SIZE];
+    /// Boards (archive output)
+    QrmBoard boards[CLI_BATCH_SIZE];
+} QrmCli_Batch;
+
+/// Blocking queue of batches. Capacity is the number of all batches, so `push` never waits.
+typedef struct {
+    QrmCli_Batch** items;
+    unsigned int capacity;
+    unsigned int head;
+    unsigned int count;
+    bool isClosed;
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+} QrmCli_Queue;
+
+/// Source of records: memory mapped file or stdin
+typedef struct {
+    int file;
+    const char* data;
+    size_t length;
+    size_t position;
+    /// Mapped input: pages before this offset are released
+    size_t released;
+    bool isMapped;
+    bool isEnd;
+    /// Stdin buffer
+    char* buffer;
+    size_t capacity;
+} QrmCli_Input;
+
+typedef struct {
+    // Options
+    QrmCli_InputFormat inputFormat;
+    QrmCli_OutputFormat outputFormat;
+    QrmErrorCorrectionLevel level;
+    QrmPayloadHint mode;
+    const char* outputDirectory;
+    const char* archivePath;
+    unsigned int scale;
+    unsigned int threadCount;
+    bool isOrdered;
+    bool isQuiet;
+    // Pipeline
+    QrmCli_Input input;
+    QrmCli_Batch* batches;
+    unsigned int batchCount;
+    QrmCli_Queue freeQueue;
+    QrmCli_Queue inputQueue;
+    QrmCli_Queue outputQueue;
+    QrmArchiveWriter archive;
+    // Results (written by writer thread)
+    unsigned long long recordCount;
+    unsigned long long failureCount;
+    bool isOutputFailed;
+    /// Set by writer on output failure: reader stops reading & encoders skip remaining records
+    _Atomic bool isStopped;
+} QrmCli;
+
+// QUEUE ====================================================================================================
+
+bool QrmCli_queueInit(QrmCli_Queue* queue, unsigned int capacity) {
+    memset(queue, 0, sizeof(QrmCli_Queue));
+    queue->items = QrmAlloc(capacity, sizeof(QrmCli_Batch*));
+    queue->capacity = capacity;
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->condition, NULL);
+    return queue->items != NULL;
+}
+
+void QrmCli_queueDestroy(QrmCli_Queue* queue) {
+    pthread_mutex_destroy(&queue->mutex);
+    pthread_cond_destroy(&queue->condition);
+    DEALLOC(queue->items);
+}
+
+void QrmCli_queuePush(QrmCli_Queue* queue, QrmCli_Batch* batch) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->items[(queue->head + queue->count) % queue->capacity] = batch;
+    queue->count += 1;
+    pthread_cond_signal(&queue->condition);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+/// Wait for next batch.
+/// @return NULL if queue is closed and empty
+QrmCli_Batch* QrmCli_queuePop(QrmCli_Queue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->count == 0 && !queue->isClosed) {
+        pthread_cond_wait(&queue->condition, &queue->mutex);
+    }
+    QrmCli_Batch* result = NULL;
+    if (queue->count > 0) {
+        result = queue->items[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count -= 1;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return result;
+}
+
+bool QrmCli_queueIsEmpty(QrmCli_Queue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    bool result = queue->count == 0;
+    pthread_mutex_unlock(&queue->mutex);
+    return result;
+}
+
+/// No more push: waiting & later `pop` return NULL when queue is empty
+void QrmCli_queueClose(QrmCli_Queue* queue) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->isClosed = true;
+    pthread_cond_broadcast(&queue->condition);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+// INPUT ====================================================================================================
+
+/// Open input file (memory mapped) or stdin (`path` = NULL or "-")
+bool QrmCli_inputOpen(QrmCli_Input* input, const char* path) {
+    memset(input, 0, sizeof(QrmCli_Input));
+    input->file = -1;
+    if (path == NULL || strcmp(path, "-") == 0) {
+        input->file = STDIN_FILENO;
+        input->buffer = QrmAlloc(CLI_READ_BUFFER_SIZE, 1);
+        input->capacity = CLI_READ_BUFFER_SIZE;
+        input->data = input->buffer;
+        return input->buffer != NULL;
+    }
+    input->file = open(path, O_RDONLY);
+    if (input->file < 0) {
+        fprintf(stderr, "qrmatrix: unable to open %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    struct stat info;
+    if (fstat(input->file, &info) != 0) {
+        fprintf(stderr, "qrmatrix: unable to read %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    input->isMapped = true;
+    input->length = (size_t)info.st_size;
+    if (input->length == 0) {
+        return true;
+    }
+    void* data = mmap(NULL, input->length, PROT_READ, MAP_PRIVATE, input->file, 0);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "qrmatrix: unable to map %s: %s\n", path, strerror(errno));
+        return false;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(data, input->length, MADV_SEQUENTIAL);
+#endif
+    input->data = data;
+    return true;
+}
+
+void QrmCli_inputClose(QrmCli_Input* input) {
+    if (input->isMapped) {
+        if (input->data != NULL) {
+            munmap((void*)input->data, input->length);
+        }
+        if (input->file >= 0) {
+            close(input->file);
+        }
+    }
+    DEALLOC(input->buffer);
+    input->data = NULL;
+}
+
+/// Read more stdin data into buffer (unread data is moved to the beginning; buffer grows if it is full).
+/// @return false if end of input
+bool QrmCli_inputFill(QrmCli_Input* input) {
+    if (input->isMapped || input->isEnd) {
+        return false;
+    }
+    size_t remain = input->length - input->position;
+    memmove(input->buffer, input->buffer + input->position, remain);
+    input->position = 0;
+    input->length = remain;
+    if (input->length == input->capacity) {
+        char* buffer = QrmRealloc(input->buffer, input->capacity * 2);
+        if (buffer == NULL) {
+            fprintf(stderr, "qrmatrix: out of memory\n");
+            input->isEnd = true;
+            return false;
+        }
+        input->buffer = buffer;
+        input->capacity *= 2;
+    }
+    ssize_t count;
+    do {
+        count = read(input->file, input->buffer + input->length, input->capacity - input->length);
+    } while (count < 0 && errno == EINTR);
+    input->data = input->buffer;
+    if (count <= 0) {
+        input->isEnd = true;
+        return false;
+    }
+    input->length += (size_t)count;
+    return true;
+}
+
+/// Release pages of mapped input which are read (records are copied into batches),
+/// so resident memory does not grow with input size.
+void QrmCli_inputRelease(QrmCli_Input* input) {
+    if (!input->isMapped || input->position - input->released < CLI_RELEASE_SIZE) {
+        return;
+    }
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = input->position / pageSize * pageSize;
+#ifdef MADV_DONTNEED
+    madvise((void*)(input->data + input->released), end - input->released, MADV_DONTNEED);
+#endif
+    input->released = end;
+}
+
+/// Get next record text (without line terminator). CSV records may contain line breaks in quoted fields.
+/// Result is valid until next call.
+/// @return false if end of input
+bool QrmCli_inputNext(QrmCli_Input* input, bool isCsv, const char** record, size_t* length) {
+    size_t scanned = 0;
+    bool isQuoted = false;
+    QrmCli_inputRelease(input);
+    while (true) {
+        const char* start = input->data + input->position;
+        size_t available = input->length - input->position;
+        size_t end = scanned;
+        if (isCsv) {
+            while (end < available && (isQuoted || start[end] != '\n')) {
+                if (start[end] == '"') {
+                    isQuoted = !isQuoted;
+                }
+                end += 1;
+            }
+        } else {
+            const char* newLine = end < available ? memchr(start + end, '\n', available - end) : NULL;
+            end = newLine != NULL ? (size_t)(newLine - start) : available;
+        }
+        if (end < available || !QrmCli_inputFill(input)) {
+            // Data may be moved by `QrmCli_inputFill`
+            start = input->data + input->position;
+            available = input->length - input->position;
+            if (available == 0) {
+                return false;
+            }
+            *record = start;
+            *length = end;
+            input->position += end < available ? end + 1 : end;
+            if (*length > 0 && start[*length - 1] == '\r') {
+                *length -= 1;
+            }
+            return true;
+        }
+        // Data moved: continue scanning after checked part
+        scanned = end;
+    }
+}
+
+// PARSER ===================================================================================================
+
+/// Append bytes to arena of batch
+/// @return Offset of bytes in arena (SIZE_MAX if out of memory)
+size_t QrmCli_arenaAppend(QrmCli_Batch* batch, const char* data, size_t length) {
+    if (batch->arenaLength + length > batch->arenaCapacity) {
+        size_t capacity = batch->arenaCapacity > 0 ? batch->arenaCapacity : 4096;
+        while (capacity < batch->arenaLength + length) {
+            capacity *= 2;
+        }
+        char* arena = QrmRealloc(batch->arena, capacity);
+        if (arena == NULL) {
+            return (size_t)-1;
+        }
+        batch->arena = arena;
+        batch->arenaCapacity = capacity;
+    }
+    size_t result = batch->arenaLength;
+    memcpy(batch->arena + result, data, length);
+    batch->arenaLength += length;
+    return result;
+}
+
+/// Append Unicode code point as UTF-8
+void QrmCli_arenaAppendUtf8(QrmCli_Batch* batch, Unsigned4Bytes code) {
+    char bytes[4];
+    size_t length;
+    if (code < 0x80) {
+        bytes[0] = (char)code;
+        length = 1;
+    } else if (code < 0x800) {
+        bytes[0] = (char)(0xC0 | (code >> 6));
+        bytes[1] = (char)(0x80 | (code & 0x3F));
+        length = 2;
+    } else if (code < 0x10000) {
+        bytes[0] = (char)(0xE0 | (code >> 12));
+        bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (code & 0x3F));
+        length = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (code >> 18));
+        bytes[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (code & 0x3F));
+        length = 4;
+    }
+    QrmCli_arenaAppend(batch, bytes, length);
+}
+
+bool QrmCli_parseLevel(const char* text, size_t length, QrmErrorCorrectionLevel* level) {
+    if (length == 0) {
+        return true;
+    }
+    switch (text[0]) {
+    case 'L':
+    case 'l':
+        *level = ELevelLow;
+        return true;
+    case 'M':
+    case 'm':
+        *level = ELevelMedium;
+        return true;
+    case 'Q':
+    case 'q':
+        *level = ELevelQuarter;
+        return true;
+    case 'H':
+    case 'h':
+        *level = ELevelHigh;
+        return true;
+    }
+    return false;
+}
+
+/// Set field of record from value in arena (`offset`, `length`)
+/// @return Error message or NULL
+const char* QrmCli_setField(QrmCli_Batch* batch, QrmCli_Record* record, unsigned int column, size_t offset, size_t length) {
+    switch (column) {
+    case 0:
+        record->payload = offset;
+        record->payloadLength = (unsigned int)length;
+        break;
+    case 1:
+        if (!QrmCli_parseLevel(batch->arena + offset, length, &record->level)) {
+            return "invalid level";
+        }
+        break;
+    case 2:
+        if (!QrmPayloadParseHint(batch->arena + offset, length, &record->mode)) {
+            return "invalid mode";
+        }
+        break;
+    case 3:
+        record->name = offset;
+        record->nameLength = (unsigned int)length;
+        break;
+    }
+    return NULL;
+}
+
+const char* QrmCli_parseCsv(QrmCli_Batch* batch, QrmCli_Record* record, const char* text, size_t length) {
+    size_t position = 0;
+    unsigned int column = 0;
+    while (true) {
+        size_t offset = batch->arenaLength;
+        if (position < length && text[position] == '"') {
+            position += 1;
+            while (true) {
+                const char* quote = memchr(text + position, '"', length - position);
+                if (quote == NULL) {
+                    return "unterminated quote";
+                }
+                size_t end = (size_t)(quote - text);
+                QrmCli_arenaAppend(batch, text + position, end - position);
+                position = end + 1;
+                if (position < length && text[position] == '"') {
+                    QrmCli_arenaAppend(batch, "\"", 1);
+                    position += 1;
+                } else {
+                    break;
+                }
+            }
+        } else {
+            const char* comma = position < length ? memchr(text + position, ',', length - position) : NULL;
+            size_t end = comma != NULL ? (size_t)(comma - text) : length;
+            QrmCli_arenaAppend(batch, text + position, end - position);
+            position = end;
+        }
+        const char* error = QrmCli_setField(batch, record, column, offset, batch->arenaLength - offset);
+        if (error != NULL) {
+            return error;
+        }
+        column += 1;
+        if (position >= length) {
+            return NULL;
+        }
+        if (text[position] != ',') {
+            return "invalid CSV field";
+        }
+        position += 1;
+    }
+}
+
+size_t QrmCli_skipSpaces(const char* text, size_t length, size_t position) {
+    while (position < length && (text[position] == ' ' || text[position] == '\t' || text[position] == '\r')) {
+        position += 1;
+    }
+    return position;
+}
+
+int QrmCli_hexValue(char character) {
+    if (character >= '0' && character <= '9') {
+        return character - '0';
+    }
+    if (character >= 'a' && character <= 'f') {
+        return character - 'a' + 10;
+    }
+    if (character >= 'A' && character <= 'F') {
+        return character - 'A' + 10;
+    }
+    return -1;
+}
+
+/// Read 4 hex digits of `\u` escape
+bool QrmCli_parseHex4(const char* text, size_t length, size_t position, Unsigned4Bytes* code) {
+    if (position + 4 > length) {
+        return false;
+    }
+    *code = 0;
+    for (unsigned int index = 0; index < 4; index += 1) {
+        int value = QrmCli_hexValue(text[position + index]);
+        if (value < 0) {
+            return false;
+        }
+        *code = (*code << 4) | (Unsigned4Bytes)value;
+    }
+    return true;
+}
+
+/// Parse JSON string at `*position` (opening quote) into arena. `*position` is moved after closing quote.
+/// @return false if invalid
+bool QrmCli_parseJsonString(QrmCli_Batch* batch, const char* text, size_t length, size_t* position) {
+    size_t index = *position + 1;
+    while (index < length) {
+        size_t start = index;
+        while (index < length && text[index] != '"' && text[index] != '\\') {
+            index += 1;
+        }
+        QrmCli_arenaAppend(batch, text + start, index - start);
+        if (index >= length) {
+            return false;
+        }
+        if (text[index] == '"') {
+            *position = index + 1;
+            return true;
+        }
+        // Escape
+        index += 1;
+        if (index >= length) {
+            return false;
+        }
+        char escaped = text[index];
+        index += 1;
+        switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+            QrmCli_arenaAppend(batch, &escaped, 1);
+            break;
+        case 'b':
+            QrmCli_arenaAppend(batch, "\b", 1);
+            break;
+        case 'f':
+            QrmCli_arenaAppend(batch, "\f", 1);
+            break;
+        case 'n':
+            QrmCli_arenaAppend(batch, "\n", 1);
+            break;
+        case 'r':
+            QrmCli_arenaAppend(batch, "\r", 1);
+            break;
+        case 't':
+            QrmCli_arenaAppend(batch, "\t", 1);
+            break;
+        case 'u': {
+            Unsigned4Bytes code;
+            if (!QrmCli_parseHex4(text, length, index, &code)) {
+                return false;
+            }
+            index += 4;
+            // Surrogate pair
+            Unsigned4Bytes low;
+            if (code >= 0xD800 && code < 0xDC00 && index + 1 < length && text[index] == '\\' && text[index + 1] == 'u' &&
+                QrmCli_parseHex4(text, length, index + 2, &low) && low >= 0xDC00 && low < 0xE000) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                index += 6;
+            }
+            QrmCli_arenaAppendUtf8(batch, code);
+        }
+            break;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+/// Skip JSON value which is not string (number, literal, object or array)
+/// @return false if invalid
+bool QrmCli_skipJsonValue(const char* text, size_t length, size_t* position) {
+    unsigned int depth = 0;
+    bool isQuoted = false;
+    size_t index = *position;
+    while (index < length) {
+        char character = text[index];
+        if (isQuoted) {
+            if (character == '\\') {
+                index += 1;
+            } else if (character == '"') {
+                isQuoted = false;
+            }
+        } else if (character == '"') {
+            isQuoted = true;
+        } else if (character == '{' || character == '[') {
+            depth += 1;
+        } else if (character == '}' || character == ']') {
+            if (depth == 0) {
+                break;
+            }
+            depth -= 1;
+        } else if (character == ',' && depth == 0) {
+            break;
+        }
+        index += 1;
+    }
+    *position = index;
+    return depth == 0 && !isQuoted;
+}
+
+/// Parse flat JSON object (string values of known keys; other keys are ignored)
+const char* QrmCli_parseJson(QrmCli_Batch* batch, QrmCli_Record* record, const char* text, size_t length) {
+    static const char* keys[] = { "payload", "level", "mode", "name" };
+    size_t position = QrmCli_skipSpaces(text, length, 0);
+    if (position >= length || text[position] != '{') {
+        return "invalid JSON: object expected";
+    }
+    position = QrmCli_skipSpaces(text, length, position + 1);
+    if (position < length && text[position] == '}') {
+        return NULL;
+    }
+    while (position < length) {
+        // Key
+        if (text[position] != '"') {
+            return "invalid JSON: key expected";
+        }
+        size_t keyOffset = batch->arenaLength;
+        if (!QrmCli_parseJsonString(batch, text, length, &position)) {
+            return "invalid JSON string";
+        }
+        size_t keyLength = batch->arenaLength - keyOffset;
+        unsigned int column = sizeof(keys) / sizeof(keys[0]);
+        for (unsigned int index = 0; index < sizeof(keys) / sizeof(keys[0]); index += 1) {
+            if (strlen(keys[index]) == keyLength && memcmp(keys[index], batch->arena + keyOffset, keyLength) == 0) {
+                column = index;
+                break;
+            }
+        }
+        batch->arenaLength = keyOffset;
+        position = QrmCli_skipSpaces(text, length, position);
+        if (position >= length || text[position] != ':') {
+            return "invalid JSON: ':' expected";
+        }
+        position = QrmCli_skipSpaces(text, length, position + 1);
+        // Value
+        if (position < length && text[position] == '"') {
+            size_t offset = batch->arenaLength;
+            if (!QrmCli_parseJsonString(batch, text, length, &position)) {
+                return "invalid JSON string";
+            }
+            const char* error = QrmCli_setField(batch, record, column, offset, batch->arenaLength - offset);
+            if (error != NULL) {
+                return error;
+            }
+        } else if (!QrmCli_skipJsonValue(text, length, &position)) {
+            return "invalid JSON value";
+        } else if (column == 0) {
+            return "payload must be string";
+        }
+        position = QrmCli_skipSpaces(text, length, position);
+        if (position < length && text[position] == '}') {
+            return NULL;
+        }
+        if (position >= length || text[position] != ',') {
+            return "invalid JSON: ',' or '}' expected";
+        }
+        position = QrmCli_skipSpaces(text, length, position + 1);
+    }
+    return "invalid JSON: unterminated object";
+}
+
+// PIPELINE =================================================================================================
+
+/// Reader thread: parse records into batches
+void* QrmCli_readerMain(void* context) {
+    QrmCli* cli = context;
+    bool isCsv = cli->inputFormat == FormatCsv;
+    unsigned long long sequence = 0;
+    unsigned long long recordNumber = 0;
+    QrmCli_Batch* batch = NULL;
+    const char* text;
+    size_t length;
+    while (!atomic_load(&cli->isStopped) && QrmCli_inputNext(&cli->input, isCsv, &text, &length)) {
+        size_t start = QrmCli_skipSpaces(text, length, 0);
+        if (start == length) {
+            continue;
+        }
+        recordNumber += 1;
+        // CSV header
+        if (isCsv && recordNumber == 1 && length >= 7 && strncmp(text, "payload", 7) == 0 && (length == 7 || text[7] == ',')) {
+            recordNumber = 0;
+            continue;
+        }
+        if (batch == NULL) {
+            batch = QrmCli_queuePop(&cli->freeQueue);
+            batch->sequence = sequence;
+            batch->firstRecord = recordNumber;
+            batch->count = 0;
+            batch->arenaLength = 0;
+            sequence += 1;
+        }
+        QrmCli_Record* record = &batch->records[batch->count];
+        memset(record, 0, sizeof(QrmCli_Record));
+        record->level = cli->level;
+        record->mode = cli->mode;
+        record->error = isCsv ? QrmCli_parseCsv(batch, record, text, length) : QrmCli_parseJson(batch, record, text, length);
+        if (record->error == NULL && record->payloadLength == 0) {
+            record->error = "empty payload";
+        }
+        batch->count += 1;
+        if (batch->count == CLI_BATCH_SIZE) {
+            QrmCli_queuePush(&cli->inputQueue, batch);
+            batch = NULL;
+        }
+    }
+    if (batch != NULL) {
+        QrmCli_queuePush(&cli->inputQueue, batch);
+    }
+    QrmCli_queueClose(&cli->inputQueue);
+    return NULL;
+}
+
+/// Encode & render record
+void QrmCli_encodeRecord(QrmCli* cli, QrmCli_Batch* batch, unsigned int index) {
+    QrmCli_Record* record = &batch->records[index];
+    QrmOutput* output = &batch->outputs[index];
+    QrmOutputReset(output);
+    batch->boards[index] = QrmBoardCreateEmpty();
+    if (record->error == NULL && atomic_load(&cli->isStopped)) {
+        record->error = "output failed";
+    }
+    if (record->error != NULL) {
+        return;
+    }
+    unsigned int count = 0;
+    QrmSegment* segments = QrmPayloadMakeSegments(
+        (const UnsignedByte*)batch->arena + record->payload, record->payloadLength, record->level, record->mode, &count, &record->error
+    );
+    if (segments == NULL) {
+        return;
+    }
+    QrmBoard board = QrmEncoderEncode(segments, count, record->level, QrmExtraCreateNone(), 0, 0xFF);
+    QrmPayloadDestroySegments(segments, count);
+    if (board.dimension == 0) {
+        QrmBoardDestroy(&board);
+        record->error = "data too long";
+        return;
+    }
+    bool isSuccess = true;
+    switch (cli->outputFormat) {
+    case OutputSvg:
+        isSuccess = QrmSvgWrite(output, board, cli->scale, 4, QrmSvgStyleCreate("white", "black"));
+        break;
+    case OutputPng:
+        isSuccess = QrmPngWrite(output, board, cli->scale, 4);
+        break;
+    case OutputPbm:
+        isSuccess = QrmPbmWrite(output, board, cli->scale, 4);
+        break;
+    case OutputArchive:
+        batch->boards[index] = board;
+        return;
+    }
+    QrmBoardDestroy(&board);
+    if (!isSuccess) {
+        record->error = "render failed";
+    }
+}
+
+/// Encoder task (1 per thread of pool)
+void QrmCli_encoderMain(void* context, unsigned int index) {
+    (void)index;
+    QrmCli* cli = context;
+    QrmCli_Batch* batch;
+    while ((batch = QrmCli_queuePop(&cli->inputQueue)) != NULL) {
+        for (unsigned int record = 0; record < batch->count; record += 1) {
+            QrmCli_encodeRecord(cli, batch, record);
+        }
+        QrmCli_queuePush(&cli->outputQueue, batch);
+    }
+}
+
+bool QrmCli_writeStdout(QrmOutput* buffer) {
+    bool result = fwrite(buffer->buffer, 1, buffer->length, stdout) == buffer->length;
+    QrmOutputReset(buffer);
+    return result;
+}
+
+/// Write file `directory/name.extension` (name is record number if record has no name)
+bool QrmCli_writeFile(QrmCli* cli, QrmCli_Batch* batch, unsigned int index) {
+    static const char* extensions[] = { "svg", "png", "pbm" };
+    QrmCli_Record* record = &batch->records[index];
+    char name[256];
+    if (record->nameLength > 0) {
+        unsigned int length = record->nameLength < sizeof(name) - 1 ? record->nameLength : (unsigned int)sizeof(name) - 1;
+        memcpy(name, batch->arena + record->name, length);
+        name[length] = 0;
+        // Keep file in output directory
+        for (unsigned int position = 0; position < length; position += 1) {
+            if (name[position] == '/' || name[position] == '\\' || name[position] == 0) {
+                name[position] = '_';
+            }
+        }
+        if (name[0] == '.') {
+            name[0] = '_';
+        }
+    } else {
+        snprintf(name, sizeof(name), "%llu", batch->firstRecord + index);
+    }
+    size_t pathLength = strlen(cli->outputDirectory) + strlen(name) + 6;
+    ALLOC(char, path, pathLength);
+    if (path == NULL) {
+        return false;
+    }
+    snprintf(path, pathLength, "%s/%s.%s", cli->outputDirectory, name, extensions[cli->outputFormat]);
+    FILE* file = fopen(path, "wb");
+    bool result = file != NULL;
+    if (file != NULL) {
+        result = fwrite(batch->outputs[index].buffer, 1, batch->outputs[index].length, file) == batch->outputs[index].length;
+        result = fclose(file) == 0 && result;
+    }
+    if (!result) {
+        fprintf(stderr, "qrmatrix: unable to write %s: %s\n", path, strerror(errno));
+    }
+    DEALLOC(path);
+    return result;
+}
+
+/// Output failed (writer thread): later records fail & pipeline stops
+void QrmCli_failOutput(QrmCli* cli) {
+    cli->isOutputFailed = true;
+    atomic_store(&cli->isStopped, true);
+}
+
+/// Write results of batch (writer thread)
+void QrmCli_writeBatch(QrmCli* cli, QrmCli_Batch* batch, QrmOutput* stdoutBuffer) {
+    for (unsigned int index = 0; index < batch->count; index += 1) {
+        QrmCli_Record* record = &batch->records[index];
+        cli->recordCount += 1;
+        if (record->error == NULL && cli->isOutputFailed) {
+            record->error = "output failed";
+        }
+        if (record->error == NULL) {
+            if (cli->outputFormat == OutputArchive) {
+                const char* key = batch->arena + (record->nameLength > 0 ? record->name : record->payload);
+                unsigned int keyLength = record->nameLength > 0 ? record->nameLength : record->payloadLength;
+                if (!QrmArchiveWriterAppend(cli->archive, (const UnsignedByte*)key, keyLength, batch->boards[index])) {
+                    fprintf(stderr, "qrmatrix: unable to write archive %s\n", cli->archivePath);
+                    QrmCli_failOutput(cli);
+                }
+            } else if (cli->outputDirectory != NULL) {
+                if (!QrmCli_writeFile(cli, batch, index)) {
+                    QrmCli_failOutput(cli);
+                }
+            } else {
+                QrmOutputWrite(stdoutBuffer, batch->outputs[index].buffer, batch->outputs[index].length);
+                if (stdoutBuffer->length >= CLI_WRITE_BUFFER_SIZE && !QrmCli_writeStdout(stdoutBuffer)) {
+                    fprintf(stderr, "qrmatrix: unable to write output: %s\n", strerror(errno));
+                    QrmCli_failOutput(cli);
+                }
+            }
+            if (cli->isOutputFailed) {
+                record->error = "output failed";
+            }
+        }
+        if (record->error != NULL) {
+            cli->failureCount += 1;
+            if (!cli->isQuiet) {
+                fprintf(stderr, "qrmatrix: record %llu: %s\n", batch->firstRecord + index, record->error);
+            }
+        }
+        QrmBoardDestroy(&batch->boards[index]);
+    }
+}
+
+/// Writer thread: write batches (in input order if `isOrdered`) & release them
+void* QrmCli_writerMain(void* context) {
+    QrmCli* cli = context;
+    QrmOutput stdoutBuffer = QrmOutputCreateBuffer(CLI_WRITE_BUFFER_SIZE);
+    // Out of order batches by sequence % batchCount (at most batchCount batches are in pipeline)
+    ALLOC(QrmCli_Batch*, pending, cli->batchCount);
+    if (pending == NULL) {
+        // Batches are still drained (failed) so that reader & encoders can finish
+        fprintf(stderr, "qrmatrix: out of memory\n");
+        QrmCli_failOutput(cli);
+    }
+    unsigned long long nextSequence = 0;
+    QrmCli_Batch* batch;
+    while ((batch = QrmCli_queuePop(&cli->outputQueue)) != NULL) {
+        if (!cli->isOrdered || pending == NULL) {
+            QrmCli_writeBatch(cli, batch, &stdoutBuffer);
+            QrmCli_queuePush(&cli->freeQueue, batch);
+        } else {
+            pending[batch->sequence % cli->batchCount] = batch;
+            while ((batch = pending[nextSequence % cli->batchCount]) != NULL && batch->sequence == nextSequence) {
+                pending[nextSequence % cli->batchCount] = NULL;
+                QrmCli_writeBatch(cli, batch, &stdoutBuffer);
+                QrmCli_queuePush(&cli->freeQueue, batch);
+                nextSequence += 1;
+            }
+        }
+        // Nothing to do: flush small writes
+        if (stdoutBuffer.length > 0 && QrmCli_queueIsEmpty(&cli->outputQueue) && !QrmCli_writeStdout(&stdoutBuffer)) {
+            QrmCli_failOutput(cli);
+        }
+    }
+    if (stdoutBuffer.length > 0 && !QrmCli_writeStdout(&stdoutBuffer)) {
+        QrmCli_failOutput(cli);
+    }
+    fflush(stdout);
+    QrmOutputDestroy(&stdoutBuffer);
+    DEALLOC(pending);
+    return NULL;
+}
+
+// MAIN =====================================================================================================
+
+void QrmCli_printUsage(void) {
+    fprintf(
+        stderr,
+        "Usage: qrmatrix [options] [INPUT]\n"
+        "Encode records of INPUT (file or stdin if missing or \"-\") into QR Codes.\n"
+        "  --input-format ndjson|csv  Input format (default: ndjson, or csv for *.csv files)\n"
+        "  --format svg|png|pbm       Image format (default: svg)\n"
+        "  --output-dir DIRECTORY     Write 1 file per record: DIRECTORY/NAME.FORMAT\n"
+        "                             (NAME: name field or record number). Default: all images to stdout\n"
+        "  --archive FILE             Append boards to board archive FILE (key: name field or payload)\n"
+        "  --level L|M|Q|H            Default error correction level (default: M)\n"
+        "  --mode auto|numeric|alphanumeric|byte|kanji  Default mode (default: auto)\n"
+        "  --scale N                  Pixels per module (default: 4)\n"
+        "  --threads N                Encoder threads (default: number of processors)\n"
+        "  --ordered                  Write outputs in input order\n"
+        "  --quiet                    Do not print failed records\n"
+    );
+}
+
+/// Release resources of pipeline
+void QrmCli_destroy(QrmCli* cli) {
+    for (unsigned int index = 0; index < cli->batchCount && cli->batches != NULL; index += 1) {
+        QrmCli_Batch* batch = &cli->batches[index];
+        for (unsigned int record = 0; record < CLI_BATCH_SIZE; record += 1) {
+            QrmOutputDestroy(&batch->outputs[record]);
+        }
+        DEALLOC(batch->arena);
+    }
+    DEALLOC(cli->batches);
+    QrmCli_queueDestroy(&cli->freeQueue);
+    QrmCli_queueDestroy(&cli->inputQueue);
+    QrmCli_queueDestroy(&cli->outputQueue);
+    QrmCli_inputClose(&cli->input);
+}
+
+int main(int argc, char** argv) {
+    QrmCli cli;
+    memset(&cli, 0, sizeof(cli));
+    atomic_init(&cli.isStopped, false);
+    cli.level = ELevelMedium;
+    cli.scale = 4;
+    cli.threadCount = QrmThreadPoolProcessorCount();
+    const char* inputPath = NULL;
+    bool hasInputFormat = false;
+    for (int index = 1; index < argc; index += 1) {
+        const char* option = argv[index];
+        bool hasValue = index + 1 < argc;
+        const char* value = hasValue ? argv[index + 1] : "";
+        bool isValid = true;
+        if (strcmp(option, "--input-format") == 0 && hasValue) {
+            isValid = strcmp(value, "ndjson") == 0 || strcmp(value, "csv") == 0;
+            cli.inputFormat = strcmp(value, "csv") == 0 ? FormatCsv : FormatNdjson;
+            hasInputFormat = true;
+            index += 1;
+        } else if (strcmp(option, "--format") == 0 && hasValue) {
+            if (strcmp(value, "svg") == 0) {
+                cli.outputFormat = OutputSvg;
+            } else if (strcmp(value, "png") == 0) {
+                cli.outputFormat = OutputPng;
+            } else if (strcmp(value, "pbm") == 0) {
+                cli.outputFormat = OutputPbm;
+            } else {
+                isValid = false;
+            }
+            index += 1;
+        } else if (strcmp(option, "--output-dir") == 0 && hasValue) {
+            cli.outputDirectory = value;
+            index += 1;
+        } else if (strcmp(option, "--archive") == 0 && hasValue) {
+            cli.archivePath = value;
+            index += 1;
+        } else if (strcmp(option, "--level") == 0 && hasValue) {
+            isValid = strlen(value) == 1 && QrmCli_parseLevel(value, 1, &cli.level);
+            index += 1;
+        } else if (strcmp(option, "--mode") == 0 && hasValue) {
+            isValid = QrmPayloadParseHint(value, strlen(value), &cli.mode);
+            index += 1;
+        } else if (strcmp(option, "--scale") == 0 && hasValue) {
+            cli.scale = (unsigned int)strtoul(value, NULL, 10);
+            isValid = cli.scale > 0;
+            index += 1;
+        } else if (strcmp(option, "--threads") == 0 && hasValue) {
+            cli.threadCount = (unsigned int)strtoul(value, NULL, 10);
+            isValid = cli.threadCount > 0;
+            index += 1;
+        } else if (strcmp(option, "--ordered") == 0) {
+            cli.isOrdered = true;
+        } else if (strcmp(option, "--quiet") == 0) {
+            cli.isQuiet = true;
+        } else if ((option[0] != '-' || strcmp(option, "-") == 0) && inputPath == NULL) {
+            inputPath = option;
+        } else {
+            isValid = false;
+        }
+        if (!isValid) {
+            QrmCli_printUsage();
+            return 2;
+        }
+    }
+    if (cli.archivePath != NULL) {
+        cli.outputFormat = OutputArchive;
+    }
+    if (!hasInputFormat && inputPath != NULL) {
+        size_t length = strlen(inputPath);
+        if (length > 4 && strcmp(inputPath + length - 4, ".csv") == 0) {
+            cli.inputFormat = FormatCsv;
+        }
+    }
+    QRMatrixInit();
+    int result = 2;
+    cli.batchCount = cli.threadCount * CLI_BATCHES_PER_THREAD;
+    ALLOC_(QrmCli_Batch, cli.batches, cli.batchCount);
+    bool isReady = cli.batches != NULL &&
+        QrmCli_queueInit(&cli.freeQueue, cli.batchCount) &&
+        QrmCli_queueInit(&cli.inputQueue, cli.batchCount) &&
+        QrmCli_queueInit(&cli.outputQueue, cli.batchCount) &&
+        QrmCli_inputOpen(&cli.input, inputPath);
+    if (isReady && cli.archivePath != NULL) {
+        cli.archive = QrmArchiveWriterOpen(cli.archivePath);
+        if (cli.archive.state == NULL) {
+            fprintf(stderr, "qrmatrix: unable to open archive %s\n", cli.archivePath);
+            isReady = false;
+        }
+    }
+    if (!isReady) {
+        QrmCli_destroy(&cli);
+        return result;
+    }
+    for (unsigned int index = 0; index < cli.batchCount; index += 1) {
+        QrmCli_queuePush(&cli.freeQueue, &cli.batches[index]);
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_t reader;
+    pthread_t writer;
+    pthread_create(&reader, NULL, QrmCli_readerMain, &cli);
+    pthread_create(&writer, NULL, QrmCli_writerMain, &cli);
+    // Calling thread is an encoder too
+    QrmThreadPool pool = QrmThreadPoolCreate(cli.threadCount - 1);
+    QrmThreadPoolRun(pool, QrmCli_encoderMain, &cli, cli.threadCount);
+    QrmThreadPoolDestroy(&pool);
+    QrmCli_queueClose(&cli.outputQueue);
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    if (cli.archivePath != NULL && !QrmArchiveWriterClose(&cli.archive)) {
+        fprintf(stderr, "qrmatrix: unable to close archive %s\n", cli.archivePath);
+        cli.isOutputFailed = true;
+    }
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (!cli.isQuiet) {
+        fprintf(
+            stderr, "qrmatrix: %llu records, %llu failed, %.3f s (%.0f records/s)\n",
+            cli.recordCount, cli.failureCount, seconds, seconds > 0 ? cli.recordCount / seconds : 0.0
+        );
+        if (atomic_load(&cli.isStopped)) {
+            fprintf(stderr, "qrmatrix: stopped after output failure, remaining input not read\n");
+        }
+    }
+    result = cli.isOutputFailed ? 2 : (cli.failureCount > 0 ? 1 : 0);
+    QrmCli_destroy(&cli);
+    return result;
+}
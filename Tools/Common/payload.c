@@ -0,0 +1,101 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "payload.h"
+#include <string.h>
+#include "String/utf8string.h"
+#include "String/unicodepoint.h"
+#include "String/shiftjisstring.h"
+
+/// ECI of UTF-8
+#define PAYLOAD_ECI_UTF8 26
+
+bool QrmPayloadParseHint(const char* text, size_t length, QrmPayloadHint* hint) {
+    static const char* names[] = { "auto", "numeric", "alphanumeric", "byte", "kanji" };
+    if (length == 0) {
+        return true;
+    }
+    for (unsigned int index = 0; index < sizeof(names) / sizeof(names[0]); index += 1) {
+        if (strlen(names[index]) == length && strncmp(names[index], text, length) == 0) {
+            *hint = (QrmPayloadHint)index;
+            return true;
+        }
+    }
+    return false;
+}
+
+QrmSegment* QrmPayloadMakeSegments(
+    const UnsignedByte* payload, unsigned int length, QrmErrorCorrectionLevel level, QrmPayloadHint hint, unsigned int* count, const char** error
+) {
+    QrmSegment* result = NULL;
+    *count = 0;
+    if (hint == HintAuto || hint == HintKanji) {
+        Utf8String text = U8Create(payload, length);
+        if (!text.isValid) {
+            U8Destroy(&text);
+            *error = "invalid UTF-8";
+            return NULL;
+        }
+        UnicodePoint unicodes = U8ToUnicodes(text);
+        U8Destroy(&text);
+        if (hint == HintAuto) {
+            result = UPMakeSegments(unicodes, level, count, false);
+        } else {
+            ShiftJisString shiftJis = SjCreateFromUnicodes(unicodes);
+            if (shiftJis.isValid) {
+                ALLOC_(QrmSegment, result, 1);
+                result[0] = QrmSegCreate(EModeKanji, shiftJis.raw, shiftJis.byteCount, DEFAULT_ECI_ASSIGMENT);
+                *count = 1;
+            }
+            SjDestroy(&shiftJis);
+        }
+        UPDestroy(&unicodes);
+    } else {
+        QrmEncodingMode mode = hint == HintNumeric ? EModeNumeric : (hint == HintAlphaNumeric ? EModeAlphaNumeric : EModeByte);
+        unsigned int eci = DEFAULT_ECI_ASSIGMENT;
+        for (unsigned int index = 0; index < length && mode == EModeByte; index += 1) {
+            if (payload[index] >= 0x80) {
+                eci = PAYLOAD_ECI_UTF8;
+                break;
+            }
+        }
+        ALLOC_(QrmSegment, result, 1);
+        result[0] = QrmSegCreate(mode, payload, length, eci);
+        *count = 1;
+    }
+    if (result != NULL && *count > 0 && result[0].length == 0) {
+        QrmPayloadDestroySegments(result, *count);
+        result = NULL;
+    }
+    if (result == NULL) {
+        *count = 0;
+        *error = "payload does not match mode";
+    }
+    return result;
+}
+
+void QrmPayloadDestroySegments(QrmSegment* segments, unsigned int count) {
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmSegDestroy(&segments[index]);
+    }
+    QrmFree(segments);
+}
@@ -0,0 +1,60 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <stddef.h>
+#include "qrmatrixsegment.h"
+
+/// How to encode payload text of tools
+typedef enum {
+    /// Split UTF-8 text into segments of best modes (`UPMakeSegments`)
+    HintAuto,
+    HintNumeric,
+    HintAlphaNumeric,
+    /// Bytes as is (ECI UTF-8 if there's non ASCII byte)
+    HintByte,
+    /// UTF-8 text converted to Shift-JIS
+    HintKanji
+} QrmPayloadHint;
+
+/// Parse hint name: "auto", "numeric", "alphanumeric", "byte", "kanji".
+/// @return false if unknown (`hint` is not changed; empty name is valid).
+bool QrmPayloadParseHint(const char* text, size_t length, QrmPayloadHint* hint);
+
+/// Make segments of payload.
+/// @return Segments (release by `QrmPayloadDestroySegments`) or NULL if failed.
+QrmSegment* QrmPayloadMakeSegments(
+    const UnsignedByte* payload,
+    unsigned int length,
+    QrmErrorCorrectionLevel level,
+    QrmPayloadHint hint,
+    /// To store number of segments
+    unsigned int* count,
+    /// To store error message if failed
+    const char** error
+);
+
+void QrmPayloadDestroySegments(QrmSegment* segments, unsigned int count);
+
+#endif // PAYLOAD_H
@@ -0,0 +1,178 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "client.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+/// Read exactly `length` bytes
+bool QrmClient_read(int socket, UnsignedByte* buffer, size_t length) {
+    while (length > 0) {
+        ssize_t count = read(socket, buffer, length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+
+QrmClient QrmClientConnect(const char* path) {
+    QrmClient result;
+    memset(&result, 0, sizeof(result));
+    result.socket = -1;
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path == NULL) {
+        path = QRM_DAEMON_SOCKET;
+    }
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        return result;
+    }
+    strcpy(address.sun_path, path);
+    int socketId = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socketId < 0) {
+        return result;
+    }
+    if (connect(socketId, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(socketId);
+        return result;
+    }
+    result.socket = socketId;
+    result.nextId = 1;
+    return result;
+}
+
+void QrmClientClose(QrmClient* client) {
+    if (client->socket >= 0) {
+        close(client->socket);
+    }
+    free(client->buffer);
+    memset(client, 0, sizeof(QrmClient));
+    client->socket = -1;
+}
+
+QrmClientOptions QrmClientOptionsCreate(QrmDaemonOutput output) {
+    QrmClientOptions result;
+    result.output = output;
+    result.level = 'M';
+    result.mode = DaemonModeAuto;
+    result.scale = 4;
+    return result;
+}
+
+bool QrmClientSend(QrmClient* client, QrmClientOptions options, const UnsignedByte* payload, unsigned int length, Unsigned4Bytes* requestId) {
+    if (client->socket < 0 || length > QRM_DAEMON_MAX_PAYLOAD) {
+        return false;
+    }
+    UnsignedByte header[QRM_DAEMON_HEADER_SIZE];
+    Unsigned4Bytes identifier = client->nextId;
+    client->nextId += 1;
+    QrmProtocolPut4(header, QRM_DAEMON_HEADER_SIZE - 4 + length);
+    QrmProtocolPut4(header + 4, identifier);
+    header[8] = (UnsignedByte)options.output;
+    header[9] = (UnsignedByte)options.level;
+    header[10] = (UnsignedByte)options.mode;
+    header[11] = options.scale;
+    struct iovec parts[2];
+    parts[0].iov_base = header;
+    parts[0].iov_len = sizeof(header);
+    parts[1].iov_base = (void*)payload;
+    parts[1].iov_len = length;
+    unsigned int partIndex = 0;
+    while (partIndex < 2) {
+        ssize_t count = writev(client->socket, parts + partIndex, (int)(2 - partIndex));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            return false;
+        }
+        // Skip written parts
+        size_t written = (size_t)count;
+        while (partIndex < 2 && written >= parts[partIndex].iov_len) {
+            written -= parts[partIndex].iov_len;
+            partIndex += 1;
+        }
+        if (partIndex < 2) {
+            parts[partIndex].iov_base = (UnsignedByte*)parts[partIndex].iov_base + written;
+            parts[partIndex].iov_len -= written;
+        }
+    }
+    if (requestId != NULL) {
+        *requestId = identifier;
+    }
+    return true;
+}
+
+bool QrmClientReceive(QrmClient* client, QrmClientResponse* response) {
+    UnsignedByte header[QRM_DAEMON_HEADER_SIZE];
+    if (client->socket < 0 || !QrmClient_read(client->socket, header, sizeof(header))) {
+        return false;
+    }
+    Unsigned4Bytes length = QrmProtocolGet4(header);
+    if (length < QRM_DAEMON_HEADER_SIZE - 4) {
+        return false;
+    }
+    size_t dataLength = length - (QRM_DAEMON_HEADER_SIZE - 4);
+    if (dataLength > client->capacity) {
+        UnsignedByte* buffer = realloc(client->buffer, dataLength);
+        if (buffer == NULL) {
+            return false;
+        }
+        client->buffer = buffer;
+        client->capacity = dataLength;
+    }
+    if (!QrmClient_read(client->socket, client->buffer, dataLength)) {
+        return false;
+    }
+    response->requestId = QrmProtocolGet4(header + 4);
+    response->status = (QrmDaemonStatus)header[8];
+    response->version = header[9];
+    response->dimension = header[10];
+    response->data = client->buffer;
+    response->length = dataLength;
+    return true;
+}
+
+bool QrmClientEncode(QrmClient* client, QrmClientOptions options, const UnsignedByte* payload, unsigned int length, QrmClientResponse* response) {
+    return QrmClientSend(client, options, payload, length, NULL) && QrmClientReceive(client, response);
+}
+
+bool QrmClientResponseIsSet(QrmClientResponse response, UnsignedByte row, UnsignedByte column) {
+    size_t stride = ((size_t)response.dimension + 7) / 8;
+    size_t position = row * stride + column / 8;
+    if (row >= response.dimension || column >= response.dimension || position >= response.length) {
+        return false;
+    }
+    return (response.data[position] & (0x80 >> (column % 8))) != 0;
+}
@@ -0,0 +1,94 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <stddef.h>
+#include "protocol.h"
+
+/// Connection to `qrmatrixd` (does not depend on QRMatrix library).
+/// Not thread-safe: use 1 client per thread.
+typedef struct {
+    /// -1 if not connected
+    int socket;
+    Unsigned4Bytes nextId;
+    /// Received response
+    UnsignedByte* buffer;
+    size_t capacity;
+} QrmClient;
+
+/// Options of request
+typedef struct {
+    QrmDaemonOutput output;
+    /// Error correction level: 'L', 'M', 'Q' or 'H'
+    char level;
+    QrmDaemonMode mode;
+    /// Pixels per module of PNG & SVG (0 = 4)
+    UnsignedByte scale;
+} QrmClientOptions;
+
+typedef struct {
+    Unsigned4Bytes requestId;
+    QrmDaemonStatus status;
+    UnsignedByte version;
+    UnsignedByte dimension;
+    /// Packed board, image bytes or error message. Valid until next receive.
+    const UnsignedByte* data;
+    size_t length;
+} QrmClientResponse;
+
+/// Connect to daemon.
+/// @return Client (`socket` = -1 if failed).
+QrmClient QrmClientConnect(
+    /// Socket path (NULL = `QRM_DAEMON_SOCKET`)
+    const char* path
+);
+void QrmClientClose(QrmClient* client);
+/// Options: level M, auto mode, scale 4
+QrmClientOptions QrmClientOptionsCreate(QrmDaemonOutput output);
+/// Send request (without waiting for response).
+/// @return false if failed
+bool QrmClientSend(
+    QrmClient* client,
+    QrmClientOptions options,
+    const UnsignedByte* payload,
+    unsigned int length,
+    /// Optional. To store request id.
+    Unsigned4Bytes* requestId
+);
+/// Wait for next response.
+/// @return false if connection failed
+bool QrmClientReceive(QrmClient* client, QrmClientResponse* response);
+/// Send request & wait for its response.
+/// @return false if connection failed (check `response->status` for result of request)
+bool QrmClientEncode(
+    QrmClient* client,
+    QrmClientOptions options,
+    const UnsignedByte* payload,
+    unsigned int length,
+    QrmClientResponse* response
+);
+/// Is module of packed board (`DaemonOutputBoard`) dark.
+bool QrmClientResponseIsSet(QrmClientResponse response, UnsignedByte row, UnsignedByte column);
+
+#endif // CLIENT_H
@@ -0,0 +1,289 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Loopback benchmark of `qrmatrixd`: latency of requests to daemon vs in-process calls.
+// Usage: qrmatrixd_bench [--socket PATH] [--daemon EXECUTABLE] [--connections N] [--requests N]
+//                        [--unique N] [--output board|png|svg] [--pipeline N]
+// `--daemon`: start daemon executable on socket path for the benchmark (stopped at the end).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "qrmatrixencoder.h"
+#include "Render/svgwriter.h"
+#include "Render/pngwriter.h"
+#include "Common/payload.h"
+#include "client.h"
+
+typedef struct {
+    const char* path;
+    QrmDaemonOutput output;
+    unsigned int requestCount;
+    unsigned int uniqueCount;
+    unsigned int pipeline;
+} QrmLoopback;
+
+/// Benchmark thread
+typedef struct {
+    QrmLoopback* loopback;
+    unsigned int index;
+    unsigned long long* latencies;
+    unsigned int failureCount;
+    bool isConnected;
+} QrmLoopback_Worker;
+
+unsigned long long QrmLoopback_clock(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000ULL + (unsigned long long)time.tv_nsec;
+}
+
+/// Payload of request `index` (`uniqueCount` different payloads)
+unsigned int QrmLoopback_payload(QrmLoopback* loopback, unsigned int index, char* buffer, size_t size) {
+    unsigned int item = index % loopback->uniqueCount;
+    return (unsigned int)snprintf(buffer, size, "https://example.com/items/%u?ref=loopback&v=%u", item * 7919u, item % 13);
+}
+
+int QrmLoopback_compare(const void* first, const void* second) {
+    unsigned long long a = *(const unsigned long long*)first;
+    unsigned long long b = *(const unsigned long long*)second;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/// Print JSON object of sorted latencies
+void QrmLoopback_report(const char* name, unsigned long long* latencies, unsigned int count, double seconds, bool isLast) {
+    qsort(latencies, count, sizeof(unsigned long long), QrmLoopback_compare);
+    unsigned long long sum = 0;
+    for (unsigned int index = 0; index < count; index += 1) {
+        sum += latencies[index];
+    }
+    printf(
+        "  \"%s\": {\"calls\": %u, \"callsPerSecond\": %.1f, \"latencyNs\": {\"mean\": %llu, \"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}}%s\n",
+        name, count, count / seconds, count > 0 ? sum / count : 0,
+        count > 0 ? latencies[count / 2] : 0, count > 0 ? latencies[(unsigned long long)count * 99 / 100] : 0,
+        count > 0 ? latencies[(unsigned long long)count * 999 / 1000] : 0, count > 0 ? latencies[count - 1] : 0,
+        isLast ? "" : ","
+    );
+}
+
+/// Same work as daemon: segments, encode, output
+bool QrmLoopback_encodeInProcess(QrmLoopback* loopback, const char* payload, unsigned int length, QrmOutput* output) {
+    unsigned int count = 0;
+    const char* error = NULL;
+    QrmSegment* segments = QrmPayloadMakeSegments((const UnsignedByte*)payload, length, ELevelMedium, HintAuto, &count, &error);
+    if (segments == NULL) {
+        return false;
+    }
+    QrmBoard board = QrmEncoderEncode(segments, count, ELevelMedium, QrmExtraCreateNone(), 0, 0xFF);
+    QrmPayloadDestroySegments(segments, count);
+    QrmOutputReset(output);
+    bool result = board.dimension > 0;
+    if (result && loopback->output == DaemonOutputPng) {
+        result = QrmPngWrite(output, board, 4, 4);
+    } else if (result && loopback->output == DaemonOutputSvg) {
+        result = QrmSvgWrite(output, board, 4, 4, QrmSvgStyleCreate("white", "black"));
+    }
+    QrmBoardDestroy(&board);
+    return result;
+}
+
+void* QrmLoopback_workerMain(void* context) {
+    QrmLoopback_Worker* worker = context;
+    QrmLoopback* loopback = worker->loopback;
+    QrmClient client = QrmClientConnect(loopback->path);
+    worker->isConnected = client.socket >= 0;
+    if (!worker->isConnected) {
+        return NULL;
+    }
+    QrmClientOptions options = QrmClientOptionsCreate(loopback->output);
+    // Send time of requests in flight (ring of `pipeline`)
+    unsigned long long* sendTimes = calloc(loopback->pipeline, sizeof(unsigned long long));
+    char payload[128];
+    unsigned int sentCount = 0;
+    unsigned int receivedCount = 0;
+    while (receivedCount < loopback->requestCount && sendTimes != NULL) {
+        while (sentCount < loopback->requestCount && sentCount - receivedCount < loopback->pipeline) {
+            unsigned int length = QrmLoopback_payload(loopback, worker->index * 104729u + sentCount, payload, sizeof(payload));
+            sendTimes[sentCount % loopback->pipeline] = QrmLoopback_clock();
+            if (!QrmClientSend(&client, options, (const UnsignedByte*)payload, length, NULL)) {
+                worker->failureCount += loopback->requestCount - receivedCount;
+                free(sendTimes);
+                QrmClientClose(&client);
+                return NULL;
+            }
+            sentCount += 1;
+        }
+        QrmClientResponse response;
+        if (!QrmClientReceive(&client, &response)) {
+            worker->failureCount += loopback->requestCount - receivedCount;
+            break;
+        }
+        worker->latencies[receivedCount] = QrmLoopback_clock() - sendTimes[receivedCount % loopback->pipeline];
+        if (response.status != DaemonStatusOk) {
+            worker->failureCount += 1;
+        }
+        receivedCount += 1;
+    }
+    free(sendTimes);
+    QrmClientClose(&client);
+    return NULL;
+}
+
+/// Start daemon & wait until socket accepts connections
+pid_t QrmLoopback_startDaemon(const char* executable, const char* path) {
+    pid_t child = fork();
+    if (child == 0) {
+        execl(executable, executable, "--socket", path, (char*)NULL);
+        _exit(127);
+    }
+    for (unsigned int attempt = 0; attempt < 200 && child > 0; attempt += 1) {
+        QrmClient client = QrmClientConnect(path);
+        if (client.socket >= 0) {
+            QrmClientClose(&client);
+            return child;
+        }
+        usleep(10000);
+    }
+    if (child > 0) {
+        kill(child, SIGTERM);
+        waitpid(child, NULL, 0);
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    QrmLoopback loopback;
+    loopback.path = QRM_DAEMON_SOCKET;
+    loopback.output = DaemonOutputBoard;
+    loopback.requestCount = 2000;
+    loopback.uniqueCount = 100000;
+    loopback.pipeline = 1;
+    unsigned int connectionCount = 4;
+    const char* daemonExecutable = NULL;
+    for (int index = 1; index < argc; index += 1) {
+        const char* option = argv[index];
+        bool hasValue = index + 1 < argc;
+        bool isValid = true;
+        if (strcmp(option, "--socket") == 0 && hasValue) {
+            loopback.path = argv[++index];
+        } else if (strcmp(option, "--daemon") == 0 && hasValue) {
+            daemonExecutable = argv[++index];
+        } else if (strcmp(option, "--connections") == 0 && hasValue) {
+            connectionCount = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--requests") == 0 && hasValue) {
+            loopback.requestCount = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--unique") == 0 && hasValue) {
+            loopback.uniqueCount = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--pipeline") == 0 && hasValue) {
+            loopback.pipeline = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--output") == 0 && hasValue) {
+            index += 1;
+            if (strcmp(argv[index], "board") == 0) {
+                loopback.output = DaemonOutputBoard;
+            } else if (strcmp(argv[index], "png") == 0) {
+                loopback.output = DaemonOutputPng;
+            } else if (strcmp(argv[index], "svg") == 0) {
+                loopback.output = DaemonOutputSvg;
+            } else {
+                isValid = false;
+            }
+        } else {
+            isValid = false;
+        }
+        if (!isValid || connectionCount == 0 || loopback.requestCount == 0 || loopback.uniqueCount == 0 || loopback.pipeline == 0) {
+            fprintf(
+                stderr,
+                "Usage: %s [--socket PATH] [--daemon EXECUTABLE] [--connections N] [--requests N]\n"
+                "          [--unique N] [--output board|png|svg] [--pipeline N]\n",
+                argv[0]
+            );
+            return 2;
+        }
+    }
+    QRMatrixInit();
+    // In-process: same payloads on 1 thread
+    unsigned int directCount = loopback.requestCount;
+    ALLOC(unsigned long long, directLatencies, directCount);
+    QrmOutput output = QrmOutputCreateBuffer(0);
+    char payload[128];
+    unsigned long long start = QrmLoopback_clock();
+    for (unsigned int index = 0; index < directCount; index += 1) {
+        unsigned int length = QrmLoopback_payload(&loopback, index, payload, sizeof(payload));
+        unsigned long long begin = QrmLoopback_clock();
+        QrmLoopback_encodeInProcess(&loopback, payload, length, &output);
+        directLatencies[index] = QrmLoopback_clock() - begin;
+    }
+    double directSeconds = (QrmLoopback_clock() - start) / 1e9;
+    QrmOutputDestroy(&output);
+    // Daemon
+    pid_t daemon = -1;
+    if (daemonExecutable != NULL) {
+        daemon = QrmLoopback_startDaemon(daemonExecutable, loopback.path);
+        if (daemon < 0) {
+            fprintf(stderr, "Unable to start %s\n", daemonExecutable);
+            DEALLOC(directLatencies);
+            return 1;
+        }
+    }
+    ALLOC(QrmLoopback_Worker, workers, connectionCount);
+    ALLOC(pthread_t, threads, connectionCount);
+    ALLOC(unsigned long long, latencies, (size_t)connectionCount * loopback.requestCount);
+    start = QrmLoopback_clock();
+    for (unsigned int index = 0; index < connectionCount; index += 1) {
+        workers[index].loopback = &loopback;
+        workers[index].index = index;
+        workers[index].latencies = latencies + (size_t)index * loopback.requestCount;
+        pthread_create(&threads[index], NULL, QrmLoopback_workerMain, &workers[index]);
+    }
+    unsigned int failureCount = 0;
+    bool isConnected = true;
+    for (unsigned int index = 0; index < connectionCount; index += 1) {
+        pthread_join(threads[index], NULL);
+        failureCount += workers[index].failureCount;
+        isConnected = isConnected && workers[index].isConnected;
+    }
+    double daemonSeconds = (QrmLoopback_clock() - start) / 1e9;
+    if (daemon > 0) {
+        kill(daemon, SIGTERM);
+        waitpid(daemon, NULL, 0);
+    }
+    int result = 0;
+    if (!isConnected) {
+        fprintf(stderr, "Unable to connect to %s\n", loopback.path);
+        result = 1;
+    } else {
+        printf("{\n  \"connections\": %u,\n  \"pipeline\": %u,\n  \"failures\": %u,\n", connectionCount, loopback.pipeline, failureCount);
+        QrmLoopback_report("inProcess", directLatencies, directCount, directSeconds, false);
+        QrmLoopback_report("daemon", latencies, connectionCount * loopback.requestCount, daemonSeconds, true);
+        printf("}\n");
+    }
+    DEALLOC(directLatencies);
+    DEALLOC(workers);
+    DEALLOC(threads);
+    DEALLOC(latencies);
+    return result;
+}
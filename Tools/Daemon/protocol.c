@@ -0,0 +1,34 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "protocol.h"
+
+void QrmProtocolPut4(UnsignedByte* buffer, Unsigned4Bytes value) {
+    buffer[0] = (UnsignedByte)value;
+    buffer[1] = (UnsignedByte)(value >> 8);
+    buffer[2] = (UnsignedByte)(value >> 16);
+    buffer[3] = (UnsignedByte)(value >> 24);
+}
+
+Unsigned4Bytes QrmProtocolGet4(const UnsignedByte* buffer) {
+    return (Unsigned4Bytes)buffer[0] | ((Unsigned4Bytes)buffer[1] << 8) | ((Unsigned4Bytes)buffer[2] << 16) | ((Unsigned4Bytes)buffer[3] << 24);
+}
@@ -0,0 +1,79 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include "constants.h"
+
+/*
+ Protocol of `qrmatrixd` (Unix domain stream socket). Numbers are little endian.
+ Client may send many requests without waiting for responses (responses of a connection are in request order).
+ - Request: length of following bytes (4 bytes), request id (4 bytes), output (1 byte, `QrmDaemonOutput`),
+   level (1 byte: 'L', 'M', 'Q' or 'H'), mode (1 byte, `QrmDaemonMode`), scale (1 byte, pixels per module of images, 0 = 4),
+   payload (up to `QRM_DAEMON_MAX_PAYLOAD` bytes).
+ - Response: length of following bytes (4 bytes), request id (4 bytes), status (1 byte, `QrmDaemonStatus`),
+   version (1 byte), dimension (1 byte), reserved (1 byte), data:
+   packed board (`dimension` rows of `(dimension + 7) / 8` bytes, most significant bit first, 1 = dark module),
+   or PNG / SVG file bytes, or error message (status is not `DaemonStatusOk`).
+ */
+
+/// Default socket path
+#define QRM_DAEMON_SOCKET "/tmp/qrmatrixd.sock"
+/// Size of request & response header (including length)
+#define QRM_DAEMON_HEADER_SIZE 12
+/// Maximum payload size of request
+#define QRM_DAEMON_MAX_PAYLOAD 65536
+
+typedef enum {
+    /// Packed modules (1 bit per module)
+    DaemonOutputBoard,
+    DaemonOutputPng,
+    DaemonOutputSvg
+} QrmDaemonOutput;
+
+/// Encoding mode of payload (same values as `QrmPayloadHint`)
+typedef enum {
+    /// UTF-8 text, split into segments of best modes
+    DaemonModeAuto,
+    DaemonModeNumeric,
+    DaemonModeAlphaNumeric,
+    DaemonModeByte,
+    /// UTF-8 text converted to Shift-JIS
+    DaemonModeKanji
+} QrmDaemonMode;
+
+typedef enum {
+    DaemonStatusOk,
+    /// Unknown output, level or mode
+    DaemonStatusInvalidRequest,
+    /// Payload does not match mode or is too long
+    DaemonStatusEncodeFailed,
+    DaemonStatusRenderFailed
+} QrmDaemonStatus;
+
+/// Write 4 bytes little endian number
+void QrmProtocolPut4(UnsignedByte* buffer, Unsigned4Bytes value);
+/// Read 4 bytes little endian number
+Unsigned4Bytes QrmProtocolGet4(const UnsignedByte* buffer);
+
+#endif // PROTOCOL_H
@@ -0,0 +1,549 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Encoding daemon: serves requests of `protocol.h` on a Unix domain socket.
+// Usage: qrmatrixd [--socket PATH] [--threads N] [--cache-bytes N] [--max-batch N] [--batch-window MICROSECONDS]
+//
+// Single I/O thread polls all connections. Requests which arrived together (from any connection)
+// are processed as 1 batch on the thread pool, then responses are written.
+// Requests arriving while a batch is processed are coalesced into the next batch.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "qrmatrixencoder.h"
+#include "ThreadPool/threadpool.h"
+#include "Cache/boardcache.h"
+#include "Render/svgwriter.h"
+#include "Render/pngwriter.h"
+#include "Common/payload.h"
+#include "protocol.h"
+
+/// Connection stops reading when this number of bytes is waiting to be processed or written (back pressure)
+#define DAEMON_BUFFER_LIMIT (4 << 20)
+#define DAEMON_READ_SIZE 65536
+
+typedef struct {
+    int socket;
+    /// Received bytes; `consumed` bytes of them are processed
+    UnsignedByte* input;
+    size_t inputLength;
+    size_t inputCapacity;
+    size_t consumed;
+    /// Responses to be written from `outputPosition`
+    QrmOutput output;
+    size_t outputPosition;
+    /// Peer closed or error: close after pending responses are written
+    bool isClosing;
+} QrmDaemon_Connection;
+
+typedef struct {
+    /// Index in connections
+    unsigned int connection;
+    Unsigned4Bytes id;
+    UnsignedByte output;
+    UnsignedByte level;
+    UnsignedByte mode;
+    UnsignedByte scale;
+    const UnsignedByte* payload;
+    unsigned int length;
+    // Result
+    QrmDaemonStatus status;
+    UnsignedByte version;
+    UnsignedByte dimension;
+    QrmOutput result;
+} QrmDaemon_Request;
+
+typedef struct {
+    int listener;
+    QrmDaemon_Connection* connections;
+    unsigned int connectionCount;
+    unsigned int connectionCapacity;
+    struct pollfd* polls;
+    QrmDaemon_Request* requests;
+    unsigned int maxBatch;
+    unsigned int batchWindow;
+    QrmThreadPool pool;
+    /// `state` = NULL if cache is disabled
+    QrmBoardCache cache;
+    // Counters
+    unsigned long long requestCount;
+    unsigned long long batchCount;
+} QrmDaemon;
+
+static volatile sig_atomic_t qrmDaemonIsStopped = 0;
+
+void QrmDaemon_stop(int signalNumber) {
+    (void)signalNumber;
+    qrmDaemonIsStopped = 1;
+}
+
+// REQUEST ==================================================================================================
+
+bool QrmDaemon_levelOf(UnsignedByte level, QrmErrorCorrectionLevel* result) {
+    switch (level) {
+    case 'L':
+        *result = ELevelLow;
+        return true;
+    case 'M':
+        *result = ELevelMedium;
+        return true;
+    case 'Q':
+        *result = ELevelQuarter;
+        return true;
+    case 'H':
+        *result = ELevelHigh;
+        return true;
+    }
+    return false;
+}
+
+/// Pack modules: 1 bit per module, most significant bit first
+void QrmDaemon_packBoard(QrmBoard board, QrmOutput* output) {
+    unsigned int stride = ((unsigned int)board.dimension + 7) / 8;
+    UnsignedByte row[32];
+    for (UnsignedByte y = 0; y < board.dimension; y += 1) {
+        memset(row, 0, stride);
+        for (UnsignedByte x = 0; x < board.dimension; x += 1) {
+            if ((board.buffer[y][x] & CellLowMask) == CellSet) {
+                row[x / 8] |= (UnsignedByte)(0x80 >> (x % 8));
+            }
+        }
+        QrmOutputWrite(output, row, stride);
+    }
+}
+
+void QrmDaemon_fail(QrmDaemon_Request* request, QrmDaemonStatus status, const char* message) {
+    request->status = status;
+    QrmOutputReset(&request->result);
+    QrmOutputWriteString(&request->result, message);
+}
+
+/// Thread pool task: process request
+void QrmDaemon_process(void* context, unsigned int index) {
+    QrmDaemon* daemon = context;
+    QrmDaemon_Request* request = &daemon->requests[index];
+    QrmOutputReset(&request->result);
+    request->status = DaemonStatusOk;
+    request->version = 0;
+    request->dimension = 0;
+    QrmErrorCorrectionLevel level;
+    if (request->output > DaemonOutputSvg || request->mode > DaemonModeKanji || !QrmDaemon_levelOf(request->level, &level)) {
+        QrmDaemon_fail(request, DaemonStatusInvalidRequest, "invalid request");
+        return;
+    }
+    unsigned int count = 0;
+    const char* error = NULL;
+    QrmSegment* segments = QrmPayloadMakeSegments(request->payload, request->length, level, (QrmPayloadHint)request->mode, &count, &error);
+    if (segments == NULL) {
+        QrmDaemon_fail(request, DaemonStatusEncodeFailed, error);
+        return;
+    }
+    QrmSharedBoard shared;
+    if (daemon->cache.state != NULL) {
+        shared = QrmBoardCacheEncode(daemon->cache, segments, count, level, QrmExtraCreateNone(), 0, 0xFF);
+    } else {
+        shared.board = QrmEncoderEncode(segments, count, level, QrmExtraCreateNone(), 0, 0xFF);
+        shared.entry = NULL;
+    }
+    QrmPayloadDestroySegments(segments, count);
+    QrmBoard board = shared.board;
+    if (board.dimension == 0) {
+        QrmDaemon_fail(request, DaemonStatusEncodeFailed, "data too long");
+    } else {
+        request->dimension = board.dimension;
+        request->version = (UnsignedByte)((board.dimension - 17) / 4);
+        unsigned int scale = request->scale > 0 ? request->scale : 4;
+        bool isSuccess = true;
+        switch ((QrmDaemonOutput)request->output) {
+        case DaemonOutputBoard:
+            QrmDaemon_packBoard(board, &request->result);
+            isSuccess = !request->result.isFailed;
+            break;
+        case DaemonOutputPng:
+            isSuccess = QrmPngWrite(&request->result, board, scale, 4);
+            break;
+        case DaemonOutputSvg:
+            isSuccess = QrmSvgWrite(&request->result, board, scale, 4, QrmSvgStyleCreate("white", "black"));
+            break;
+        }
+        if (!isSuccess) {
+            QrmDaemon_fail(request, DaemonStatusRenderFailed, "render failed");
+        }
+    }
+    if (daemon->cache.state != NULL) {
+        QrmSharedBoardRelease(&shared);
+    } else {
+        QrmBoardDestroy(&shared.board);
+    }
+}
+
+// CONNECTIONS ==============================================================================================
+
+void QrmDaemon_accept(QrmDaemon* daemon) {
+    while (true) {
+        int socketId = accept(daemon->listener, NULL, NULL);
+        if (socketId < 0) {
+            return;
+        }
+        fcntl(socketId, F_SETFL, fcntl(socketId, F_GETFL) | O_NONBLOCK);
+        if (daemon->connectionCount == daemon->connectionCapacity) {
+            unsigned int capacity = daemon->connectionCapacity * 2;
+            QrmDaemon_Connection* connections = QrmRealloc(daemon->connections, capacity * sizeof(QrmDaemon_Connection));
+            struct pollfd* polls = connections != NULL ? QrmRealloc(daemon->polls, (capacity + 1) * sizeof(struct pollfd)) : NULL;
+            if (connections != NULL) {
+                daemon->connections = connections;
+            }
+            if (polls == NULL) {
+                close(socketId);
+                continue;
+            }
+            daemon->polls = polls;
+            daemon->connectionCapacity = capacity;
+        }
+        QrmDaemon_Connection* connection = &daemon->connections[daemon->connectionCount];
+        memset(connection, 0, sizeof(QrmDaemon_Connection));
+        connection->socket = socketId;
+        connection->output = QrmOutputCreateBuffer(0);
+        daemon->connectionCount += 1;
+    }
+}
+
+/// Read available bytes of connection
+void QrmDaemon_read(QrmDaemon_Connection* connection) {
+    while (!connection->isClosing && connection->inputLength + connection->output.length < DAEMON_BUFFER_LIMIT) {
+        if (connection->inputCapacity - connection->inputLength < DAEMON_READ_SIZE) {
+            size_t capacity = connection->inputCapacity > 0 ? connection->inputCapacity * 2 : DAEMON_READ_SIZE * 2;
+            UnsignedByte* input = QrmRealloc(connection->input, capacity);
+            if (input == NULL) {
+                connection->isClosing = true;
+                return;
+            }
+            connection->input = input;
+            connection->inputCapacity = capacity;
+        }
+        ssize_t count = read(connection->socket, connection->input + connection->inputLength, connection->inputCapacity - connection->inputLength);
+        if (count > 0) {
+            connection->inputLength += (size_t)count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                connection->isClosing = true;
+            }
+            return;
+        }
+    }
+}
+
+/// Write pending responses of connection
+void QrmDaemon_write(QrmDaemon_Connection* connection) {
+    while (connection->outputPosition < connection->output.length) {
+        ssize_t count = write(
+            connection->socket, connection->output.buffer + connection->outputPosition, connection->output.length - connection->outputPosition
+        );
+        if (count > 0) {
+            connection->outputPosition += (size_t)count;
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                // Peer is gone: drop responses
+                connection->isClosing = true;
+                connection->outputPosition = connection->output.length;
+            }
+            break;
+        }
+    }
+    if (connection->outputPosition == connection->output.length) {
+        QrmOutputReset(&connection->output);
+        connection->outputPosition = 0;
+    }
+}
+
+/// Collect complete requests of all connections (up to `maxBatch`)
+/// @return Number of requests
+unsigned int QrmDaemon_collect(QrmDaemon* daemon) {
+    unsigned int count = 0;
+    // Round robin: 1 request of each connection per round
+    bool hasMore = true;
+    while (hasMore && count < daemon->maxBatch) {
+        hasMore = false;
+        for (unsigned int index = 0; index < daemon->connectionCount && count < daemon->maxBatch; index += 1) {
+            QrmDaemon_Connection* connection = &daemon->connections[index];
+            size_t available = connection->inputLength - connection->consumed;
+            if (available < QRM_DAEMON_HEADER_SIZE) {
+                continue;
+            }
+            const UnsignedByte* frame = connection->input + connection->consumed;
+            Unsigned4Bytes length = QrmProtocolGet4(frame);
+            if (length < QRM_DAEMON_HEADER_SIZE - 4 || length > QRM_DAEMON_HEADER_SIZE - 4 + QRM_DAEMON_MAX_PAYLOAD) {
+                // Protocol error
+                connection->isClosing = true;
+                connection->consumed = connection->inputLength;
+                continue;
+            }
+            if (available < 4 + (size_t)length) {
+                continue;
+            }
+            QrmDaemon_Request* request = &daemon->requests[count];
+            request->connection = index;
+            request->id = QrmProtocolGet4(frame + 4);
+            request->output = frame[8];
+            request->level = frame[9];
+            request->mode = frame[10];
+            request->scale = frame[11];
+            request->payload = frame + QRM_DAEMON_HEADER_SIZE;
+            request->length = length - (QRM_DAEMON_HEADER_SIZE - 4);
+            connection->consumed += 4 + (size_t)length;
+            count += 1;
+            hasMore = true;
+        }
+    }
+    return count;
+}
+
+/// Append responses to connections, drop processed input
+void QrmDaemon_respond(QrmDaemon* daemon, unsigned int count) {
+    for (unsigned int index = 0; index < count; index += 1) {
+        QrmDaemon_Request* request = &daemon->requests[index];
+        QrmDaemon_Connection* connection = &daemon->connections[request->connection];
+        UnsignedByte header[QRM_DAEMON_HEADER_SIZE];
+        QrmProtocolPut4(header, (Unsigned4Bytes)(QRM_DAEMON_HEADER_SIZE - 4 + request->result.length));
+        QrmProtocolPut4(header + 4, request->id);
+        header[8] = (UnsignedByte)request->status;
+        header[9] = request->version;
+        header[10] = request->dimension;
+        header[11] = 0;
+        QrmOutputWrite(&connection->output, header, sizeof(header));
+        QrmOutputWrite(&connection->output, request->result.buffer, request->result.length);
+    }
+    for (unsigned int index = 0; index < daemon->connectionCount; index += 1) {
+        QrmDaemon_Connection* connection = &daemon->connections[index];
+        if (connection->consumed > 0) {
+            memmove(connection->input, connection->input + connection->consumed, connection->inputLength - connection->consumed);
+            connection->inputLength -= connection->consumed;
+            connection->consumed = 0;
+        }
+        if (connection->output.isFailed) {
+            connection->isClosing = true;
+        }
+        QrmDaemon_write(connection);
+    }
+}
+
+/// Close & remove finished connections
+void QrmDaemon_cleanUp(QrmDaemon* daemon) {
+    unsigned int index = 0;
+    while (index < daemon->connectionCount) {
+        QrmDaemon_Connection* connection = &daemon->connections[index];
+        if (!connection->isClosing || connection->output.length > connection->outputPosition) {
+            index += 1;
+            continue;
+        }
+        close(connection->socket);
+        DEALLOC(connection->input);
+        QrmOutputDestroy(&connection->output);
+        daemon->connectionCount -= 1;
+        daemon->connections[index] = daemon->connections[daemon->connectionCount];
+    }
+}
+
+/// Wait for events (timeout in milliseconds) then accept, read & write
+void QrmDaemon_poll(QrmDaemon* daemon, int timeout) {
+    daemon->polls[0].fd = daemon->listener;
+    daemon->polls[0].events = POLLIN;
+    for (unsigned int index = 0; index < daemon->connectionCount; index += 1) {
+        QrmDaemon_Connection* connection = &daemon->connections[index];
+        daemon->polls[index + 1].fd = connection->socket;
+        daemon->polls[index + 1].events = (short)(
+            (connection->inputLength + connection->output.length < DAEMON_BUFFER_LIMIT && !connection->isClosing ? POLLIN : 0) |
+            (connection->output.length > connection->outputPosition ? POLLOUT : 0)
+        );
+        daemon->polls[index + 1].revents = 0;
+    }
+    unsigned int pollCount = daemon->connectionCount + 1;
+    if (poll(daemon->polls, pollCount, timeout) <= 0) {
+        return;
+    }
+    for (unsigned int index = 1; index < pollCount; index += 1) {
+        short events = daemon->polls[index].revents;
+        QrmDaemon_Connection* connection = &daemon->connections[index - 1];
+        if ((events & (POLLIN | POLLHUP | POLLERR)) != 0) {
+            QrmDaemon_read(connection);
+        }
+        if ((events & POLLOUT) != 0) {
+            QrmDaemon_write(connection);
+        }
+    }
+    if ((daemon->polls[0].revents & POLLIN) != 0) {
+        QrmDaemon_accept(daemon);
+    }
+}
+
+/// Has a complete request which is not processed
+bool QrmDaemon_hasRequest(QrmDaemon* daemon) {
+    for (unsigned int index = 0; index < daemon->connectionCount; index += 1) {
+        QrmDaemon_Connection* connection = &daemon->connections[index];
+        size_t available = connection->inputLength - connection->consumed;
+        if (available >= QRM_DAEMON_HEADER_SIZE && available >= 4 + (size_t)QrmProtocolGet4(connection->input + connection->consumed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// MAIN =====================================================================================================
+
+int QrmDaemon_listen(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "qrmatrixd: socket path is too long\n");
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+    int socketId = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socketId < 0) {
+        return -1;
+    }
+    unlink(path);
+    if (bind(socketId, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(socketId, 128) != 0) {
+        fprintf(stderr, "qrmatrixd: unable to listen on %s: %s\n", path, strerror(errno));
+        close(socketId);
+        return -1;
+    }
+    fcntl(socketId, F_SETFL, fcntl(socketId, F_GETFL) | O_NONBLOCK);
+    return socketId;
+}
+
+int main(int argc, char** argv) {
+    const char* path = QRM_DAEMON_SOCKET;
+    unsigned int threadCount = QrmThreadPoolProcessorCount();
+    size_t cacheBytes = 64 << 20;
+    QrmDaemon daemon;
+    memset(&daemon, 0, sizeof(daemon));
+    daemon.maxBatch = 256;
+    for (int index = 1; index < argc; index += 1) {
+        const char* option = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (strcmp(option, "--socket") == 0 && hasValue) {
+            path = argv[++index];
+        } else if (strcmp(option, "--threads") == 0 && hasValue) {
+            threadCount = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--cache-bytes") == 0 && hasValue) {
+            cacheBytes = (size_t)strtoull(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--max-batch") == 0 && hasValue) {
+            daemon.maxBatch = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--batch-window") == 0 && hasValue) {
+            daemon.batchWindow = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else {
+            fprintf(
+                stderr, "Usage: %s [--socket PATH] [--threads N] [--cache-bytes N] [--max-batch N] [--batch-window MICROSECONDS]\n", argv[0]
+            );
+            return 2;
+        }
+    }
+    if (threadCount == 0 || daemon.maxBatch == 0) {
+        fprintf(stderr, "qrmatrixd: threads & max batch must be positive\n");
+        return 2;
+    }
+    QRMatrixInit();
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = QrmDaemon_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    daemon.listener = QrmDaemon_listen(path);
+    if (daemon.listener < 0) {
+        return 1;
+    }
+    daemon.connectionCapacity = 16;
+    ALLOC_(QrmDaemon_Connection, daemon.connections, daemon.connectionCapacity);
+    ALLOC_(struct pollfd, daemon.polls, daemon.connectionCapacity + 1);
+    ALLOC_(QrmDaemon_Request, daemon.requests, daemon.maxBatch);
+    if (daemon.connections == NULL || daemon.polls == NULL || daemon.requests == NULL) {
+        fprintf(stderr, "qrmatrixd: out of memory\n");
+        return 1;
+    }
+    for (unsigned int index = 0; index < daemon.maxBatch; index += 1) {
+        daemon.requests[index].result = QrmOutputCreateBuffer(0);
+    }
+    daemon.cache.state = NULL;
+    if (cacheBytes > 0) {
+        daemon.cache = QrmBoardCacheCreate(cacheBytes);
+    }
+    // Calling thread (I/O thread) works on batches too
+    daemon.pool = QrmThreadPoolCreate(threadCount - 1);
+    fprintf(stderr, "qrmatrixd: listening on %s (%u threads)\n", path, threadCount);
+    while (!qrmDaemonIsStopped) {
+        QrmDaemon_poll(&daemon, QrmDaemon_hasRequest(&daemon) ? 0 : 1000);
+        if (daemon.batchWindow > 0 && QrmDaemon_hasRequest(&daemon)) {
+            // Wait a bit for concurrent requests to make bigger batch
+            QrmDaemon_poll(&daemon, (int)(daemon.batchWindow + 999) / 1000);
+        }
+        unsigned int count = QrmDaemon_collect(&daemon);
+        if (count > 0) {
+            QrmThreadPoolRun(daemon.pool, QrmDaemon_process, &daemon, count);
+            daemon.requestCount += count;
+            daemon.batchCount += 1;
+        }
+        QrmDaemon_respond(&daemon, count);
+        QrmDaemon_cleanUp(&daemon);
+    }
+    fprintf(
+        stderr, "qrmatrixd: %llu requests in %llu batches (%.1f requests per batch)\n",
+        daemon.requestCount, daemon.batchCount, daemon.batchCount > 0 ? (double)daemon.requestCount / daemon.batchCount : 0.0
+    );
+    if (daemon.cache.state != NULL) {
+        QrmBoardCacheStatistics statistics = QrmBoardCacheGetStatistics(daemon.cache);
+        fprintf(
+            stderr, "qrmatrixd: cache %llu hits, %llu misses, %llu evictions, %u boards\n",
+            statistics.hits, statistics.misses, statistics.evictions, statistics.entryCount
+        );
+        QrmBoardCacheDestroy(&daemon.cache);
+    }
+    QrmThreadPoolDestroy(&daemon.pool);
+    for (unsigned int index = 0; index < daemon.connectionCount; index += 1) {
+        close(daemon.connections[index].socket);
+        DEALLOC(daemon.connections[index].input);
+        QrmOutputDestroy(&daemon.connections[index].output);
+    }
+    for (unsigned int index = 0; index < daemon.maxBatch; index += 1) {
+        QrmOutputDestroy(&daemon.requests[index].result);
+    }
+    DEALLOC(daemon.connections);
+    DEALLOC(daemon.polls);
+    DEALLOC(daemon.requests);
+    close(daemon.listener);
+    unlink(path);
+    return 0;
+}
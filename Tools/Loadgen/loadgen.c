@@ -0,0 +1,654 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// End-to-end load generator of QRMatrix: encode (& render) payloads on N threads,
+// report throughput, latency percentiles & memory usage over time.
+// Usage:
+//   qrmatrix_loadgen [--corpus FILE] [--lengths MIN-MAX] [--modes nabk] [--levels LMQH] [--threads N]
+//                    [--duration SECONDS] [--interval SECONDS] [--render none|svg|png] [--seed N] [--output FILE]
+//   qrmatrix_loadgen --compare BASE.json NEW.json [--threshold PERCENT]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "qrmatrixencoder.h"
+#include "ThreadPool/threadpool.h"
+#include "Render/svgwriter.h"
+#include "Render/pngwriter.h"
+#include "String/utf8string.h"
+#include "String/unicodepoint.h"
+
+/// Number of generated payloads of synthetic load
+#define LOADGEN_SYNTHETIC_COUNT 4096
+/// Latency histogram: values < 2^(LOADGEN_SUB_BITS + 1) have own buckets,
+/// then each power of 2 is divided into 2^LOADGEN_SUB_BITS buckets (~3% precision)
+#define LOADGEN_SUB_BITS 5
+#define LOADGEN_SUB_COUNT (1 << LOADGEN_SUB_BITS)
+#define LOADGEN_BUCKET_COUNT (2 * LOADGEN_SUB_COUNT + (64 - LOADGEN_SUB_BITS - 1) * LOADGEN_SUB_COUNT)
+
+typedef enum {
+    RenderNone,
+    RenderSvg,
+    RenderPng
+} QrmLoadgen_Render;
+
+/// Payload to encode
+typedef struct {
+    QrmSegment* segments;
+    unsigned int count;
+    QrmErrorCorrectionLevel level;
+} QrmLoadgen_Item;
+
+/// Result of 1 worker
+typedef struct {
+    unsigned long long symbolCount;
+    unsigned long long failureCount;
+    unsigned long long latencySum;
+    unsigned long long latencyMax;
+    unsigned long long buckets[LOADGEN_BUCKET_COUNT];
+    /// Position in items
+    unsigned int next;
+    QrmOutput output;
+} QrmLoadgen_Worker;
+
+typedef struct {
+    QrmLoadgen_Item* items;
+    unsigned int itemCount;
+    QrmLoadgen_Render render;
+    QrmLoadgen_Worker* workers;
+    /// End of current interval
+    unsigned long long deadline;
+} QrmLoadgen;
+
+/// Memory usage sample
+typedef struct {
+    double seconds;
+    unsigned long long rssBytes;
+    double symbolsPerSecond;
+} QrmLoadgen_Sample;
+
+unsigned long long QrmLoadgen_clock(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000ULL + (unsigned long long)time.tv_nsec;
+}
+
+/// Resident memory of this process (0 if unknown)
+unsigned long long QrmLoadgen_rss(void) {
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == NULL) {
+        return 0;
+    }
+    if (fscanf(file, "%llu %llu", &size, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(file);
+    return resident * (unsigned long long)sysconf(_SC_PAGESIZE);
+}
+
+Unsigned4Bytes QrmLoadgen_random(Unsigned4Bytes* seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+QrmErrorCorrectionLevel QrmLoadgen_levelOf(char level) {
+    switch (level) {
+    case 'L':
+        return ELevelLow;
+    case 'Q':
+        return ELevelQuarter;
+    case 'H':
+        return ELevelHigh;
+    default:
+        return ELevelMedium;
+    }
+}
+
+QrmEncodingMode QrmLoadgen_modeOf(char mode) {
+    switch (mode) {
+    case 'n':
+        return EModeNumeric;
+    case 'a':
+        return EModeAlphaNumeric;
+    case 'k':
+        return EModeKanji;
+    default:
+        return EModeByte;
+    }
+}
+
+// HISTOGRAM ================================================================================================
+
+unsigned int QrmLoadgen_bucketOf(unsigned long long value) {
+    if (value < 2 * LOADGEN_SUB_COUNT) {
+        return (unsigned int)value;
+    }
+    unsigned int highestBit = 0;
+    while ((value >> (highestBit + 1)) != 0) {
+        highestBit += 1;
+    }
+    unsigned int shift = highestBit - LOADGEN_SUB_BITS;
+    return shift * LOADGEN_SUB_COUNT + (unsigned int)(value >> shift);
+}
+
+/// Highest value of bucket
+unsigned long long QrmLoadgen_bucketValue(unsigned int bucket) {
+    if (bucket < 2 * LOADGEN_SUB_COUNT) {
+        return bucket;
+    }
+    unsigned int shift = (bucket - LOADGEN_SUB_COUNT) / LOADGEN_SUB_COUNT;
+    unsigned long long sub = bucket - LOADGEN_SUB_COUNT * shift;
+    return ((sub + 1) << shift) - 1;
+}
+
+unsigned long long QrmLoadgen_percentile(const unsigned long long* buckets, unsigned long long total, double percent) {
+    unsigned long long rank = (unsigned long long)(total * percent / 100.0);
+    if (rank >= total) {
+        rank = total - 1;
+    }
+    unsigned long long count = 0;
+    for (unsigned int bucket = 0; bucket < LOADGEN_BUCKET_COUNT; bucket += 1) {
+        count += buckets[bucket];
+        if (count > rank) {
+            return QrmLoadgen_bucketValue(bucket);
+        }
+    }
+    return 0;
+}
+
+// LOAD =====================================================================================================
+
+/// Append `item` to `items`
+bool QrmLoadgen_addItem(QrmLoadgen* loadgen, QrmLoadgen_Item item, unsigned int* capacity) {
+    if (loadgen->itemCount == *capacity) {
+        unsigned int newCapacity = *capacity == 0 ? 256 : *capacity * 2;
+        QrmLoadgen_Item* items = QrmRealloc(loadgen->items, newCapacity * sizeof(QrmLoadgen_Item));
+        if (items == NULL) {
+            return false;
+        }
+        loadgen->items = items;
+        *capacity = newCapacity;
+    }
+    loadgen->items[loadgen->itemCount] = item;
+    loadgen->itemCount += 1;
+    return true;
+}
+
+/// Read corpus: 1 UTF-8 text payload per line (segments are made as text of user input).
+bool QrmLoadgen_loadCorpus(QrmLoadgen* loadgen, const char* path, const char* levels, Unsigned4Bytes seed) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Unable to open %s\n", path);
+        return false;
+    }
+    unsigned int capacity = 0;
+    char line[8192];
+    unsigned int skipCount = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        size_t length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            length -= 1;
+        }
+        if (length == 0) {
+            continue;
+        }
+        QrmLoadgen_Item item;
+        item.level = QrmLoadgen_levelOf(levels[QrmLoadgen_random(&seed) % strlen(levels)]);
+        Utf8String text = U8Create((UnsignedByte*)line, (unsigned int)length);
+        UnicodePoint unicodes = U8ToUnicodes(text);
+        item.segments = UPMakeSegments(unicodes, item.level, &item.count, false);
+        UPDestroy(&unicodes);
+        U8Destroy(&text);
+        if (item.segments == NULL || item.count == 0) {
+            skipCount += 1;
+            continue;
+        }
+        if (!QrmLoadgen_addItem(loadgen, item, &capacity)) {
+            break;
+        }
+    }
+    fclose(file);
+    if (skipCount > 0) {
+        fprintf(stderr, "%u invalid lines are skipped\n", skipCount);
+    }
+    return loadgen->itemCount > 0;
+}
+
+/// Make synthetic payloads: uniform length in `minLength...maxLength` characters, mode & level from lists
+bool QrmLoadgen_makeSynthetic(
+    QrmLoadgen* loadgen, unsigned int minLength, unsigned int maxLength, const char* modes, const char* levels, Unsigned4Bytes seed
+) {
+    static const char* alphaNumeric = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    // ShiftJIS kanji characters: 日本語字
+    static const UnsignedByte kanji[] = { 0x93, 0xFA, 0x96, 0x7B, 0x8C, 0xEA, 0x8E, 0x9A };
+    unsigned int capacity = 0;
+    ALLOC(UnsignedByte, payload, 2 * maxLength + 2);
+    for (unsigned int index = 0; index < LOADGEN_SYNTHETIC_COUNT; index += 1) {
+        QrmEncodingMode mode = QrmLoadgen_modeOf(modes[QrmLoadgen_random(&seed) % strlen(modes)]);
+        QrmLoadgen_Item item;
+        item.level = QrmLoadgen_levelOf(levels[QrmLoadgen_random(&seed) % strlen(levels)]);
+        unsigned int count = minLength + QrmLoadgen_random(&seed) % (maxLength - minLength + 1);
+        for (unsigned int character = 0; character < count; character += 1) {
+            Unsigned4Bytes random = QrmLoadgen_random(&seed);
+            switch (mode) {
+            case EModeNumeric:
+                payload[character] = (UnsignedByte)('0' + random % 10);
+                break;
+            case EModeAlphaNumeric:
+                payload[character] = (UnsignedByte)alphaNumeric[random % 45];
+                break;
+            case EModeByte:
+                payload[character] = (UnsignedByte)random;
+                break;
+            case EModeKanji:
+                payload[2 * character] = kanji[2 * (random % 4)];
+                payload[2 * character + 1] = kanji[2 * (random % 4) + 1];
+                break;
+            }
+        }
+        // Shorten payload which does not fit version 40
+        QrmSegment segment;
+        while (true) {
+            segment = QrmSegCreate(mode, payload, mode == EModeKanji ? 2 * count : count, DEFAULT_ECI_ASSIGMENT);
+            if (count <= 1 || QrmEncoderGetVersion(&segment, 1, item.level, QrmExtraCreateNone(), false) > 0) {
+                break;
+            }
+            QrmSegDestroy(&segment);
+            count /= 2;
+        }
+        ALLOC(QrmSegment, segments, 1);
+        segments[0] = segment;
+        item.segments = segments;
+        item.count = 1;
+        if (!QrmLoadgen_addItem(loadgen, item, &capacity)) {
+            break;
+        }
+    }
+    DEALLOC(payload);
+    return loadgen->itemCount > 0;
+}
+
+void QrmLoadgen_destroyItems(QrmLoadgen* loadgen) {
+    for (unsigned int index = 0; index < loadgen->itemCount; index += 1) {
+        for (unsigned int segment = 0; segment < loadgen->items[index].count; segment += 1) {
+            QrmSegDestroy(&loadgen->items[index].segments[segment]);
+        }
+        QrmFree(loadgen->items[index].segments);
+    }
+    QrmFree(loadgen->items);
+    loadgen->items = NULL;
+    loadgen->itemCount = 0;
+}
+
+// RUN ======================================================================================================
+
+/// Worker task: encode items until deadline
+void QrmLoadgen_work(void* context, unsigned int index) {
+    QrmLoadgen* loadgen = context;
+    QrmLoadgen_Worker* worker = &loadgen->workers[index];
+    QrmSvgStyle style = QrmSvgStyleCreate("white", "black");
+    unsigned long long now = QrmLoadgen_clock();
+    while (now < loadgen->deadline) {
+        QrmLoadgen_Item item = loadgen->items[worker->next];
+        worker->next = (worker->next + 1) % loadgen->itemCount;
+        QrmBoard board = QrmEncoderEncode(item.segments, item.count, item.level, QrmExtraCreateNone(), 0, 0xFF);
+        bool isSuccess = board.dimension > 0;
+        if (isSuccess && loadgen->render != RenderNone) {
+            QrmOutputReset(&worker->output);
+            if (loadgen->render == RenderSvg) {
+                isSuccess = QrmSvgWrite(&worker->output, board, 4, 4, style);
+            } else {
+                isSuccess = QrmPngWrite(&worker->output, board, 4, 4);
+            }
+        }
+        QrmBoardDestroy(&board);
+        unsigned long long end = QrmLoadgen_clock();
+        unsigned long long latency = end - now;
+        now = end;
+        if (!isSuccess) {
+            worker->failureCount += 1;
+            continue;
+        }
+        worker->symbolCount += 1;
+        worker->latencySum += latency;
+        if (latency > worker->latencyMax) {
+            worker->latencyMax = latency;
+        }
+        worker->buckets[QrmLoadgen_bucketOf(latency)] += 1;
+    }
+}
+
+/// Sum of all workers into `total`
+void QrmLoadgen_merge(QrmLoadgen* loadgen, unsigned int workerCount, QrmLoadgen_Worker* total) {
+    memset(total, 0, sizeof(QrmLoadgen_Worker));
+    for (unsigned int index = 0; index < workerCount; index += 1) {
+        QrmLoadgen_Worker* worker = &loadgen->workers[index];
+        total->symbolCount += worker->symbolCount;
+        total->failureCount += worker->failureCount;
+        total->latencySum += worker->latencySum;
+        if (worker->latencyMax > total->latencyMax) {
+            total->latencyMax = worker->latencyMax;
+        }
+        for (unsigned int bucket = 0; bucket < LOADGEN_BUCKET_COUNT; bucket += 1) {
+            total->buckets[bucket] += worker->buckets[bucket];
+        }
+    }
+}
+
+void QrmLoadgen_writeResult(
+    FILE* output, QrmLoadgen* loadgen, unsigned int threadCount, double seconds,
+    QrmLoadgen_Sample* samples, unsigned int sampleCount, unsigned long long startRss
+) {
+    static const char* renderNames[] = { "none", "svg", "png" };
+    ALLOC(QrmLoadgen_Worker, total, 1);
+    if (total == NULL) {
+        return;
+    }
+    QrmLoadgen_merge(loadgen, threadCount, total);
+    unsigned long long count = total->symbolCount;
+    fprintf(
+        output, "{\n  \"tool\": \"qrmatrix_loadgen\",\n  \"libraryVersion\": \"%s\",\n  \"threads\": %u,\n"
+        "  \"render\": \"%s\",\n  \"payloads\": %u,\n  \"seconds\": %.3f,\n  \"symbols\": %llu,\n  \"failures\": %llu,\n"
+        "  \"symbolsPerSecond\": %.1f,\n",
+        VERSION, threadCount, renderNames[loadgen->render], loadgen->itemCount, seconds, count, total->failureCount,
+        count / seconds
+    );
+    if (count > 0) {
+        fprintf(
+            output, "  \"latencyNs\": {\"mean\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu},\n",
+            total->latencySum / count, QrmLoadgen_percentile(total->buckets, count, 50),
+            QrmLoadgen_percentile(total->buckets, count, 90), QrmLoadgen_percentile(total->buckets, count, 99),
+            QrmLoadgen_percentile(total->buckets, count, 99.9), total->latencyMax
+        );
+    }
+    // Histogram: [upper bound (ns), count] of non empty buckets
+    fprintf(output, "  \"histogram\": [");
+    bool isFirst = true;
+    for (unsigned int bucket = 0; bucket < LOADGEN_BUCKET_COUNT; bucket += 1) {
+        if (total->buckets[bucket] == 0) {
+            continue;
+        }
+        fprintf(output, "%s[%llu, %llu]", isFirst ? "" : ", ", QrmLoadgen_bucketValue(bucket), total->buckets[bucket]);
+        isFirst = false;
+    }
+    unsigned long long endRss = sampleCount > 0 ? samples[sampleCount - 1].rssBytes : startRss;
+    fprintf(output, "],\n  \"rssStartBytes\": %llu,\n  \"rssEndBytes\": %llu,\n", startRss, endRss);
+    // Growth after first interval (warm up: allocator pools, caches)
+    unsigned long long baseRss = sampleCount > 1 ? samples[0].rssBytes : startRss;
+    fprintf(output, "  \"rssGrowthBytes\": %lld,\n  \"timeline\": [", (long long)(endRss - baseRss));
+    for (unsigned int index = 0; index < sampleCount; index += 1) {
+        fprintf(
+            output, "%s\n    {\"seconds\": %.3f, \"rssBytes\": %llu, \"intervalSymbolsPerSecond\": %.1f}", index > 0 ? "," : "",
+            samples[index].seconds, samples[index].rssBytes, samples[index].symbolsPerSecond
+        );
+    }
+    fprintf(output, "\n  ]\n}\n");
+    DEALLOC(total);
+}
+
+// COMPARE ==================================================================================================
+
+/// Read whole file (NULL terminated). Release by `QrmFree`.
+char* QrmLoadgen_readFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Unable to open %s\n", path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* content = size >= 0 ? QrmAlloc((size_t)size + 1, 1) : NULL;
+    if (content != NULL && fread(content, 1, (size_t)size, file) != (size_t)size) {
+        QrmFree(content);
+        content = NULL;
+    }
+    fclose(file);
+    return content;
+}
+
+/// Value of first `"key":` number in JSON (results written by this tool). false if not found.
+bool QrmLoadgen_findNumber(const char* json, const char* key, double* value) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* position = strstr(json, pattern);
+    if (position == NULL) {
+        return false;
+    }
+    char* end = NULL;
+    *value = strtod(position + strlen(pattern), &end);
+    return end != position + strlen(pattern);
+}
+
+/// Compare 2 results.
+/// @return Number of regressions (changes worse than `threshold` percent).
+int QrmLoadgen_compare(const char* basePath, const char* newPath, double threshold) {
+    // Metric, higher is better
+    static const struct {
+        const char* key;
+        bool isHigherBetter;
+    } metrics[] = {
+        { "symbolsPerSecond", true },
+        { "mean", false },
+        { "p50", false },
+        { "p90", false },
+        { "p99", false },
+        { "p999", false },
+        { "rssGrowthBytes", false }
+    };
+    // RSS growth: ignore changes less than this
+    static const double rssNoise = 1024 * 1024;
+    char* baseJson = QrmLoadgen_readFile(basePath);
+    char* newJson = QrmLoadgen_readFile(newPath);
+    if (baseJson == NULL || newJson == NULL) {
+        QrmFree(baseJson);
+        QrmFree(newJson);
+        return -1;
+    }
+    int regressionCount = 0;
+    printf("%-18s %16s %16s %9s\n", "metric", "base", "new", "change");
+    for (unsigned int index = 0; index < sizeof(metrics) / sizeof(metrics[0]); index += 1) {
+        double baseValue = 0;
+        double newValue = 0;
+        if (!QrmLoadgen_findNumber(baseJson, metrics[index].key, &baseValue) ||
+            !QrmLoadgen_findNumber(newJson, metrics[index].key, &newValue)) {
+            continue;
+        }
+        double change = baseValue != 0 ? (newValue - baseValue) * 100 / baseValue : 0;
+        bool isRegression;
+        if (metrics[index].isHigherBetter) {
+            isRegression = newValue < baseValue * (1 - threshold / 100);
+        } else if (strcmp(metrics[index].key, "rssGrowthBytes") == 0) {
+            isRegression = newValue - baseValue > rssNoise && newValue > baseValue * (1 + threshold / 100);
+        } else {
+            isRegression = newValue > baseValue * (1 + threshold / 100);
+        }
+        printf(
+            "%-18s %16.1f %16.1f %+8.1f%%%s\n", metrics[index].key, baseValue, newValue, change,
+            isRegression ? "  REGRESSION" : ""
+        );
+        regressionCount += isRegression ? 1 : 0;
+    }
+    QrmFree(baseJson);
+    QrmFree(newJson);
+    return regressionCount;
+}
+
+// MAIN =====================================================================================================
+
+void QrmLoadgen_printUsage(const char* name) {
+    fprintf(
+        stderr,
+        "Usage: %s [--corpus FILE] [--lengths MIN-MAX] [--modes nabk] [--levels LMQH] [--threads N]\n"
+        "          [--duration SECONDS] [--interval SECONDS] [--render none|svg|png] [--seed N] [--output FILE]\n"
+        "       %s --compare BASE.json NEW.json [--threshold PERCENT]\n",
+        name, name
+    );
+}
+
+int main(int argc, char** argv) {
+    const char* corpusPath = NULL;
+    const char* outputPath = NULL;
+    const char* modes = "nabk";
+    const char* levels = "M";
+    const char* comparePaths[2] = { NULL, NULL };
+    unsigned int minLength = 10;
+    unsigned int maxLength = 200;
+    unsigned int threadCount = QrmThreadPoolProcessorCount();
+    double duration = 10;
+    double interval = 1;
+    double threshold = 5;
+    Unsigned4Bytes seed = 1;
+    QrmLoadgen loadgen;
+    memset(&loadgen, 0, sizeof(loadgen));
+    for (int index = 1; index < argc; index += 1) {
+        const char* option = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (strcmp(option, "--corpus") == 0 && hasValue) {
+            corpusPath = argv[++index];
+        } else if (strcmp(option, "--lengths") == 0 && hasValue) {
+            if (sscanf(argv[++index], "%u-%u", &minLength, &maxLength) != 2 || minLength == 0 || maxLength < minLength) {
+                fprintf(stderr, "Invalid lengths: %s\n", argv[index]);
+                return 2;
+            }
+        } else if (strcmp(option, "--modes") == 0 && hasValue) {
+            modes = argv[++index];
+        } else if (strcmp(option, "--levels") == 0 && hasValue) {
+            levels = argv[++index];
+        } else if (strcmp(option, "--threads") == 0 && hasValue) {
+            threadCount = (unsigned int)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--duration") == 0 && hasValue) {
+            duration = strtod(argv[++index], NULL);
+        } else if (strcmp(option, "--interval") == 0 && hasValue) {
+            interval = strtod(argv[++index], NULL);
+        } else if (strcmp(option, "--render") == 0 && hasValue) {
+            index += 1;
+            if (strcmp(argv[index], "svg") == 0) {
+                loadgen.render = RenderSvg;
+            } else if (strcmp(argv[index], "png") == 0) {
+                loadgen.render = RenderPng;
+            } else if (strcmp(argv[index], "none") != 0) {
+                fprintf(stderr, "Invalid renderer: %s\n", argv[index]);
+                return 2;
+            }
+        } else if (strcmp(option, "--seed") == 0 && hasValue) {
+            seed = (Unsigned4Bytes)strtoul(argv[++index], NULL, 10);
+        } else if (strcmp(option, "--output") == 0 && hasValue) {
+            outputPath = argv[++index];
+        } else if (strcmp(option, "--compare") == 0 && index + 2 < argc) {
+            comparePaths[0] = argv[++index];
+            comparePaths[1] = argv[++index];
+        } else if (strcmp(option, "--threshold") == 0 && hasValue) {
+            threshold = strtod(argv[++index], NULL);
+        } else {
+            QrmLoadgen_printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (comparePaths[0] != NULL) {
+        int regressionCount = QrmLoadgen_compare(comparePaths[0], comparePaths[1], threshold);
+        if (regressionCount < 0) {
+            return 2;
+        }
+        return regressionCount > 0 ? 1 : 0;
+    }
+    if (threadCount == 0 || duration <= 0 || interval <= 0 || modes[0] == 0 || levels[0] == 0) {
+        QrmLoadgen_printUsage(argv[0]);
+        return 2;
+    }
+    QRMatrixInit();
+    bool isLoaded = corpusPath != NULL
+        ? QrmLoadgen_loadCorpus(&loadgen, corpusPath, levels, seed)
+        : QrmLoadgen_makeSynthetic(&loadgen, minLength, maxLength, modes, levels, seed);
+    if (!isLoaded) {
+        fprintf(stderr, "No payload\n");
+        QrmLoadgen_destroyItems(&loadgen);
+        return 2;
+    }
+    ALLOC(QrmLoadgen_Worker, workers, threadCount);
+    unsigned int sampleCapacity = (unsigned int)(duration / interval) + 2;
+    ALLOC(QrmLoadgen_Sample, samples, sampleCapacity);
+    if (workers == NULL || samples == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+    loadgen.workers = workers;
+    for (unsigned int index = 0; index < threadCount; index += 1) {
+        // Start at different positions
+        workers[index].next = (unsigned int)((unsigned long long)index * loadgen.itemCount / threadCount);
+        workers[index].output = QrmOutputCreateBuffer(4096);
+    }
+    // Calling thread of `QrmThreadPoolRun` is a worker too
+    QrmThreadPool pool = QrmThreadPoolCreate(threadCount - 1);
+    unsigned long long startRss = QrmLoadgen_rss();
+    unsigned long long start = QrmLoadgen_clock();
+    unsigned long long end = start + (unsigned long long)(duration * 1e9);
+    unsigned long long previousCount = 0;
+    unsigned int sampleCount = 0;
+    QrmLoadgen_Worker* total = QrmAlloc(1, sizeof(QrmLoadgen_Worker));
+    while (total != NULL && sampleCount < sampleCapacity) {
+        unsigned long long intervalStart = QrmLoadgen_clock();
+        if (intervalStart >= end) {
+            break;
+        }
+        loadgen.deadline = intervalStart + (unsigned long long)(interval * 1e9);
+        if (loadgen.deadline > end) {
+            loadgen.deadline = end;
+        }
+        QrmThreadPoolRun(pool, QrmLoadgen_work, &loadgen, threadCount);
+        unsigned long long now = QrmLoadgen_clock();
+        QrmLoadgen_merge(&loadgen, threadCount, total);
+        QrmLoadgen_Sample sample;
+        sample.seconds = (now - start) / 1e9;
+        sample.rssBytes = QrmLoadgen_rss();
+        sample.symbolsPerSecond = (total->symbolCount - previousCount) / ((now - intervalStart) / 1e9);
+        samples[sampleCount] = sample;
+        sampleCount += 1;
+        previousCount = total->symbolCount;
+        fprintf(
+            stderr, "%7.1fs %12.0f symbols/s %8llu KiB\n", sample.seconds, sample.symbolsPerSecond, sample.rssBytes / 1024
+        );
+    }
+    double seconds = (QrmLoadgen_clock() - start) / 1e9;
+    QrmFree(total);
+    QrmThreadPoolDestroy(&pool);
+    FILE* output = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+    if (output == NULL) {
+        fprintf(stderr, "Unable to open %s\n", outputPath);
+    } else {
+        QrmLoadgen_writeResult(output, &loadgen, threadCount, seconds, samples, sampleCount, startRss);
+        if (output != stdout) {
+            fclose(output);
+        }
+    }
+    for (unsigned int index = 0; index < threadCount; index += 1) {
+        QrmOutputDestroy(&workers[index].output);
+    }
+    DEALLOC(workers);
+    DEALLOC(samples);
+    QrmLoadgen_destroyItems(&loadgen);
+    return output != NULL ? 0 : 2;
+}
@@ -0,0 +1,167 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Allocations of encoding counted by `QrmCountingAllocator` set with `QrmSetThreadAllocator`:
+// every allocation must be released by the same allocator, including work done on other threads
+// (thread pool workers, board cache released after the override is removed).
+
+#include <pthread.h>
+#include "check.h"
+#include "qrmatrixencoder.h"
+#include "Allocator/countingallocator.h"
+#include "ThreadPool/concurrentencoder.h"
+#include "Cache/boardcache.h"
+
+/// Expected number of allocations of encoding `shortText` (version 1) & `longText` (version 6), level M, auto mask.
+/// Update when encoder changes its allocations on purpose.
+#define EXPECTED_ALLOCATIONS_SHORT 72
+#define EXPECTED_ALLOCATIONS_LONG 235
+
+static const char shortText[] = "QRMatrix";
+static const char longText[] =
+    "QRMatrix counting allocator test: version of this symbol is above 6 so version information is encoded too.";
+
+static QrmAllocationCounters encodeCounted(QrmCountingAllocator counting, const char* text, unsigned int length) {
+    QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, length, DEFAULT_ECI_ASSIGMENT);
+    QrmCountingAllocatorReset(counting);
+    QrmAllocator previous = QrmSetThreadAllocator(counting.allocator);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelMedium, QrmExtraCreateNone(), 0, 0xFF);
+    CHECK(board.dimension > 0);
+    QrmBoardDestroy(&board);
+    QrmSetThreadAllocator(previous);
+    QrmSegDestroy(&segment);
+    return QrmCountingAllocatorGetCounters(counting);
+}
+
+static void testEncode(QrmCountingAllocator counting) {
+    QrmAllocationCounters counters = encodeCounted(counting, shortText, sizeof(shortText) - 1);
+    CHECK(counters.allocationCount == EXPECTED_ALLOCATIONS_SHORT);
+    CHECK(counters.releaseCount == counters.allocationCount);
+    CHECK(counters.currentBytes == 0);
+    counters = encodeCounted(counting, longText, sizeof(longText) - 1);
+    CHECK(counters.allocationCount == EXPECTED_ALLOCATIONS_LONG);
+    CHECK(counters.releaseCount == counters.allocationCount);
+    CHECK(counters.currentBytes == 0);
+    // Same input, same allocations
+    QrmAllocationCounters again = encodeCounted(counting, longText, sizeof(longText) - 1);
+    CHECK(again.allocationCount == counters.allocationCount);
+    CHECK(again.totalBytes == counters.totalBytes);
+}
+
+/// Structured Append on thread pool workers allocates with the allocator of the calling thread
+static void testThreadPool(QrmCountingAllocator counting) {
+    QrmSegment segments[3];
+    QrmStructuredAppend parts[3];
+    for (unsigned int index = 0; index < 3; index += 1) {
+        segments[index] = QrmSegCreate(EModeByte, (const UnsignedByte*)longText, sizeof(longText) - 1, DEFAULT_ECI_ASSIGMENT);
+        parts[index] = QrmStrAppCreate(&segments[index], 1, ELevelQuarter);
+    }
+    QrmThreadPool pool = QrmThreadPoolCreate(3);
+
+    QrmCountingAllocatorReset(counting);
+    QrmAllocator previous = QrmSetThreadAllocator(counting.allocator);
+    QrmBoard* boards = QrmEncoderMakeStructuredAppend(parts, 3);
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters sequential = QrmCountingAllocatorGetCounters(counting);
+
+    QrmCountingAllocatorReset(counting);
+    previous = QrmSetThreadAllocator(counting.allocator);
+    QrmBoard* concurrentBoards = QrmEncoderMakeStructuredAppendConcurrently(parts, 3, pool);
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters concurrent = QrmCountingAllocatorGetCounters(counting);
+    CHECK(concurrent.allocationCount > 0);
+    CHECK(concurrent.allocationCount == sequential.allocationCount);
+    CHECK(concurrent.totalBytes == sequential.totalBytes);
+
+    previous = QrmSetThreadAllocator(counting.allocator);
+    for (unsigned int index = 0; index < 3; index += 1) {
+        CHECK(boards != NULL && boards[index].dimension > 0);
+        CHECK(concurrentBoards != NULL && concurrentBoards[index].dimension > 0);
+        QrmBoardDestroy(&boards[index]);
+        QrmBoardDestroy(&concurrentBoards[index]);
+    }
+    DEALLOC(boards);
+    DEALLOC(concurrentBoards);
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(counting);
+    CHECK(counters.currentBytes == 0);
+
+    QrmThreadPoolDestroy(&pool);
+    for (unsigned int index = 0; index < 3; index += 1) {
+        QrmStrAppDestroy(&parts[index]);
+        QrmSegDestroy(&segments[index]);
+    }
+}
+
+typedef struct {
+    QrmBoardCache cache;
+    QrmSegment segment;
+    QrmSharedBoard board;
+} CacheJob;
+
+static void* encodeInCache(void* argument) {
+    CacheJob* job = argument;
+    job->board = QrmBoardCacheEncode(job->cache, &job->segment, 1, ELevelMedium, QrmExtraCreateNone(), 0, 0xFF);
+    return NULL;
+}
+
+/// Board cache uses the allocator of the thread which created it, whichever thread encodes or releases
+static void testBoardCache(QrmCountingAllocator counting) {
+    CacheJob job;
+    job.segment = QrmSegCreate(EModeByte, (const UnsignedByte*)longText, sizeof(longText) - 1, DEFAULT_ECI_ASSIGMENT);
+    QrmCountingAllocatorReset(counting);
+    QrmAllocator previous = QrmSetThreadAllocator(counting.allocator);
+    job.cache = QrmBoardCacheCreate(1 << 20);
+    QrmSetThreadAllocator(previous);
+    CHECK(job.cache.state != NULL);
+
+    // Encode on other thread (no override)
+    pthread_t thread;
+    CHECK(pthread_create(&thread, NULL, encodeInCache, &job) == 0);
+    pthread_join(thread, NULL);
+    CHECK(job.board.board.dimension > 0);
+    QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(counting);
+    CHECK(counters.allocationCount > 2);
+
+    // Shared board outlives the cache; released here without override
+    QrmBoardCacheDestroy(&job.cache);
+    QrmSharedBoardRelease(&job.board);
+    counters = QrmCountingAllocatorGetCounters(counting);
+    CHECK(counters.releaseCount == counters.allocationCount);
+    CHECK(counters.currentBytes == 0);
+    QrmSegDestroy(&job.segment);
+}
+
+int main(void) {
+    QrmCountingAllocator counting = QrmCountingAllocatorCreate(QrmAllocatorCreateDefault());
+    CHECK(counting.state != NULL);
+    if (counting.state == NULL) {
+        return CHECK_RESULT();
+    }
+    QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(counting);
+    CHECK(counters.allocationCount == 0 && counters.releaseCount == 0 && counters.currentBytes == 0);
+    testEncode(counting);
+    testThreadPool(counting);
+    testBoardCache(counting);
+    QrmCountingAllocatorDestroy(&counting);
+    return CHECK_RESULT();
+}
@@ -0,0 +1,153 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Bit patterns written by `QrmCopyValueBits` & segment headers (ECI, mode, character count) against a bit by bit reference.
+// Built with default & forced big endian (`QRM_LITTLE_ENDIAN=0`) configurations.
+
+#include <string.h>
+#include "check.h"
+#include "common.h"
+#include "qrmatrixencoder.h"
+
+/// Reference: append `count` lowest bits of `value` (highest bit first), 1 bit at a time
+static void appendBits(UnsignedByte* bits, unsigned int* length, Unsigned4Bytes value, unsigned int count) {
+    for (unsigned int index = 0; index < count; index += 1) {
+        unsigned int bit = (value >> (count - 1 - index)) & 1;
+        UnsignedByte mask = (UnsignedByte)(0x80 >> (*length % 8));
+        bits[*length / 8] = bit ? (bits[*length / 8] | mask) : (bits[*length / 8] & ~mask);
+        *length += 1;
+    }
+}
+
+static bool getBit(const UnsignedByte* bits, unsigned int index) {
+    return (bits[index / 8] >> (7 - index % 8)) & 1;
+}
+
+static void checkCopyValueBits(void) {
+    static const Unsigned4Bytes values[] = { 0, 1, 0x5, 0x3FF, 0x1234, 0xA5A5A5A5, 0x80000001, 0xFFFFFFFF };
+    static const UnsignedByte fills[] = { 0x00, 0xFF, 0xA5 };
+    for (unsigned int valueIndex = 0; valueIndex < sizeof(values) / sizeof(values[0]); valueIndex += 1) {
+        for (unsigned int count = 1; count <= 32; count += 1) {
+            for (unsigned int start = 0; start < 16; start += 1) {
+                for (unsigned int fill = 0; fill < sizeof(fills); fill += 1) {
+                    UnsignedByte actual[8];
+                    UnsignedByte expected[8];
+                    memset(actual, fills[fill], sizeof(actual));
+                    memset(expected, fills[fill], sizeof(expected));
+                    unsigned int length = start;
+                    appendBits(expected, &length, values[valueIndex], count);
+                    CHECK(QrmCopyValueBits(values[valueIndex], count, actual, start));
+                    CHECK(memcmp(actual, expected, sizeof(actual)) == 0);
+                }
+            }
+        }
+    }
+    UnsignedByte buffer[8] = { 0 };
+    CHECK(!QrmCopyValueBits(1, 0, buffer, 0));
+    CHECK(!QrmCopyValueBits(1, 33, buffer, 0));
+}
+
+/// Check first `length` bits of data codewords (de-interleaved) of encoded segment
+static void checkHeader(QrmSegment segment, UnsignedByte minVersion, const UnsignedByte* expected, unsigned int length) {
+    QrmCodewords codewords = QrmEncoderEncodeCodewords(&segment, 1, ELevelLow, QrmExtraCreateNone(), minVersion);
+    CHECK(codewords.version == (minVersion > 0 ? minVersion : 1));
+    if (codewords.version == 0) {
+        return;
+    }
+    // 1st data codeword of each block, then 2nd...: header is in the first block
+    unsigned int blockCount = QrmInfoECBlockTotalCount(QrmGetSymbolInfo(codewords.version, ELevelLow, false));
+    CHECK(blockCount > 0 && (length + 7) / 8 * blockCount <= codewords.dataLength);
+    UnsignedByte header[16] = { 0 };
+    for (unsigned int index = 0; index < (length + 7) / 8 && blockCount > 0; index += 1) {
+        header[index] = codewords.data[index * blockCount];
+    }
+    for (unsigned int index = 0; index < length; index += 1) {
+        CHECK(getBit(header, index) == getBit(expected, index));
+    }
+    QrmCodewordsDestroy(&codewords);
+}
+
+static void checkEci(void) {
+    static const unsigned int ecis[] = { 3, 127, 128, 900, 16383, 16384, 811799, 999999 };
+    for (unsigned int index = 0; index < sizeof(ecis) / sizeof(ecis[0]); index += 1) {
+        unsigned int eci = ecis[index];
+        UnsignedByte expected[16] = { 0 };
+        unsigned int length = 0;
+        // Default ECI: no ECI header
+        if (eci != DEFAULT_ECI_ASSIGMENT) {
+            appendBits(expected, &length, 0b0111, 4);
+            if (eci <= 127) {
+                appendBits(expected, &length, eci, 8);
+            } else if (eci <= 16383) {
+                appendBits(expected, &length, 0b10, 2);
+                appendBits(expected, &length, eci, 14);
+            } else {
+                appendBits(expected, &length, 0b110, 3);
+                appendBits(expected, &length, eci, 21);
+            }
+        }
+        appendBits(expected, &length, 0b0100, 4);
+        appendBits(expected, &length, 2, 8);
+        appendBits(expected, &length, 'A', 8);
+        appendBits(expected, &length, 'B', 8);
+        QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)"AB", 2, eci);
+        checkHeader(segment, 0, expected, length);
+        QrmSegDestroy(&segment);
+    }
+}
+
+static void checkCharacterCount(void) {
+    static const struct {
+        QrmEncodingMode mode;
+        UnsignedByte modeBits;
+        const char* text;
+        unsigned int length;
+        unsigned int count;
+        unsigned int countBits[3];
+    } cases[] = {
+        { EModeNumeric, 0b0001, "0123456789", 10, 10, { 10, 12, 14 } },
+        { EModeAlphaNumeric, 0b0010, "HTTPS://QRM", 11, 11, { 9, 11, 13 } },
+        { EModeByte, 0b0100, "byte mode", 9, 9, { 8, 16, 16 } },
+        { EModeKanji, 0b1000, "\x93\x5f\xe4\xaa\x81\x40", 6, 3, { 8, 10, 12 } },
+    };
+    static const UnsignedByte versions[] = { 1, 10, 27 };
+    for (unsigned int index = 0; index < sizeof(cases) / sizeof(cases[0]); index += 1) {
+        for (unsigned int range = 0; range < 3; range += 1) {
+            UnsignedByte expected[16] = { 0 };
+            unsigned int length = 0;
+            appendBits(expected, &length, cases[index].modeBits, 4);
+            appendBits(expected, &length, cases[index].count, cases[index].countBits[range]);
+            QrmSegment segment = QrmSegCreate(cases[index].mode, (const UnsignedByte*)cases[index].text, cases[index].length, DEFAULT_ECI_ASSIGMENT);
+            checkHeader(segment, versions[range], expected, length);
+            QrmSegDestroy(&segment);
+        }
+    }
+}
+
+int main(void) {
+    // Library must be built with the configuration of this program
+    CHECK(qrmIsLittleEndian == QRM_LITTLE_ENDIAN);
+    checkCopyValueBits();
+    checkEci();
+    checkCharacterCount();
+    return CHECK_RESULT();
+}
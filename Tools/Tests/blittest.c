@@ -0,0 +1,131 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// `QrmBoardBlit` must be bit-exact with a scalar per-module reference, for every pixel format, scale,
+// odd x offset & padded stride. Pixels outside of the board (padding, other bits of partial bytes) must be kept.
+// Built twice: with SIMD (if available) & with `QRM_NO_SIMD`.
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "qrmatrixencoder.h"
+#include "Render/blit.h"
+
+#define BACKGROUND_BYTE 0xA5
+
+/// Write 1 pixel, simply
+static void referencePixel(UnsignedByte* line, QrmPixelFormat format, unsigned int index, Unsigned4Bytes color) {
+    switch (format) {
+    case Pixel1Bit: {
+        UnsignedByte mask = (UnsignedByte)(0x80 >> (index & 7));
+        line[index >> 3] = color != 0 ? (line[index >> 3] | mask) : (line[index >> 3] & ~mask);
+        break;
+    }
+    case PixelGray8:
+        line[index] = (UnsignedByte)color;
+        break;
+    case PixelRGB565: {
+        Unsigned2Bytes value = (Unsigned2Bytes)color;
+        memcpy(line + index * 2, &value, 2);
+        break;
+    }
+    case PixelRGBA8888:
+        line[index * 4] = (UnsignedByte)(color >> 24);
+        line[index * 4 + 1] = (UnsignedByte)(color >> 16);
+        line[index * 4 + 2] = (UnsignedByte)(color >> 8);
+        line[index * 4 + 3] = (UnsignedByte)color;
+        break;
+    }
+}
+
+static void referenceBlit(QrmBoard board, UnsignedByte* destination, unsigned int stride, QrmPixelFormat format,
+                          unsigned int scale, unsigned int x, unsigned int y, Unsigned4Bytes foreground, Unsigned4Bytes background) {
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        for (unsigned int column = 0; column < board.dimension; column += 1) {
+            bool isDark = (board.buffer[row][column] & CellLowMask) == CellSet;
+            for (unsigned int pixelRow = 0; pixelRow < scale; pixelRow += 1) {
+                UnsignedByte* line = destination + (size_t)(y + row * scale + pixelRow) * stride;
+                for (unsigned int pixel = 0; pixel < scale; pixel += 1) {
+                    referencePixel(line, format, x + column * scale + pixel, isDark ? foreground : background);
+                }
+            }
+        }
+    }
+}
+
+static void testBlit(QrmBoard board, QrmPixelFormat format, unsigned int scale, unsigned int x, unsigned int y, unsigned int padding) {
+    unsigned int width = board.dimension * scale;
+    unsigned int stride = QrmPixelRowLength(format, x + width) + padding;
+    size_t size = (size_t)stride * (y + width + 2);
+    UnsignedByte* expected = malloc(size);
+    UnsignedByte* result = malloc(size);
+    memset(expected, BACKGROUND_BYTE, size);
+    memset(result, BACKGROUND_BYTE, size);
+    // Colors with different bytes to catch byte order & channel mistakes
+    Unsigned4Bytes foreground = format == Pixel1Bit ? 1 : (format == PixelGray8 ? 0x12 : (format == PixelRGB565 ? 0x1234 : 0x12345678));
+    Unsigned4Bytes background = format == Pixel1Bit ? 0 : (format == PixelGray8 ? 0xED : (format == PixelRGB565 ? 0xEDCB : 0xEDCBA987));
+    referenceBlit(board, expected, stride, format, scale, x, y, foreground, background);
+    CHECK(QrmBoardBlit(board, result, stride, format, scale, x, y, foreground, background));
+    bool isSame = memcmp(expected, result, size) == 0;
+    if (!isSame) {
+        fprintf(stderr, "format %d, dimension %u, scale %u, x %u, y %u, padding %u\n",
+                format, board.dimension, scale, x, y, padding);
+    }
+    CHECK(isSame);
+    free(expected);
+    free(result);
+}
+
+int main(void) {
+    static const char text[] = "QRMatrix blit";
+    static const UnsignedByte versions[] = { 1, 7, QR_MAX_VERSION };
+    static const QrmPixelFormat formats[] = { Pixel1Bit, PixelGray8, PixelRGB565, PixelRGBA8888 };
+    static const unsigned int scales[] = { 1, 2, 3, 5, 8 };
+    static const unsigned int offsets[] = { 0, 1, 3, 7, 13 };
+    static const unsigned int paddings[] = { 0, 1, 5 };
+    for (unsigned int versionIndex = 0; versionIndex < sizeof(versions); versionIndex += 1) {
+        QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, sizeof(text) - 1, DEFAULT_ECI_ASSIGMENT);
+        QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelLow, QrmExtraCreateNone(), versions[versionIndex], 0xFF);
+        CHECK(board.dimension > 0);
+        for (unsigned int formatIndex = 0; formatIndex < 4 && board.dimension > 0; formatIndex += 1) {
+            for (unsigned int scaleIndex = 0; scaleIndex < 5; scaleIndex += 1) {
+                for (unsigned int offsetIndex = 0; offsetIndex < 5; offsetIndex += 1) {
+                    unsigned int offset = offsets[offsetIndex];
+                    testBlit(board, formats[formatIndex], scales[scaleIndex], offset, offset / 2, paddings[offsetIndex % 3]);
+                }
+            }
+        }
+        QrmBoardDestroy(&board);
+        QrmSegDestroy(&segment);
+    }
+
+    // Invalid parameters
+    QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, sizeof(text) - 1, DEFAULT_ECI_ASSIGMENT);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelLow, QrmExtraCreateNone(), 0, 0xFF);
+    UnsignedByte bitmap[4];
+    CHECK(!QrmBoardBlit(board, bitmap, 1, PixelGray8, 1, 0, 0, 0, 0xFF));
+    CHECK(!QrmBoardBlit(board, bitmap, 1000, PixelGray8, 0, 0, 0, 0, 0xFF));
+    CHECK(!QrmBoardBlit(board, NULL, 1000, PixelGray8, 1, 0, 0, 0, 0xFF));
+    QrmBoardDestroy(&board);
+    QrmSegDestroy(&segment);
+    return CHECK_RESULT();
+}
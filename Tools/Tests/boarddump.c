@@ -0,0 +1,102 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Print boards of fixed inputs (ECI, Kanji, MicroQR, version information, Structured Append, UTF-8 conversion).
+// Built with default & forced big endian (`QRM_LITTLE_ENDIAN=0`) configurations: outputs must be the same.
+
+#include <string.h>
+#include "check.h"
+#include "common.h"
+#include "qrmatrixencoder.h"
+#include "String/utf8string.h"
+#include "String/unicodepoint.h"
+
+static void printBoard(QrmBoard board) {
+    printf("%u\n", board.dimension);
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        for (unsigned int column = 0; column < board.dimension; column += 1) {
+            putchar('0' + (board.buffer[row][column] & 0x0F));
+        }
+        putchar('\n');
+    }
+}
+
+static void printEncoded(QrmEncodingMode mode, const char* text, unsigned int length, unsigned int eci,
+                         QrmErrorCorrectionLevel level, QrmExtraEncodingInfo extraMode, UnsignedByte minVersion) {
+    QrmSegment segment = QrmSegCreate(mode, (const UnsignedByte*)text, length, eci);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, level, extraMode, minVersion, 0xFF);
+    CHECK(board.dimension > 0);
+    printBoard(board);
+    QrmBoardDestroy(&board);
+    QrmSegDestroy(&segment);
+}
+
+int main(void) {
+    // Library must be built with the configuration of this program
+    CHECK(qrmIsLittleEndian == QRM_LITTLE_ENDIAN);
+
+    static const unsigned int ecis[] = { 3, 127, 128, 900, 16383, 16384, 811799, 999999 };
+    for (unsigned int index = 0; index < sizeof(ecis) / sizeof(ecis[0]); index += 1) {
+        printEncoded(EModeByte, "ECI test", 8, ecis[index], ELevelMedium, QrmExtraCreateNone(), 0);
+    }
+
+    static const char kanji[] = "\x81\x40\x9f\xfc\xe0\x40\xeb\xbf\x93\x5f\xe4\xaa";
+    printEncoded(EModeKanji, kanji, sizeof(kanji) - 1, DEFAULT_ECI_ASSIGMENT, ELevelLow, QrmExtraCreateNone(), 0);
+    printEncoded(EModeKanji, kanji, sizeof(kanji) - 1, DEFAULT_ECI_ASSIGMENT, ELevelLow, QrmExtraCreate(XModeMicroQr), 0);
+
+    for (UnsignedByte version = 7; version <= QR_MAX_VERSION; version += 11) {
+        printEncoded(EModeNumeric, "0123456789", 10, DEFAULT_ECI_ASSIGMENT, ELevelHigh, QrmExtraCreateNone(), version);
+    }
+    printEncoded(EModeAlphaNumeric, "HTTPS://EXAMPLE.COM/QRM", 23, DEFAULT_ECI_ASSIGMENT, ELevelQuarter, QrmExtraCreateNone(), 0);
+
+    QrmSegment segments[2];
+    segments[0] = QrmSegCreate(EModeNumeric, (const UnsignedByte*)"123", 3, DEFAULT_ECI_ASSIGMENT);
+    segments[1] = QrmSegCreate(EModeAlphaNumeric, (const UnsignedByte*)"ABC", 3, DEFAULT_ECI_ASSIGMENT);
+    QrmStructuredAppend parts[2];
+    parts[0] = QrmStrAppCreate(&segments[0], 1, ELevelLow);
+    parts[1] = QrmStrAppCreate(&segments[1], 1, ELevelLow);
+    QrmBoard* boards = QrmEncoderMakeStructuredAppend(parts, 2);
+    CHECK(boards != NULL);
+    for (unsigned int index = 0; index < 2 && boards != NULL; index += 1) {
+        printBoard(boards[index]);
+        QrmBoardDestroy(&boards[index]);
+    }
+    DEALLOC(boards);
+    for (unsigned int index = 0; index < 2; index += 1) {
+        QrmStrAppDestroy(&parts[index]);
+        QrmSegDestroy(&segments[index]);
+    }
+
+    static const char utf8[] = "A\xc2\xa9\xdf\xbf\xe0\xa0\x80\xef\xbf\xbf\xf0\x9f\x98\x80\xf4\x8f\xbf\xbf";
+    Utf8String text = U8Create((const UnsignedByte*)utf8, sizeof(utf8) - 1);
+    UnicodePoint unicodes = U8ToUnicodes(text);
+    for (unsigned int index = 0; index < unicodes.length; index += 1) {
+        printf("%x ", (unsigned int)unicodes.raw[index]);
+    }
+    Utf8String back = U8CreateFromUnicodes(unicodes);
+    CHECK(back.byteCount == sizeof(utf8) - 1 && memcmp(back.raw, utf8, sizeof(utf8) - 1) == 0);
+    printf("\n");
+    U8Destroy(&back);
+    UPDestroy(&unicodes);
+    U8Destroy(&text);
+    return CHECK_RESULT();
+}
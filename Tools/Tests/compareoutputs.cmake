@@ -0,0 +1,21 @@
+# Run 2 programs (`FIRST` & `SECOND`) & fail if their exit codes or standard outputs differ.
+# Optional `EXPECTED_MD5`: golden checksum of the output (both outputs could be equally wrong).
+# Usage: cmake -DFIRST=<program> -DSECOND=<program> [-DEXPECTED_MD5=<md5>] -P compareoutputs.cmake
+
+execute_process(COMMAND ${FIRST} OUTPUT_VARIABLE FIRST_OUTPUT RESULT_VARIABLE FIRST_RESULT)
+execute_process(COMMAND ${SECOND} OUTPUT_VARIABLE SECOND_OUTPUT RESULT_VARIABLE SECOND_RESULT)
+if(NOT FIRST_RESULT EQUAL 0 OR NOT SECOND_RESULT EQUAL 0)
+    message(FATAL_ERROR "Failed: ${FIRST} (${FIRST_RESULT}), ${SECOND} (${SECOND_RESULT})")
+endif()
+if(FIRST_OUTPUT STREQUAL "")
+    message(FATAL_ERROR "No output: ${FIRST}")
+endif()
+if(NOT FIRST_OUTPUT STREQUAL SECOND_OUTPUT)
+    message(FATAL_ERROR "Outputs differ: ${FIRST} & ${SECOND}")
+endif()
+if(DEFINED EXPECTED_MD5)
+    string(MD5 FIRST_MD5 "${FIRST_OUTPUT}")
+    if(NOT FIRST_MD5 STREQUAL EXPECTED_MD5)
+        message(FATAL_ERROR "Output of ${FIRST} (MD5 ${FIRST_MD5}) is not the expected output (MD5 ${EXPECTED_MD5})")
+    endif()
+endif()
@@ -0,0 +1,110 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Boards of compile-time encoder (`qrmatrixconstexpr.hpp`) checked against known modules (`static_assert`)
+// and against run-time encoder (`qrm::encode(...).packed()`).
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include "check.h"
+#include "qrmatrixconstexpr.hpp"
+
+// KNOWN BOARDS =====================================================================================================================================
+
+// "1", level L, Numeric: version 1, mask 2
+static constexpr auto numericBoard = qrm::encode<"1", qrm::Level::L, qrm::Mode::Numeric>();
+static_assert(numericBoard.version == 1 && numericBoard.dimension == 21 && numericBoard.maskId == 2);
+static_assert(numericBoard.modules == std::array<UnsignedByte, 63> {
+    0xFE, 0x3B, 0xF8, 0x82, 0xEA, 0x08, 0xBA, 0x3A, 0xE8, 0xBA, 0xCA, 0xE8, 0xBA, 0x4A, 0xE8, 0x82, 0x92, 0x08, 0xFE, 0xAB, 0xF8,
+    0x00, 0x40, 0x00, 0xFB, 0x95, 0x50, 0xD1, 0xBE, 0x40, 0xEB, 0x2B, 0x00, 0xF0, 0x5E, 0x40, 0x17, 0xE9, 0x30, 0x00, 0xA9, 0x20,
+    0xFE, 0xF4, 0xF0, 0x82, 0x01, 0xA0, 0xBA, 0xF4, 0xE0, 0xBA, 0xDE, 0x40, 0xBA, 0xEB, 0x00, 0x82, 0xDE, 0x50, 0xFE, 0xC9, 0x20
+});
+
+// "A", level M, AlphaNumeric: version 1, mask 3
+static constexpr auto alphaNumericBoard = qrm::encode<"A", qrm::Level::M, qrm::Mode::AlphaNumeric>();
+static_assert(alphaNumericBoard.version == 1 && alphaNumericBoard.dimension == 21 && alphaNumericBoard.maskId == 3);
+static_assert(alphaNumericBoard.modules == std::array<UnsignedByte, 63> {
+    0xFE, 0xD3, 0xF8, 0x82, 0xCA, 0x08, 0xBA, 0x3A, 0xE8, 0xBA, 0xA2, 0xE8, 0xBA, 0x32, 0xE8, 0x82, 0x5A, 0x08, 0xFE, 0xAB, 0xF8,
+    0x00, 0x98, 0x00, 0xB7, 0x1A, 0x58, 0xD8, 0x7E, 0x40, 0x9B, 0x50, 0x68, 0x54, 0x13, 0xF0, 0xFF, 0x69, 0x30, 0x00, 0x92, 0x58,
+    0xFE, 0xF9, 0x58, 0x82, 0xC1, 0xA0, 0xBA, 0x6F, 0x88, 0xBA, 0xD3, 0xF0, 0xBA, 0xCB, 0x00, 0x82, 0x65, 0x20, 0xFE, 0xC4, 0x90
+});
+
+// "https://example.com/x", level M, Byte (default mode): version 2, mask 4
+static constexpr auto byteBoard = qrm::encode<"https://example.com/x", qrm::Level::M>();
+static_assert(byteBoard.version == 2 && byteBoard.level == qrm::Level::M && byteBoard.dimension == 25 && byteBoard.maskId == 4);
+static_assert(byteBoard.modules == std::array<UnsignedByte, 100> {
+    0xFE, 0xEB, 0xBF, 0x80, 0x82, 0x00, 0xA0, 0x80, 0xBA, 0x6A, 0xAE, 0x80, 0xBA, 0xD7, 0xAE, 0x80, 0xBA, 0xF3, 0xAE, 0x80,
+    0x82, 0xFC, 0x20, 0x80, 0xFE, 0xAA, 0xBF, 0x80, 0x00, 0xB2, 0x00, 0x00, 0x8B, 0xD3, 0x7C, 0x80, 0x88, 0x53, 0x4D, 0x00,
+    0x2B, 0xB7, 0x76, 0x00, 0x68, 0x9B, 0x53, 0x00, 0x73, 0xE8, 0x77, 0x80, 0x19, 0x21, 0x89, 0x00, 0x2E, 0x21, 0xDE, 0x00,
+    0x19, 0x49, 0x1B, 0x00, 0x0F, 0xF7, 0xFE, 0x00, 0x00, 0xAA, 0x88, 0x00, 0xFE, 0xDE, 0xA8, 0x00, 0x82, 0x34, 0x8E, 0x00,
+    0xBA, 0xEC, 0xFF, 0x80, 0xBA, 0x26, 0x73, 0x80, 0xBA, 0x21, 0xE5, 0x00, 0x82, 0x4A, 0x3F, 0x00, 0xFE, 0xB7, 0x63, 0x80
+});
+static_assert(byteBoard.isSet(0, 0) && !byteBoard.isSet(1, 1) && byteBoard.isSet(3, 3));
+
+// RUN-TIME ENCODER =================================================================================================================================
+
+/// Compare compile-time board with run-time board of the same input
+template <auto& Board>
+static void checkSameAsRunTime(std::string_view text, qrm::Level level, qrm::Mode mode) {
+    auto segment = qrm::Segment::create(mode, text);
+    CHECK(segment.has_value());
+    if (!segment.has_value()) {
+        return;
+    }
+    auto board = qrm::encode(*segment, level);
+    CHECK(board.has_value());
+    if (!board.has_value()) {
+        return;
+    }
+    CHECK(board->dimension() == Board.dimension);
+    CHECK(std::ranges::equal(board->packed(), Board.modules));
+}
+
+#define CHECK_SAME_AS_RUN_TIME(NAME, TEXT, LEVEL, MODE) \
+    static constexpr auto NAME = qrm::encode<TEXT, qrm::Level::LEVEL, qrm::Mode::MODE>(); \
+    checkSameAsRunTime<NAME>(TEXT, qrm::Level::LEVEL, qrm::Mode::MODE)
+
+int main() {
+    checkSameAsRunTime<numericBoard>("1", qrm::Level::L, qrm::Mode::Numeric);
+    checkSameAsRunTime<alphaNumericBoard>("A", qrm::Level::M, qrm::Mode::AlphaNumeric);
+    checkSameAsRunTime<byteBoard>("https://example.com/x", qrm::Level::M, qrm::Mode::Byte);
+
+    CHECK_SAME_AS_RUN_TIME(numericL, "0123456789012345678901234567890123456789", L, Numeric);
+    CHECK_SAME_AS_RUN_TIME(numericM, "0123456789012345678901234567890123456789", M, Numeric);
+    CHECK_SAME_AS_RUN_TIME(numericQ, "0123456789012345678901234567890123456789", Q, Numeric);
+    CHECK_SAME_AS_RUN_TIME(numericH, "12345678901234567", H, Numeric);
+
+    CHECK_SAME_AS_RUN_TIME(alphaNumericL, "HELLO WORLD $%*+-./:", L, AlphaNumeric);
+    CHECK_SAME_AS_RUN_TIME(alphaNumericM, "HELLO WORLD $%*+-./:", M, AlphaNumeric);
+    CHECK_SAME_AS_RUN_TIME(alphaNumericQ, "HELLO WORLD $%*+-./:", Q, AlphaNumeric);
+    CHECK_SAME_AS_RUN_TIME(alphaNumericH, "HTTPS://EXAMPLE.COM/QRM", H, AlphaNumeric);
+
+    CHECK_SAME_AS_RUN_TIME(byteL, "https://example.com/x", L, Byte);
+    CHECK_SAME_AS_RUN_TIME(byteQ, "https://example.com/x", Q, Byte);
+    CHECK_SAME_AS_RUN_TIME(byteH, "https://example.com/x", H, Byte);
+    CHECK_SAME_AS_RUN_TIME(byteUtf8, "Xin chao \xC3\xA0", L, Byte);
+    // Version 7+: version information
+    CHECK_SAME_AS_RUN_TIME(byteLong, "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. "
+                                     "The quick brown fox jumps over the lazy dog!!", M, Byte);
+    return CHECK_RESULT();
+}
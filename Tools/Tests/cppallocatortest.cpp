@@ -0,0 +1,127 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// `qrm::encode` (C++ wrapper) must allocate the same as `QrmEncoderEncode` for the same input
+// (counted by `QrmCountingAllocator`), and encode the same boards.
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "check.h"
+#include "qrmatrix.hpp"
+
+extern "C" {
+#include "Allocator/countingallocator.h"
+}
+
+struct Input {
+    qrm::Mode mode;
+    std::string_view text;
+};
+
+static bool isSameBoard(const QrmBoard& left, const QrmBoard& right) {
+    if (left.dimension != right.dimension) {
+        return false;
+    }
+    for (unsigned int row = 0; row < left.dimension; row += 1) {
+        if (std::memcmp(left.buffer[row], right.buffer[row], left.dimension) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Encode `inputs` (as segments of 1 symbol) by C & C++ APIs, compare allocations & boards.
+/// @return Allocations of C++ API minus allocations of C API
+static long long compare(QrmCountingAllocator counting, const std::vector<Input>& inputs, qrm::Level level) {
+    std::vector<QrmSegment> cSegments;
+    std::vector<qrm::Segment> segments;
+    for (const Input& input : inputs) {
+        cSegments.push_back(QrmSegment {
+            static_cast<QrmEncodingMode>(input.mode), static_cast<unsigned int>(input.text.size()),
+            reinterpret_cast<UnsignedByte*>(const_cast<char*>(input.text.data())), DEFAULT_ECI_ASSIGMENT
+        });
+        auto segment = qrm::Segment::create(input.mode, input.text);
+        CHECK(segment.has_value());
+        segments.push_back(*segment);
+    }
+
+    QrmCountingAllocatorReset(counting);
+    QrmAllocator previous = QrmSetThreadAllocator(counting.allocator);
+    QrmBoard cBoard = QrmEncoderEncode(
+        cSegments.data(), static_cast<unsigned int>(cSegments.size()),
+        static_cast<QrmErrorCorrectionLevel>(level), QrmExtraCreateNone(), 0, 0xFF
+    );
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters cCounters = QrmCountingAllocatorGetCounters(counting);
+
+    QrmCountingAllocatorReset(counting);
+    previous = QrmSetThreadAllocator(counting.allocator);
+    auto board = qrm::encode(segments, level);
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(counting);
+
+    CHECK(cBoard.dimension > 0);
+    CHECK(board.has_value() && isSameBoard(cBoard, board->get()));
+    CHECK(counters.allocationCount > 0);
+    // Temporary allocations are released the same
+    CHECK(counters.allocationCount - counters.releaseCount == cCounters.allocationCount - cCounters.releaseCount);
+
+    // Boards hold the rest
+    QrmCountingAllocatorReset(counting);
+    previous = QrmSetThreadAllocator(counting.allocator);
+    QrmBoardDestroy(&cBoard);
+    board = qrm::Error::InvalidData; // Destroy C++ board
+    QrmSetThreadAllocator(previous);
+    QrmAllocationCounters destroyed = QrmCountingAllocatorGetCounters(counting);
+    CHECK(destroyed.allocationCount == 0);
+    CHECK(destroyed.releaseCount == counters.allocationCount - counters.releaseCount + cCounters.allocationCount - cCounters.releaseCount);
+    CHECK(destroyed.currentBytes == 0);
+    return static_cast<long long>(counters.allocationCount) - static_cast<long long>(cCounters.allocationCount);
+}
+
+int main() {
+    QrmCountingAllocator counting = QrmCountingAllocatorCreate(QrmAllocatorCreateDefault());
+    CHECK(counting.state != nullptr);
+    if (counting.state == nullptr) {
+        return CHECK_RESULT();
+    }
+    const std::vector<Input> single[] = {
+        { { qrm::Mode::Numeric, "01234567890123456789" } },
+        { { qrm::Mode::AlphaNumeric, "HTTPS://EXAMPLE.COM/QRM" } },
+        { { qrm::Mode::Byte, "https://example.com/x" } },
+        { { qrm::Mode::Byte, "QRMatrix C++ wrapper allocations must be the same as allocations of C API." } },
+    };
+    for (const std::vector<Input>& inputs : single) {
+        for (qrm::Level level : { qrm::Level::L, qrm::Level::M, qrm::Level::Q, qrm::Level::H }) {
+            CHECK(compare(counting, inputs, level) == 0);
+        }
+    }
+    // Several segments (copied on stack)
+    std::vector<Input> mixed = { { qrm::Mode::Numeric, "0123456789" }, { qrm::Mode::AlphaNumeric, "ABC" }, { qrm::Mode::Byte, "xyz" } };
+    CHECK(compare(counting, mixed, qrm::Level::M) == 0);
+    // More segments than stack copy: 1 more allocation
+    std::vector<Input> many(20, Input { qrm::Mode::Numeric, "42" });
+    CHECK(compare(counting, many, qrm::Level::L) == 1);
+    QrmCountingAllocatorDestroy(&counting);
+    return CHECK_RESULT();
+}
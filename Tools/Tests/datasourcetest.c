@@ -0,0 +1,68 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// `QrmDataSourceRead` of file descriptors: growing buffer of pipe, read error.
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "check.h"
+#include "qrmatrixsegment.h"
+#include "common.h"
+
+int main(void) {
+    // Pipe bigger than initial buffer
+    static UnsignedByte data[10000];
+    for (unsigned int index = 0; index < sizeof(data); index += 1) {
+        data[index] = (UnsignedByte)(index * 7);
+    }
+    int pipeDescriptors[2];
+    CHECK(pipe(pipeDescriptors) == 0);
+    if (fork() == 0) {
+        close(pipeDescriptors[0]);
+        CHECK(write(pipeDescriptors[1], data, sizeof(data)) == (ssize_t)sizeof(data));
+        _exit(0);
+    }
+    close(pipeDescriptors[1]);
+    unsigned int length = 0;
+    bool isOwned = false;
+    UnsignedByte* result = QrmDataSourceRead(QrmDataSourceCreateFile(pipeDescriptors[0]), &length, &isOwned);
+    close(pipeDescriptors[0]);
+    CHECK(result != NULL && isOwned && length == sizeof(data) && memcmp(result, data, sizeof(data)) == 0);
+    if (result != NULL && isOwned) {
+        DEALLOC(result);
+    }
+
+    // Read error after some bytes (non blocking pipe which is still open: `EAGAIN`) is a failure, not a short read
+    CHECK(pipe(pipeDescriptors) == 0);
+    CHECK(write(pipeDescriptors[1], data, 100) == 100);
+    fcntl(pipeDescriptors[0], F_SETFL, fcntl(pipeDescriptors[0], F_GETFL) | O_NONBLOCK);
+    result = QrmDataSourceRead(QrmDataSourceCreateFile(pipeDescriptors[0]), &length, &isOwned);
+    CHECK(result == NULL && length == 0 && !isOwned);
+    close(pipeDescriptors[0]);
+    close(pipeDescriptors[1]);
+
+    // Memory source is returned as is
+    result = QrmDataSourceRead(QrmDataSourceCreateBuffer(data, 3), &length, &isOwned);
+    CHECK(result == data && length == 3 && !isOwned);
+    return CHECK_RESULT();
+}
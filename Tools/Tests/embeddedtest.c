@@ -0,0 +1,204 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Embedded profile (`QRM_MAX_VERSION`, `QRM_NO_HEAP`, `QRM_NO_KANJI`, `QRM_NO_MICRO`): symbols of `QRM_MAX_VERSION`
+// (most data of each level & mode) must fit `QRM_HEAP_SIZE`; running out of static memory must fail cleanly.
+
+#include "check.h"
+#include "qrmatrixencoder.h"
+#include "ThreadPool/concurrentencoder.h"
+
+#if !QRM_NO_HEAP || !QRM_NO_KANJI || !QRM_NO_MICRO
+#error "Build with QRM_NO_HEAP=1, QRM_NO_KANJI=1 & QRM_NO_MICRO=1"
+#endif
+
+#define MAX_DATA_LENGTH 4096
+
+static UnsignedByte data[MAX_DATA_LENGTH];
+
+/// Fill `data` with `length` characters of `mode`
+static void fillData(QrmEncodingMode mode, unsigned int length) {
+    static const char alphaNumerics[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+    for (unsigned int index = 0; index < length; index += 1) {
+        switch (mode) {
+        case EModeNumeric:
+            data[index] = (UnsignedByte)('0' + index % 10);
+            break;
+        case EModeAlphaNumeric:
+            data[index] = (UnsignedByte)alphaNumerics[index % (sizeof(alphaNumerics) - 1)];
+            break;
+        default:
+            data[index] = (UnsignedByte)(index * 7 + 13);
+            break;
+        }
+    }
+}
+
+/// Most characters of `mode` fitting a symbol of `QRM_MAX_VERSION`
+static unsigned int maxLength(QrmEncodingMode mode, QrmErrorCorrectionLevel level) {
+    unsigned int length = 0;
+    while (length < MAX_DATA_LENGTH) {
+        QrmSegment segment = QrmSegCreate(mode, data, length + 1, DEFAULT_ECI_ASSIGMENT);
+        UnsignedByte version = QrmEncoderGetVersion(&segment, 1, level, QrmExtraCreateNone(), false);
+        QrmSegDestroy(&segment);
+        if (version == 0) {
+            break;
+        }
+        length += 1;
+    }
+    return length;
+}
+
+static QrmBoard encode(QrmEncodingMode mode, unsigned int length, QrmErrorCorrectionLevel level) {
+    QrmSegment segment = QrmSegCreate(mode, data, length, DEFAULT_ECI_ASSIGMENT);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, level, QrmExtraCreateNone(), 0, 0xFF);
+    QrmSegDestroy(&segment);
+    return board;
+}
+
+static void checkMaxVersion(void) {
+    static const QrmEncodingMode modes[] = { EModeNumeric, EModeAlphaNumeric, EModeByte };
+    static const QrmErrorCorrectionLevel levels[] = { ELevelLow, ELevelMedium, ELevelQuarter, ELevelHigh };
+    for (unsigned int modeIndex = 0; modeIndex < sizeof(modes) / sizeof(modes[0]); modeIndex += 1) {
+        fillData(modes[modeIndex], MAX_DATA_LENGTH);
+        for (unsigned int levelIndex = 0; levelIndex < sizeof(levels) / sizeof(levels[0]); levelIndex += 1) {
+            unsigned int length = maxLength(modes[modeIndex], levels[levelIndex]);
+            CHECK(length > 0 && length < MAX_DATA_LENGTH);
+            QrmBoard board = encode(modes[modeIndex], length, levels[levelIndex]);
+            CHECK(board.dimension == 17 + 4 * QRM_MAX_VERSION);
+            QrmBoardDestroy(&board);
+            // 1 more character: data too long
+            board = encode(modes[modeIndex], length + 1, levels[levelIndex]);
+            CHECK(board.dimension == 0);
+            QrmBoardDestroy(&board);
+        }
+    }
+    // Every symbol above was encoded (static memory is big enough), peak shows the margin
+    CHECK(QrmGetHeapPeak() > 0);
+    CHECK(QrmGetHeapPeak() <= QRM_HEAP_SIZE);
+    printf("Heap peak of QRM_MAX_VERSION symbols: %zu of %d bytes\n", QrmGetHeapPeak(), QRM_HEAP_SIZE);
+}
+
+/// Kanji & MicroQR are not compiled
+static void checkDisabledFeatures(void) {
+    static const char kanji[] = "\x93\x5f\xe4\xaa";
+    QrmSegment segment = QrmSegCreate(EModeKanji, (const UnsignedByte*)kanji, sizeof(kanji) - 1, DEFAULT_ECI_ASSIGMENT);
+    CHECK(segment.length == 0);
+    QrmSegDestroy(&segment);
+    segment = QrmSegCreate(EModeNumeric, (const UnsignedByte*)"12345", 5, DEFAULT_ECI_ASSIGMENT);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelLow, QrmExtraCreate(XModeMicroQr), 0, 0xFF);
+    CHECK(board.dimension == 0);
+    QrmBoardDestroy(&board);
+    QrmSegDestroy(&segment);
+}
+
+/// Boards of 16 symbols of `QRM_MAX_VERSION` do not fit static memory: parts fail (empty boards), nothing leaks
+static void checkOutOfMemory(void) {
+    fillData(EModeByte, MAX_DATA_LENGTH);
+    unsigned int length = maxLength(EModeByte, ELevelLow) - 3; // Structured Append header
+    QrmSegment segments[16];
+    QrmStructuredAppend parts[16];
+    for (unsigned int index = 0; index < 16; index += 1) {
+        segments[index] = QrmSegCreate(EModeByte, data, length, DEFAULT_ECI_ASSIGMENT);
+        parts[index] = QrmStrAppCreate(&segments[index], 1, ELevelLow);
+    }
+    unsigned int emptyCount = 0;
+    QrmBoard* boards = QrmEncoderMakeStructuredAppend(parts, 16);
+    for (unsigned int index = 0; index < 16 && boards != NULL; index += 1) {
+        CHECK(boards[index].dimension == 0 || boards[index].dimension == 17 + 4 * QRM_MAX_VERSION);
+        emptyCount += boards[index].dimension == 0 ? 1 : 0;
+        QrmBoardDestroy(&boards[index]);
+    }
+    CHECK(boards == NULL || emptyCount > 0);
+    DEALLOC(boards);
+    // Same with thread pool workers sharing static memory
+    QrmThreadPool pool = QrmThreadPoolCreate(3);
+    boards = QrmEncoderMakeStructuredAppendConcurrently(parts, 16, pool);
+    for (unsigned int index = 0; index < 16 && boards != NULL; index += 1) {
+        CHECK(boards[index].dimension == 0 || boards[index].dimension == 17 + 4 * QRM_MAX_VERSION);
+        QrmBoardDestroy(&boards[index]);
+    }
+    DEALLOC(boards);
+    QrmThreadPoolDestroy(&pool);
+    for (unsigned int index = 0; index < 16; index += 1) {
+        QrmStrAppDestroy(&parts[index]);
+        QrmSegDestroy(&segments[index]);
+    }
+    // All memory is released: biggest symbol still fits
+    QrmBoard board = encode(EModeByte, maxLength(EModeByte, ELevelLow), ELevelLow);
+    CHECK(board.dimension == 17 + 4 * QRM_MAX_VERSION);
+    QrmBoardDestroy(&board);
+}
+
+/// Cells checksum (FNV-1a)
+static unsigned long long boardHash(QrmBoard board) {
+    unsigned long long result = 14695981039346656037ULL;
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        for (unsigned int column = 0; column < board.dimension; column += 1) {
+            result = (result ^ board.buffer[row][column]) * 1099511628211ULL;
+        }
+    }
+    return result;
+}
+
+/// Small symbols encoded concurrently share static memory (each worker needs its own boards: 2 parts only)
+static void checkConcurrent(void) {
+    fillData(EModeByte, MAX_DATA_LENGTH);
+    QrmSegment segments[2];
+    QrmStructuredAppend parts[2];
+    for (unsigned int index = 0; index < 2; index += 1) {
+        segments[index] = QrmSegCreate(EModeByte, data + index, 10, DEFAULT_ECI_ASSIGMENT);
+        parts[index] = QrmStrAppCreate(&segments[index], 1, ELevelMedium);
+    }
+    unsigned long long expected[2] = { 0, 0 };
+    QrmBoard* boards = QrmEncoderMakeStructuredAppend(parts, 2);
+    CHECK(boards != NULL);
+    for (unsigned int index = 0; index < 2 && boards != NULL; index += 1) {
+        CHECK(boards[index].dimension > 0);
+        expected[index] = boardHash(boards[index]);
+        QrmBoardDestroy(&boards[index]);
+    }
+    DEALLOC(boards);
+    QrmThreadPool pool = QrmThreadPoolCreate(2);
+    for (unsigned int round = 0; round < 50; round += 1) {
+        boards = QrmEncoderMakeStructuredAppendConcurrently(parts, 2, pool);
+        CHECK(boards != NULL);
+        for (unsigned int index = 0; index < 2 && boards != NULL; index += 1) {
+            CHECK(boards[index].dimension > 0 && boardHash(boards[index]) == expected[index]);
+            QrmBoardDestroy(&boards[index]);
+        }
+        DEALLOC(boards);
+    }
+    QrmThreadPoolDestroy(&pool);
+    for (unsigned int index = 0; index < 2; index += 1) {
+        QrmStrAppDestroy(&parts[index]);
+        QrmSegDestroy(&segments[index]);
+    }
+}
+
+int main(void) {
+    checkMaxVersion();
+    checkDisabledFeatures();
+    checkOutOfMemory();
+    checkConcurrent();
+    return CHECK_RESULT();
+}
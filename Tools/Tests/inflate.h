@@ -0,0 +1,273 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef INFLATE_H
+#define INFLATE_H
+
+// Minimal zlib decoder of test programs (stored, fixed & dynamic Huffman blocks), to check compressed outputs.
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const unsigned char* input;
+    size_t inputLength;
+    size_t position;
+    unsigned int bits;
+    unsigned int bitCount;
+    unsigned char* output;
+    size_t length;
+    size_t capacity;
+    bool isFailed;
+} Inflater;
+
+typedef struct {
+    /// Number of codes of each length
+    unsigned short counts[16];
+    /// Symbols ordered by code
+    unsigned short symbols[288];
+} InflateHuffman;
+
+static unsigned int inflateBits(Inflater* inflater, unsigned int count) {
+    while (inflater->bitCount < count) {
+        if (inflater->position >= inflater->inputLength) {
+            inflater->isFailed = true;
+            return 0;
+        }
+        inflater->bits |= (unsigned int)inflater->input[inflater->position] << inflater->bitCount;
+        inflater->position += 1;
+        inflater->bitCount += 8;
+    }
+    unsigned int result = inflater->bits & ((1u << count) - 1);
+    inflater->bits >>= count;
+    inflater->bitCount -= count;
+    return result;
+}
+
+static void inflatePut(Inflater* inflater, unsigned char byte) {
+    if (inflater->length == inflater->capacity) {
+        inflater->capacity = inflater->capacity > 0 ? inflater->capacity * 2 : 4096;
+        inflater->output = realloc(inflater->output, inflater->capacity);
+    }
+    inflater->output[inflater->length] = byte;
+    inflater->length += 1;
+}
+
+static void inflateBuild(InflateHuffman* huffman, const unsigned char* lengths, unsigned int count) {
+    unsigned short offsets[16];
+    memset(huffman->counts, 0, sizeof(huffman->counts));
+    for (unsigned int index = 0; index < count; index += 1) {
+        huffman->counts[lengths[index]] += 1;
+    }
+    huffman->counts[0] = 0;
+    offsets[1] = 0;
+    for (unsigned int length = 1; length < 15; length += 1) {
+        offsets[length + 1] = offsets[length] + huffman->counts[length];
+    }
+    for (unsigned int index = 0; index < count; index += 1) {
+        if (lengths[index] != 0) {
+            huffman->symbols[offsets[lengths[index]]] = (unsigned short)index;
+            offsets[lengths[index]] += 1;
+        }
+    }
+}
+
+static int inflateDecode(Inflater* inflater, const InflateHuffman* huffman) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (unsigned int length = 1; length < 16; length += 1) {
+        code |= (int)inflateBits(inflater, 1);
+        int count = huffman->counts[length];
+        if (code - count < first) {
+            return huffman->symbols[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    inflater->isFailed = true;
+    return -1;
+}
+
+static void inflateCodes(Inflater* inflater, const InflateHuffman* lengthCodes, const InflateHuffman* distanceCodes) {
+    static const unsigned short lengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const unsigned char lengthExtra[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const unsigned short distanceBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const unsigned char distanceExtra[] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    while (!inflater->isFailed) {
+        int symbol = inflateDecode(inflater, lengthCodes);
+        if (symbol < 0 || symbol == 256) {
+            return;
+        }
+        if (symbol < 256) {
+            inflatePut(inflater, (unsigned char)symbol);
+            continue;
+        }
+        symbol -= 257;
+        if (symbol >= 29) {
+            inflater->isFailed = true;
+            return;
+        }
+        unsigned int length = lengthBase[symbol] + inflateBits(inflater, lengthExtra[symbol]);
+        int distanceSymbol = inflateDecode(inflater, distanceCodes);
+        if (distanceSymbol < 0 || distanceSymbol >= 30) {
+            inflater->isFailed = true;
+            return;
+        }
+        size_t distance = distanceBase[distanceSymbol] + inflateBits(inflater, distanceExtra[distanceSymbol]);
+        if (distance > inflater->length) {
+            inflater->isFailed = true;
+            return;
+        }
+        for (unsigned int index = 0; index < length; index += 1) {
+            inflatePut(inflater, inflater->output[inflater->length - distance]);
+        }
+    }
+}
+
+static void inflateDynamic(Inflater* inflater, InflateHuffman* lengthCodes, InflateHuffman* distanceCodes) {
+    static const unsigned char order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    unsigned char lengths[320];
+    unsigned int lengthCount = inflateBits(inflater, 5) + 257;
+    unsigned int distanceCount = inflateBits(inflater, 5) + 1;
+    unsigned int codeCount = inflateBits(inflater, 4) + 4;
+    memset(lengths, 0, sizeof(lengths));
+    for (unsigned int index = 0; index < codeCount; index += 1) {
+        lengths[order[index]] = (unsigned char)inflateBits(inflater, 3);
+    }
+    InflateHuffman codeLengths;
+    inflateBuild(&codeLengths, lengths, 19);
+    unsigned int index = 0;
+    while (index < lengthCount + distanceCount && !inflater->isFailed) {
+        int symbol = inflateDecode(inflater, &codeLengths);
+        if (symbol < 16) {
+            lengths[index] = (unsigned char)symbol;
+            index += 1;
+            continue;
+        }
+        unsigned char value = 0;
+        unsigned int repeat;
+        if (symbol == 16) {
+            if (index == 0) {
+                inflater->isFailed = true;
+                return;
+            }
+            value = lengths[index - 1];
+            repeat = 3 + inflateBits(inflater, 2);
+        } else if (symbol == 17) {
+            repeat = 3 + inflateBits(inflater, 3);
+        } else {
+            repeat = 11 + inflateBits(inflater, 7);
+        }
+        if (index + repeat > lengthCount + distanceCount) {
+            inflater->isFailed = true;
+            return;
+        }
+        memset(lengths + index, value, repeat);
+        index += repeat;
+    }
+    inflateBuild(lengthCodes, lengths, lengthCount);
+    inflateBuild(distanceCodes, lengths + lengthCount, distanceCount);
+}
+
+/// Decode zlib stream (header, blocks & Adler-32 are checked).
+/// @return Decoded bytes (must be freed) or NULL if invalid.
+static unsigned char* inflateZlib(const unsigned char* input, size_t inputLength, size_t* length) {
+    Inflater inflater;
+    memset(&inflater, 0, sizeof(inflater));
+    inflater.input = input;
+    inflater.inputLength = inputLength;
+    *length = 0;
+    if (inputLength < 6 || (input[0] & 0x0F) != 8 || ((input[0] << 8) | input[1]) % 31 != 0) {
+        return NULL;
+    }
+    inflater.position = 2;
+    bool isLast = false;
+    while (!isLast && !inflater.isFailed) {
+        isLast = inflateBits(&inflater, 1) != 0;
+        unsigned int type = inflateBits(&inflater, 2);
+        if (type == 0) {
+            inflater.bits = 0;
+            inflater.bitCount = 0;
+            if (inflater.position + 4 > inputLength) {
+                inflater.isFailed = true;
+                break;
+            }
+            unsigned int blockLength = input[inflater.position] | (input[inflater.position + 1] << 8);
+            inflater.position += 4;
+            if (inflater.position + blockLength > inputLength) {
+                inflater.isFailed = true;
+                break;
+            }
+            for (unsigned int index = 0; index < blockLength; index += 1) {
+                inflatePut(&inflater, input[inflater.position + index]);
+            }
+            inflater.position += blockLength;
+        } else if (type == 1) {
+            unsigned char lengths[288 + 30];
+            memset(lengths, 8, 144);
+            memset(lengths + 144, 9, 112);
+            memset(lengths + 256, 7, 24);
+            memset(lengths + 280, 8, 8);
+            memset(lengths + 288, 5, 30);
+            InflateHuffman lengthCodes;
+            InflateHuffman distanceCodes;
+            inflateBuild(&lengthCodes, lengths, 288);
+            inflateBuild(&distanceCodes, lengths + 288, 30);
+            inflateCodes(&inflater, &lengthCodes, &distanceCodes);
+        } else if (type == 2) {
+            InflateHuffman lengthCodes;
+            InflateHuffman distanceCodes;
+            inflateDynamic(&inflater, &lengthCodes, &distanceCodes);
+            inflateCodes(&inflater, &lengthCodes, &distanceCodes);
+        } else {
+            inflater.isFailed = true;
+        }
+    }
+    // Adler-32 after byte alignment
+    if (!inflater.isFailed && inflater.position + 4 <= inputLength) {
+        unsigned long a = 1;
+        unsigned long b = 0;
+        for (size_t index = 0; index < inflater.length; index += 1) {
+            a = (a + inflater.output[index]) % 65521;
+            b = (b + a) % 65521;
+        }
+        const unsigned char* adler = input + inflater.position;
+        unsigned long expected = ((unsigned long)adler[0] << 24) | ((unsigned long)adler[1] << 16) | ((unsigned long)adler[2] << 8) | adler[3];
+        inflater.isFailed = ((b << 16) | a) != expected;
+    } else {
+        inflater.isFailed = true;
+    }
+    if (inflater.isFailed) {
+        free(inflater.output);
+        return NULL;
+    }
+    *length = inflater.length;
+    if (inflater.output == NULL) {
+        inflater.output = malloc(1);
+    }
+    return inflater.output;
+}
+
+#endif // INFLATE_H
@@ -0,0 +1,251 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Decode ZPL `^GFA` & ESC/POS `GS v 0` outputs back to 1 bit dot planes and compare with boards.
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "qrmatrixencoder.h"
+#include "Archive/boardarchive.h"
+#include "Render/zplwriter.h"
+#include "Render/escposwriter.h"
+
+/// 1 bit per dot plane, rows of `rowLength` bytes, most significant bit first
+typedef struct {
+    UnsignedByte* dots;
+    unsigned int rowLength;
+    unsigned int height;
+} Plane;
+
+/// Module plane of board (layout of `QrmBoardView`)
+static QrmBoardView makeView(QrmBoard board, UnsignedByte* modules) {
+    QrmBoardView result = QrmBoardViewCreateEmpty();
+    result.dimension = board.dimension;
+    result.rowStride = (board.dimension + 7) / 8;
+    memset(modules, 0, result.rowStride * board.dimension);
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        for (unsigned int column = 0; column < board.dimension; column += 1) {
+            if ((board.buffer[row][column] & CellLowMask) == CellSet) {
+                modules[row * result.rowStride + column / 8] |= 0x80 >> (column % 8);
+            }
+        }
+    }
+    result.modules = modules;
+    return result;
+}
+
+/// Compare decoded plane with view scaled by `scale` with `quietZone` modules around
+static bool isSamePlane(Plane plane, QrmBoardView view, unsigned int scale, unsigned int quietZone) {
+    unsigned int width = (view.dimension + 2 * quietZone) * scale;
+    if (plane.dots == NULL || plane.height != width || plane.rowLength != (width + 7) / 8) {
+        return false;
+    }
+    for (unsigned int y = 0; y < plane.height; y += 1) {
+        for (unsigned int x = 0; x < plane.rowLength * 8; x += 1) {
+            bool expected = false;
+            unsigned int row = y / scale;
+            unsigned int column = x / scale;
+            if (x < width && row >= quietZone && row < view.dimension + quietZone && column >= quietZone && column < view.dimension + quietZone) {
+                expected = QrmBoardViewIsSet(view, (UnsignedByte)(row - quietZone), (UnsignedByte)(column - quietZone));
+            }
+            bool actual = (plane.dots[y * plane.rowLength + x / 8] & (0x80 >> (x % 8))) != 0;
+            if (expected != actual) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static unsigned int readNumber(const char** text) {
+    unsigned int result = 0;
+    while (**text >= '0' && **text <= '9') {
+        result = result * 10 + (unsigned int)(**text - '0');
+        *text += 1;
+    }
+    return result;
+}
+
+static int hexValue(char digit) {
+    if (digit >= '0' && digit <= '9') {
+        return digit - '0';
+    }
+    if (digit >= 'A' && digit <= 'F') {
+        return digit - 'A' + 10;
+    }
+    return -1;
+}
+
+/// Expand `^GFA,total,total,rowLength,data` (with ZPL ASCII compression)
+static Plane decodeZpl(const char* text, size_t length) {
+    Plane result = { NULL, 0, 0 };
+    const char* end = text + length;
+    const char* cursor = strstr(text, "^GFA,");
+    if (cursor == NULL) {
+        return result;
+    }
+    cursor += 5;
+    unsigned int total = readNumber(&cursor);
+    if (*cursor++ != ',' || readNumber(&cursor) != total || *cursor++ != ',') {
+        return result;
+    }
+    unsigned int rowLength = readNumber(&cursor);
+    if (*cursor++ != ',' || rowLength == 0 || total % rowLength != 0) {
+        return result;
+    }
+    unsigned int digitCount = rowLength * 2;
+    UnsignedByte* dots = calloc(total, 1);
+    unsigned int row = 0;
+    unsigned int digit = 0;
+    unsigned int count = 0;
+    for (; cursor < end && *cursor != '^'; cursor += 1) {
+        char character = *cursor;
+        if (character >= 'G' && character <= 'Y') {
+            count += (unsigned int)(character - 'F');
+            continue;
+        }
+        if (character >= 'g' && character <= 'z') {
+            count += (unsigned int)(character - 'f') * 20;
+            continue;
+        }
+        if (row * rowLength >= total) {
+            break;
+        }
+        int value = 0;
+        unsigned int repeat = count > 0 ? count : 1;
+        count = 0;
+        if (character == ':') {
+            if (digit != 0 || row == 0) {
+                break;
+            }
+            memcpy(dots + row * rowLength, dots + (row - 1) * rowLength, rowLength);
+            row += 1;
+            continue;
+        } else if (character == ',' || character == '!') {
+            value = character == ',' ? 0x0 : 0xF;
+            repeat = digitCount - digit;
+        } else {
+            value = hexValue(character);
+            if (value < 0 || digit + repeat > digitCount) {
+                break;
+            }
+        }
+        for (; repeat > 0; repeat -= 1, digit += 1) {
+            dots[row * rowLength + digit / 2] |= (UnsignedByte)(digit % 2 == 0 ? value << 4 : value);
+        }
+        if (digit == digitCount) {
+            digit = 0;
+            row += 1;
+        }
+    }
+    if (row * rowLength != total || digit != 0 || strncmp(cursor, "^FS", 3) != 0) {
+        free(dots);
+        return result;
+    }
+    result.dots = dots;
+    result.rowLength = rowLength;
+    result.height = total / rowLength;
+    return result;
+}
+
+/// Concatenate `GS v 0` blocks
+static Plane decodeEscPos(const UnsignedByte* data, size_t length, unsigned int maxBlockHeight) {
+    Plane result = { NULL, 0, 0 };
+    size_t offset = 0;
+    UnsignedByte* dots = NULL;
+    while (offset + 8 <= length) {
+        const UnsignedByte* header = data + offset;
+        if (header[0] != 0x1D || header[1] != 'v' || header[2] != '0' || header[3] != 0) {
+            break;
+        }
+        unsigned int rowLength = header[4] | (header[5] << 8);
+        unsigned int rows = header[6] | (header[7] << 8);
+        if ((result.rowLength != 0 && rowLength != result.rowLength) || rows == 0 || (maxBlockHeight > 0 && rows > maxBlockHeight) ||
+            offset + 8 + (size_t)rowLength * rows > length) {
+            break;
+        }
+        dots = realloc(dots, (size_t)rowLength * (result.height + rows));
+        memcpy(dots + (size_t)rowLength * result.height, header + 8, (size_t)rowLength * rows);
+        result.rowLength = rowLength;
+        result.height += rows;
+        offset += 8 + (size_t)rowLength * rows;
+    }
+    if (offset != length) {
+        free(dots);
+        result.dots = NULL;
+        return result;
+    }
+    result.dots = dots;
+    return result;
+}
+
+static void checkBoard(QrmBoard board) {
+    static const unsigned int scales[] = { 1, 3, 8 };
+    static const unsigned int quietZones[] = { 0, 2, 4 };
+    static const unsigned int blockHeights[] = { 0, 7, 100 };
+    UnsignedByte modules[(QR_MAX_VERSION * QR_VERSION_OFFSET + QR_MIN_DIMENSION + 7) / 8 * (QR_MAX_VERSION * QR_VERSION_OFFSET + QR_MIN_DIMENSION)];
+    QrmBoardView view = makeView(board, modules);
+    for (unsigned int index = 0; index < 3; index += 1) {
+        unsigned int scale = scales[index];
+        unsigned int quietZone = quietZones[index];
+        QrmOutput output = QrmOutputCreateBuffer(0);
+        CHECK(QrmZplWrite(&output, board, scale, quietZone, 10, 20));
+        CHECK(output.length > 0 && memcmp(output.buffer, "^XA^FO10,20^GFA,", 16) == 0);
+        Plane plane = decodeZpl((const char*)output.buffer, output.length);
+        CHECK(isSamePlane(plane, view, scale, quietZone));
+        free(plane.dots);
+        for (unsigned int jndex = 0; jndex < 3; jndex += 1) {
+            QrmOutputReset(&output);
+            CHECK(QrmEscPosWrite(&output, board, scale, quietZone, blockHeights[jndex]));
+            plane = decodeEscPos(output.buffer, output.length, blockHeights[jndex]);
+            CHECK(isSamePlane(plane, view, scale, quietZone));
+            free(plane.dots);
+        }
+        QrmOutputDestroy(&output);
+    }
+}
+
+int main(void) {
+    static const char text[] = "https://example.com/QRMatrix/printer/test?id=0123456789&name=ZPL+ESC/POS";
+    for (unsigned int version = 1; version <= QR_MAX_VERSION; version += 13) {
+        QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, sizeof(text) - 1, DEFAULT_ECI_ASSIGMENT);
+        QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelMedium, QrmExtraCreateNone(), (UnsignedByte)version, 0xFF);
+        CHECK(board.dimension > 0);
+        if (board.dimension > 0) {
+            checkBoard(board);
+        }
+        QrmBoardDestroy(&board);
+        QrmSegDestroy(&segment);
+    }
+#if !QRM_NO_MICRO
+    QrmSegment segment = QrmSegCreate(EModeNumeric, (const UnsignedByte*)"0123", 4, DEFAULT_ECI_ASSIGMENT);
+    QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelLow, QrmExtraCreate(XModeMicroQr), 0, 0xFF);
+    CHECK(board.dimension > 0);
+    if (board.dimension > 0) {
+        checkBoard(board);
+    }
+    QrmBoardDestroy(&board);
+    QrmSegDestroy(&segment);
+#endif
+    return CHECK_RESULT();
+}
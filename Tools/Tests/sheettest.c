@@ -0,0 +1,295 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// Banded sheet rendering (several band heights, with & without thread pool, board array & provider)
+// compared with per-symbol placement; PBM & PNG outputs decoded back.
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "inflate.h"
+#include "qrmatrixencoder.h"
+#include "Allocator/countingallocator.h"
+#include "Render/sheet.h"
+#include "Render/pixel.h"
+
+/// Whole page (reference & rendered rows)
+typedef struct {
+    UnsignedByte* pixels;
+    unsigned int rowLength;
+    unsigned int rowCount;
+    unsigned int height;
+} Page;
+
+static Page pageCreate(QrmSheetLayout layout) {
+    Page result;
+    result.rowLength = QrmPixelRowLength(Pixel1Bit, layout.width);
+    result.height = layout.height;
+    result.rowCount = 0;
+    result.pixels = calloc((size_t)result.rowLength * layout.height, 1);
+    return result;
+}
+
+static bool pageAddRow(void* context, const UnsignedByte* row) {
+    Page* page = context;
+    if (page->rowCount >= page->height) {
+        return false;
+    }
+    memcpy(page->pixels + (size_t)page->rowCount * page->rowLength, row, page->rowLength);
+    page->rowCount += 1;
+    return true;
+}
+
+/// Place each symbol pixel by pixel: centered in cell, clipped to cell & page
+static Page referencePage(QrmSheetLayout layout, const QrmBoard* boards, unsigned int count) {
+    Page result = pageCreate(layout);
+    result.rowCount = layout.height;
+    for (unsigned int index = 0; index < count && index < layout.columns * layout.rows; index += 1) {
+        QrmBoard board = boards[index];
+        unsigned int size = board.dimension * layout.scale;
+        unsigned int cellLeft = layout.marginLeft + (index % layout.columns) * layout.cellWidth;
+        unsigned int cellTop = layout.marginTop + (index / layout.columns) * layout.cellHeight;
+        unsigned int left = cellLeft + (size < layout.cellWidth ? (layout.cellWidth - size) / 2 : 0);
+        unsigned int top = cellTop + (size < layout.cellHeight ? (layout.cellHeight - size) / 2 : 0);
+        for (unsigned int y = 0; y < size; y += 1) {
+            for (unsigned int x = 0; x < size; x += 1) {
+                unsigned int pageX = left + x;
+                unsigned int pageY = top + y;
+                if (pageX >= cellLeft + layout.cellWidth || pageX >= layout.width ||
+                    pageY >= cellTop + layout.cellHeight || pageY >= layout.height) {
+                    continue;
+                }
+                if ((board.buffer[y / layout.scale][x / layout.scale] & CellLowMask) == CellSet) {
+                    result.pixels[(size_t)pageY * result.rowLength + pageX / 8] |= (UnsignedByte)(0x80 >> (pageX % 8));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+static bool isSamePage(Page left, Page right) {
+    return left.rowCount == right.rowCount && left.rowLength == right.rowLength &&
+        memcmp(left.pixels, right.pixels, (size_t)left.rowLength * left.rowCount) == 0;
+}
+
+/// Provider of boards from an array (boards are duplicated: sheet destroys them)
+typedef struct {
+    const QrmBoard* boards;
+    unsigned int nextIndex;
+    bool isInOrder;
+} Provider;
+
+static QrmBoard provideBoard(void* context, unsigned int index) {
+    Provider* provider = context;
+    if (index != provider->nextIndex) {
+        provider->isInOrder = false;
+    }
+    provider->nextIndex = index + 1;
+    return QrmBoardDuplicate(provider->boards[index]);
+}
+
+/// Decode PNG (1 bit grayscale, 1 = white) into page (1 = black)
+static bool decodePng(const UnsignedByte* data, size_t length, Page* page) {
+    static const UnsignedByte signature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    if (length < 8 || memcmp(data, signature, 8) != 0) {
+        return false;
+    }
+    UnsignedByte* compressed = NULL;
+    size_t compressedLength = 0;
+    size_t position = 8;
+    while (position + 12 <= length) {
+        size_t chunkLength = ((size_t)data[position] << 24) | (data[position + 1] << 16) | (data[position + 2] << 8) | data[position + 3];
+        const UnsignedByte* type = data + position + 4;
+        if (memcmp(type, "IDAT", 4) == 0) {
+            compressed = realloc(compressed, compressedLength + chunkLength);
+            memcpy(compressed + compressedLength, type + 4, chunkLength);
+            compressedLength += chunkLength;
+        }
+        position += chunkLength + 12;
+    }
+    size_t rawLength = 0;
+    UnsignedByte* raw = inflateZlib(compressed, compressedLength, &rawLength);
+    free(compressed);
+    if (raw == NULL || rawLength != (size_t)(page->rowLength + 1) * page->height) {
+        free(raw);
+        return false;
+    }
+    for (unsigned int row = 0; row < page->height; row += 1) {
+        UnsignedByte* line = raw + (size_t)row * (page->rowLength + 1);
+        UnsignedByte* previous = row > 0 ? line - (page->rowLength + 1) : NULL;
+        for (unsigned int index = 1; index <= page->rowLength; index += 1) {
+            UnsignedByte left = index > 1 ? line[index - 1] : 0;
+            UnsignedByte up = previous != NULL ? previous[index] : 0;
+            UnsignedByte upLeft = previous != NULL && index > 1 ? previous[index - 1] : 0;
+            switch (line[0]) {
+            case 1: line[index] += left; break;
+            case 2: line[index] += up; break;
+            case 3: line[index] += (UnsignedByte)((left + up) / 2); break;
+            case 4: {
+                int estimate = left + up - upLeft;
+                int distanceLeft = abs(estimate - left);
+                int distanceUp = abs(estimate - up);
+                int distanceUpLeft = abs(estimate - upLeft);
+                line[index] += distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft ? left : (distanceUp <= distanceUpLeft ? up : upLeft);
+                break;
+            }
+            default: break;
+            }
+        }
+    }
+    for (unsigned int row = 0; row < page->height; row += 1) {
+        const UnsignedByte* line = raw + (size_t)row * (page->rowLength + 1) + 1;
+        for (unsigned int index = 0; index < page->rowLength; index += 1) {
+            page->pixels[(size_t)row * page->rowLength + index] = (UnsignedByte)~line[index];
+        }
+    }
+    page->rowCount = page->height;
+    free(raw);
+    return true;
+}
+
+/// Clear bits after `width` pixels of each row (PNG padding bits are not pixels)
+static void clearPadding(Page* page, unsigned int width) {
+    if (width % 8 == 0) {
+        return;
+    }
+    UnsignedByte mask = (UnsignedByte)(0xFF << (8 - width % 8));
+    for (unsigned int row = 0; row < page->rowCount; row += 1) {
+        page->pixels[(size_t)row * page->rowLength + page->rowLength - 1] &= mask;
+    }
+}
+
+/// Pool without worker: bands are rendered on calling thread
+static QrmThreadPool emptyPool(void) {
+    QrmThreadPool result;
+    result.threadCount = 0;
+    result.state = NULL;
+    return result;
+}
+
+static void testLayout(QrmSheetLayout layout, const QrmBoard* boards, unsigned int count, QrmThreadPool pool) {
+    Page expected = referencePage(layout, boards, count);
+    static const unsigned int bandHeights[] = { 1, 7, 64, 100000 };
+    for (unsigned int bandIndex = 0; bandIndex < sizeof(bandHeights) / sizeof(bandHeights[0]); bandIndex += 1) {
+        for (unsigned int isPooled = 0; isPooled < 2; isPooled += 1) {
+            QrmThreadPool usedPool = isPooled ? pool : emptyPool();
+            Page page = pageCreate(layout);
+            CHECK(QrmSheetRender(layout, (QrmBoard*)boards, count, bandHeights[bandIndex], usedPool, pageAddRow, &page));
+            CHECK(isSamePage(expected, page));
+            free(page.pixels);
+
+            Provider provider = { boards, 0, true };
+            page = pageCreate(layout);
+            CHECK(QrmSheetRenderStream(layout, provideBoard, &provider, count, bandHeights[bandIndex], usedPool, pageAddRow, &page));
+            CHECK(isSamePage(expected, page));
+            CHECK(provider.isInOrder);
+            CHECK(provider.nextIndex == (count < layout.columns * layout.rows ? count : layout.columns * layout.rows) || count == 0 ||
+                  layout.marginTop + layout.rows * layout.cellHeight > layout.height);
+            free(page.pixels);
+        }
+    }
+
+    // PBM: header + rows
+    QrmOutput output = QrmOutputCreateBuffer(0);
+    CHECK(QrmSheetWritePbm(&output, layout, (QrmBoard*)boards, count, pool));
+    char header[64];
+    int headerLength = snprintf(header, sizeof(header), "P4\n%u %u\n", layout.width, layout.height);
+    CHECK(output.length == (size_t)headerLength + (size_t)expected.rowLength * layout.height);
+    CHECK(output.length >= (size_t)headerLength && memcmp(output.buffer, header, (size_t)headerLength) == 0 &&
+          memcmp(output.buffer + headerLength, expected.pixels, output.length - (size_t)headerLength) == 0);
+    QrmOutputDestroy(&output);
+
+    // PNG (array & stream)
+    for (unsigned int isStream = 0; isStream < 2; isStream += 1) {
+        output = QrmOutputCreateBuffer(0);
+        Provider provider = { boards, 0, true };
+        CHECK(isStream ? QrmSheetWritePngStream(&output, layout, provideBoard, &provider, count, pool) :
+                         QrmSheetWritePng(&output, layout, (QrmBoard*)boards, count, pool));
+        Page page = pageCreate(layout);
+        CHECK(decodePng(output.buffer, output.length, &page));
+        clearPadding(&page, layout.width);
+        CHECK(isSamePage(expected, page));
+        free(page.pixels);
+        QrmOutputDestroy(&output);
+    }
+    free(expected.pixels);
+}
+
+int main(void) {
+    enum { BOARD_COUNT = 23 };
+    QrmBoard boards[BOARD_COUNT];
+    for (unsigned int index = 0; index < BOARD_COUNT; index += 1) {
+        char text[32];
+        int length = snprintf(text, sizeof(text), "Sheet cell %u", index);
+        QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, (unsigned int)length, DEFAULT_ECI_ASSIGMENT);
+        // Different sizes; some empty cells
+        boards[index] = index % 7 == 5 ? QrmBoardCreateEmpty() :
+            QrmEncoderEncode(&segment, 1, ELevelMedium, QrmExtraCreateNone(), (UnsignedByte)(1 + index % 4), 0xFF);
+        QrmSegDestroy(&segment);
+    }
+    QrmThreadPool pool = QrmThreadPoolCreate(3);
+
+    // Symbols smaller than cells, odd sizes & margin
+    testLayout(QrmSheetLayoutCreate(653, 907, 11, 4, 6, 3), boards, BOARD_COUNT, pool);
+    // Symbols bigger than cells (clipped), more cells than boards
+    testLayout(QrmSheetLayoutCreate(301, 250, 5, 5, 5, 4), boards, BOARD_COUNT, pool);
+    // Grid taller than page (clipped rows)
+    QrmSheetLayout clipped = QrmSheetLayoutCreate(400, 700, 0, 3, 4, 2);
+    clipped.height = 333;
+    testLayout(clipped, boards, BOARD_COUNT, pool);
+    // Single cell, no board
+    testLayout(QrmSheetLayoutCreate(64, 64, 0, 1, 1, 1), boards, 0, pool);
+
+    // Provider keeps only boards of rows intersecting bands: peak memory below all boards
+    QrmSheetLayout tall = QrmSheetLayoutCreate(400, 4000, 0, 4, 40, 2);
+    QrmBoard many[160];
+    for (unsigned int index = 0; index < 160; index += 1) {
+        many[index] = boards[index % 4];
+    }
+    QrmCountingAllocator counting = QrmCountingAllocatorCreate(QrmAllocatorCreateDefault());
+    {
+        Provider provider = { many, 0, true };
+        Page page = pageCreate(tall);
+        QrmAllocator previous = QrmSetThreadAllocator(counting.allocator);
+        CHECK(QrmSheetRenderStream(tall, provideBoard, &provider, 160, 64, emptyPool(), pageAddRow, &page));
+        QrmSetThreadAllocator(previous);
+        QrmAllocationCounters counters = QrmCountingAllocatorGetCounters(counting);
+        size_t allBoards = 0;
+        for (unsigned int index = 0; index < 160; index += 1) {
+            allBoards += (size_t)many[index].dimension * many[index].dimension;
+        }
+        CHECK(counters.currentBytes == 0);
+        CHECK(counters.peakBytes < allBoards / 4);
+        Page expected = referencePage(tall, many, 160);
+        CHECK(isSamePage(expected, page));
+        free(expected.pixels);
+        free(page.pixels);
+    }
+    QrmCountingAllocatorDestroy(&counting);
+
+    QrmThreadPoolDestroy(&pool);
+    for (unsigned int index = 0; index < BOARD_COUNT; index += 1) {
+        QrmBoardDestroy(&boards[index]);
+    }
+    return CHECK_RESULT();
+}
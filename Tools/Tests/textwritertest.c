@@ -0,0 +1,74 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// `TextDebug` output of text writer must be the same as `QrmBoardPrintDescription(board, true)`.
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "check.h"
+#include "qrmatrixencoder.h"
+#include "Render/textwriter.h"
+
+/// Output of `QrmBoardPrintDescription` (stdout redirected to temporary file)
+static char* printDescription(QrmBoard board, size_t* length) {
+    FILE* file = tmpfile();
+    if (file == NULL) {
+        return NULL;
+    }
+    fflush(stdout);
+    int original = dup(STDOUT_FILENO);
+    dup2(fileno(file), STDOUT_FILENO);
+    QrmBoardPrintDescription(board, true);
+    fflush(stdout);
+    dup2(original, STDOUT_FILENO);
+    close(original);
+    *length = (size_t)ftell(file);
+    char* result = malloc(*length + 1);
+    rewind(file);
+    *length = fread(result, 1, *length, file);
+    fclose(file);
+    return result;
+}
+
+int main(void) {
+    static const char text[] = "QRMatrix text writer";
+    static const UnsignedByte versions[] = { 1, 20, 21, 40 };
+    for (unsigned int index = 0; index < sizeof(versions); index += 1) {
+        if (versions[index] > QR_MAX_VERSION) {
+            continue;
+        }
+        QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, sizeof(text) - 1, DEFAULT_ECI_ASSIGMENT);
+        QrmBoard board = QrmEncoderEncode(&segment, 1, ELevelQuarter, QrmExtraCreateNone(), versions[index], 0xFF);
+        CHECK(board.dimension > 0);
+        QrmOutput output = QrmOutputCreateBuffer(0);
+        CHECK(QrmTextWrite(&output, board, 0, TextDebug, false));
+        size_t length = 0;
+        char* expected = printDescription(board, &length);
+        CHECK(expected != NULL && length == output.length && memcmp(expected, output.buffer, length) == 0);
+        free(expected);
+        QrmOutputDestroy(&output);
+        QrmBoardDestroy(&board);
+        QrmSegDestroy(&segment);
+    }
+    return CHECK_RESULT();
+}
@@ -0,0 +1,288 @@
+/*
+    QRMatrix - QR pixels presentation.
+    Copyright © 2023 duongpq/soleilpqd.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the “Software”), to deal in
+    the Software without restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+    Software, and to permit persons to whom the Software is furnished to do so, subject
+    to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+    PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+    FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+    OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+// PDF & EPS outputs parsed back: cross reference offsets, Flate content stream, rectangles of each board
+// compared with its dark modules (multi-board page).
+
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "inflate.h"
+#include "qrmatrixencoder.h"
+#include "Render/pdfwriter.h"
+#include "Render/epswriter.h"
+
+/// Modules covered by rectangles
+typedef struct {
+    unsigned int dimension;
+    UnsignedByte* cells;
+    bool isOutside;
+} Coverage;
+
+static Coverage coverageCreate(unsigned int dimension) {
+    Coverage result = { dimension, calloc((size_t)dimension * dimension, 1), false };
+    return result;
+}
+
+static void coverageAdd(Coverage* coverage, unsigned long x, unsigned long y, unsigned long width, unsigned long height) {
+    if (width == 0 || height == 0 || x + width > coverage->dimension || y + height > coverage->dimension) {
+        coverage->isOutside = true;
+        return;
+    }
+    for (unsigned long row = y; row < y + height; row += 1) {
+        memset(coverage->cells + row * coverage->dimension + x, 1, width);
+    }
+}
+
+static bool coverageIsBoard(Coverage coverage, QrmBoard board) {
+    if (coverage.isOutside || coverage.dimension != board.dimension) {
+        return false;
+    }
+    for (unsigned int row = 0; row < board.dimension; row += 1) {
+        for (unsigned int column = 0; column < board.dimension; column += 1) {
+            bool isDark = (board.buffer[row][column] & CellLowMask) == CellSet;
+            if (isDark != (coverage.cells[row * board.dimension + column] != 0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool isNear(double left, double right) {
+    return left - right < 0.001 && right - left < 0.001;
+}
+
+static const char* findText(const char* text, size_t length, const char* pattern) {
+    size_t patternLength = strlen(pattern);
+    for (size_t index = 0; index + patternLength <= length; index += 1) {
+        if (memcmp(text + index, pattern, patternLength) == 0) {
+            return text + index;
+        }
+    }
+    return NULL;
+}
+
+/// Placement of a board on page
+typedef struct {
+    QrmBoard board;
+    double x;
+    double y;
+    double moduleSize;
+} Placement;
+
+/// Parse content stream: `q m 0 0 -m x y cm` then `x y w h re` lines then `f Q`, once per board
+static void checkPdfContent(const char* content, size_t length, const Placement* placements, unsigned int count, double pageHeight) {
+    char* text = malloc(length + 1);
+    memcpy(text, content, length);
+    text[length] = 0;
+    char* position = text;
+    CHECK(strncmp(position, "0 g\n", 4) == 0);
+    position += 4;
+    for (unsigned int index = 0; index < count; index += 1) {
+        double scaleX, zero1, zero2, scaleY, x, y;
+        int consumed = 0;
+        int matched = sscanf(position, "q %lf %lf %lf %lf %lf %lf cm\n%n", &scaleX, &zero1, &zero2, &scaleY, &x, &y, &consumed);
+        CHECK(matched == 6 && consumed > 0);
+        if (matched != 6 || consumed == 0) {
+            break;
+        }
+        Placement placement = placements[index];
+        CHECK(isNear(scaleX, placement.moduleSize) && zero1 == 0 && zero2 == 0 && isNear(scaleY, -placement.moduleSize));
+        CHECK(isNear(x, placement.x) && isNear(y, pageHeight - placement.y));
+        position += consumed;
+        Coverage coverage = coverageCreate(placement.board.dimension);
+        unsigned long rectX, rectY, rectWidth, rectHeight;
+        while (sscanf(position, "%lu %lu %lu %lu re\n%n", &rectX, &rectY, &rectWidth, &rectHeight, &consumed) == 4) {
+            coverageAdd(&coverage, rectX, rectY, rectWidth, rectHeight);
+            position += consumed;
+        }
+        CHECK(coverageIsBoard(coverage, placement.board));
+        free(coverage.cells);
+        CHECK(strncmp(position, "f Q\n", 4) == 0);
+        position += 4;
+    }
+    CHECK(*position == 0);
+    free(text);
+}
+
+static void checkPdf(QrmOutput output, const Placement* placements, unsigned int count, double pageWidth, double pageHeight) {
+    const char* text = (const char*)output.buffer;
+    size_t length = output.length;
+    CHECK(length > 16 && memcmp(text, "%PDF-1.4\n", 9) == 0);
+    // startxref -> xref table -> objects
+    const char* startXref = findText(text, length, "startxref\n");
+    CHECK(startXref != NULL);
+    if (startXref == NULL) {
+        return;
+    }
+    size_t xrefOffset = strtoul(startXref + 10, NULL, 10);
+    CHECK(xrefOffset < length && strncmp(text + xrefOffset, "xref\n0 ", 7) == 0);
+    unsigned int objectCount = (unsigned int)strtoul(text + xrefOffset + 7, NULL, 10);
+    CHECK(objectCount == 5);
+    const char* entries = strchr(text + xrefOffset + 7, '\n') + 1;
+    CHECK(strncmp(entries, "0000000000 65535 f \n", 20) == 0);
+    for (unsigned int object = 1; object < objectCount; object += 1) {
+        const char* entry = entries + 20 * object;
+        CHECK(strncmp(entry + 10, " 00000 n \n", 10) == 0);
+        size_t offset = strtoul(entry, NULL, 10);
+        char expected[32];
+        int expectedLength = snprintf(expected, sizeof(expected), "%u 0 obj\n", object);
+        CHECK(offset + (size_t)expectedLength <= length && memcmp(text + offset, expected, (size_t)expectedLength) == 0);
+    }
+    CHECK(findText(text, length, "trailer\n<</Size 5/Root 1 0 R>>") != NULL);
+
+    // Page size
+    const char* mediaBox = findText(text, length, "/MediaBox[0 0 ");
+    CHECK(mediaBox != NULL);
+    if (mediaBox != NULL) {
+        char* end;
+        double width = strtod(mediaBox + 14, &end);
+        double height = strtod(end, NULL);
+        CHECK(isNear(width, pageWidth) && isNear(height, pageHeight));
+    }
+
+    // Content stream
+    const char* object = findText(text, length, "4 0 obj\n<</Length ");
+    CHECK(object != NULL);
+    if (object == NULL) {
+        return;
+    }
+    char* end;
+    size_t streamLength = strtoul(object + 18, &end, 10);
+    CHECK(strncmp(end, "/Filter/FlateDecode>>\nstream\n", 29) == 0);
+    const char* stream = end + 29;
+    CHECK(stream + streamLength + 10 <= text + length && strncmp(stream + streamLength, "\nendstream\n", 11) == 0);
+    size_t contentLength = 0;
+    UnsignedByte* content = inflateZlib((const UnsignedByte*)stream, streamLength, &contentLength);
+    CHECK(content != NULL);
+    if (content != NULL) {
+        checkPdfContent((const char*)content, contentLength, placements, count, pageHeight);
+        free(content);
+    }
+}
+
+static void checkEps(QrmOutput output, QrmBoard board, double moduleSize, unsigned int quietZone) {
+    char* text = malloc(output.length + 1);
+    memcpy(text, output.buffer, output.length);
+    text[output.length] = 0;
+    double size = (board.dimension + 2 * quietZone) * moduleSize;
+    unsigned long box = 0;
+    double hiResWidth = 0;
+    double hiResHeight = 0;
+    CHECK(strncmp(text, "%!PS-Adobe-3.0 EPSF-3.0\n", 24) == 0);
+    const char* boundingBox = strstr(text, "%%BoundingBox: 0 0 ");
+    CHECK(boundingBox != NULL && sscanf(boundingBox, "%%%%BoundingBox: 0 0 %lu", &box) == 1);
+    CHECK(box >= size && box < size + 1);
+    const char* hiRes = strstr(text, "%%HiResBoundingBox: 0 0 ");
+    CHECK(hiRes != NULL && sscanf(hiRes, "%%%%HiResBoundingBox: 0 0 %lf %lf", &hiResWidth, &hiResHeight) == 2);
+    CHECK(isNear(hiResWidth, size) && isNear(hiResHeight, size));
+    const char* position = strstr(text, "0 setgray\n");
+    CHECK(position != NULL);
+    if (position == NULL) {
+        free(text);
+        return;
+    }
+    position += 10;
+    double x, y, scaleX, scaleY;
+    int consumed = 0;
+    CHECK(sscanf(position, "%lf %lf translate %lf %lf scale\n%n", &x, &y, &scaleX, &scaleY, &consumed) == 4 && consumed > 0);
+    CHECK(isNear(x, quietZone * moduleSize) && isNear(y, size - quietZone * moduleSize));
+    CHECK(isNear(scaleX, moduleSize) && isNear(scaleY, -moduleSize));
+    position += consumed;
+    Coverage coverage = coverageCreate(board.dimension);
+    unsigned long rectX, rectY, rectWidth, rectHeight;
+    while (sscanf(position, "%lu %lu %lu %lu r\n%n", &rectX, &rectY, &rectWidth, &rectHeight, &consumed) == 4) {
+        coverageAdd(&coverage, rectX, rectY, rectWidth, rectHeight);
+        position += consumed;
+    }
+    CHECK(coverageIsBoard(coverage, board));
+    CHECK(strcmp(position, "grestore\nshowpage\n%%EOF\n") == 0);
+    free(coverage.cells);
+    free(text);
+}
+
+static QrmBoard encode(const char* text, UnsignedByte minVersion, bool isMicro) {
+    QrmSegment segment = QrmSegCreate(EModeByte, (const UnsignedByte*)text, (unsigned int)strlen(text), DEFAULT_ECI_ASSIGMENT);
+    QrmBoard result = QrmEncoderEncode(&segment, 1, ELevelLow, isMicro ? QrmExtraCreate(XModeMicroQr) : QrmExtraCreateNone(), minVersion, 0xFF);
+    QrmSegDestroy(&segment);
+    return result;
+}
+
+int main(void) {
+    QrmBoard boards[4];
+    boards[0] = encode("PDF board 1", 0, false);
+    boards[1] = encode("PDF board 2", 7, false);
+    boards[2] = encode("micro", 0, true);
+    boards[3] = encode("PDF board 4", QR_MAX_VERSION, false);
+    for (unsigned int index = 0; index < 4; index += 1) {
+        CHECK(boards[index].dimension > 0);
+    }
+
+    // Multi-board page
+    Placement placements[4] = {
+        { boards[0], 36, 36, 2 },
+        { boards[1], 120.5, 40.25, 1.5 },
+        { boards[2], 36, 300, 3.125 },
+        { boards[3], 200, 250, 0.75 },
+    };
+    QrmOutput output = QrmOutputCreateBuffer(0);
+    QrmPdfWriter writer = QrmPdfWriterCreate(&output, 595.276, 841.89);
+    CHECK(writer.output != NULL);
+    for (unsigned int index = 0; index < 4; index += 1) {
+        CHECK(QrmPdfWriterAddBoard(&writer, placements[index].board, placements[index].x, placements[index].y, placements[index].moduleSize));
+    }
+    CHECK(QrmPdfWriterFinish(&writer));
+    QrmPdfWriterDestroy(&writer);
+    checkPdf(output, placements, 4, 595.276, 841.89);
+
+    // Output which already holds data is rejected (offsets would be wrong)
+    writer = QrmPdfWriterCreate(&output, 100, 100);
+    CHECK(writer.output == NULL);
+    CHECK(!QrmPdfWriterAddBoard(&writer, boards[0], 0, 0, 1));
+    CHECK(!QrmPdfWriterFinish(&writer));
+    QrmPdfWriterDestroy(&writer);
+    CHECK(!QrmPdfWrite(&output, boards[0], 1, 4));
+    QrmOutputDestroy(&output);
+
+    // Single board documents
+    for (unsigned int index = 0; index < 4; index += 1) {
+        unsigned int quietZone = index == 2 ? 2 : 4;
+        double moduleSize = 1.25 + index;
+        output = QrmOutputCreateBuffer(0);
+        CHECK(QrmPdfWrite(&output, boards[index], moduleSize, quietZone));
+        double size = (boards[index].dimension + 2 * quietZone) * moduleSize;
+        Placement placement = { boards[index], quietZone * moduleSize, quietZone * moduleSize, moduleSize };
+        checkPdf(output, &placement, 1, size, size);
+        QrmOutputDestroy(&output);
+
+        output = QrmOutputCreateBuffer(0);
+        CHECK(QrmEpsWrite(&output, boards[index], moduleSize, quietZone));
+        checkEps(output, boards[index], moduleSize, quietZone);
+        QrmOutputDestroy(&output);
+    }
+
+    for (unsigned int index = 0; index < 4; index += 1) {
+        QrmBoardDestroy(&boards[index]);
+    }
+    return CHECK_RESULT();
+}